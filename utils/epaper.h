@@ -0,0 +1,206 @@
+#ifndef EPAPER_H
+#define EPAPER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <inttypes.h>
+
+/*
+ * simulated e-paper panel, fed with the dirty rectangle of each frame
+ *
+ * partial refreshes only drive the damaged area with a fast waveform but
+ * accumulate ghosting, full refreshes drive the whole panel with a slow
+ * flashing waveform and clear all ghosting
+ */
+
+typedef enum _epaper_policy_t {
+	EPAPER_POLICY_FULL = 0,  // always full refresh
+	EPAPER_POLICY_PARTIAL,   // partial, full refresh every max_partials
+	EPAPER_POLICY_AREA       // like partial, full refresh for large areas, too
+} epaper_policy_t;
+
+typedef enum _epaper_refresh_t {
+	EPAPER_REFRESH_NONE = 0,
+	EPAPER_REFRESH_PARTIAL,
+	EPAPER_REFRESH_FULL
+} epaper_refresh_t;
+
+typedef struct _epaper_t epaper_t;
+
+struct _epaper_t {
+	epaper_policy_t policy;
+	uint32_t width;
+	uint32_t height;
+
+	// panel characteristics
+	uint32_t full_us; // waveform duration of full refresh
+	uint32_t partial_us; // waveform duration of partial refresh
+	uint32_t pixel_ns; // transfer time per pixel
+	uint32_t max_partials; // partials until ghosting needs a full refresh
+	uint32_t area_permille; // partial area which triggers a full refresh
+
+	// session accounting
+	uint32_t partials; // partials since last full refresh
+	uint64_t num_full;
+	uint64_t num_partial;
+	uint64_t num_skipped;
+	uint64_t full_time_us;
+	uint64_t partial_time_us;
+	uint64_t pixels;
+};
+
+static inline int
+epaper_policy_from_string(const char *str, epaper_policy_t *policy)
+{
+	if(!strcasecmp(str, "full"))
+	{
+		*policy = EPAPER_POLICY_FULL;
+	}
+	else if(!strcasecmp(str, "partial"))
+	{
+		*policy = EPAPER_POLICY_PARTIAL;
+	}
+	else if(!strcasecmp(str, "area"))
+	{
+		*policy = EPAPER_POLICY_AREA;
+	}
+	else
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+static void
+epaper_init(epaper_t *ep, epaper_policy_t policy, uint32_t width,
+	uint32_t height)
+{
+	memset(ep, 0x0, sizeof(epaper_t));
+
+	ep->policy = policy;
+	ep->width = width;
+	ep->height = height;
+
+	// typical 6" 800x600 panel with GC16/DU waveforms over SPI
+	ep->full_us = 450000;
+	ep->partial_us = 260000;
+	ep->pixel_ns = 40;
+	ep->max_partials = 6;
+	ep->area_permille = 500;
+}
+
+static epaper_refresh_t
+_epaper_policy(epaper_t *ep, uint64_t area)
+{
+	switch(ep->policy)
+	{
+		case EPAPER_POLICY_FULL:
+		{
+			return EPAPER_REFRESH_FULL;
+		}
+		case EPAPER_POLICY_AREA:
+		{
+			const uint64_t full = (uint64_t)ep->width * ep->height;
+
+			if(area * 1000 >= full * ep->area_permille)
+			{
+				return EPAPER_REFRESH_FULL;
+			}
+		} // fall-through
+		case EPAPER_POLICY_PARTIAL:
+		{
+			if(ep->partials >= ep->max_partials) // ghosting
+			{
+				return EPAPER_REFRESH_FULL;
+			}
+		} break;
+	}
+
+	return EPAPER_REFRESH_PARTIAL;
+}
+
+// returns simulated panel time in microseconds
+static uint64_t
+epaper_update(epaper_t *ep, bool dirty, int32_t x, int32_t y, int32_t w,
+	int32_t h, epaper_refresh_t *refresh)
+{
+	epaper_refresh_t ref = EPAPER_REFRESH_NONE;
+	uint64_t dt = 0;
+
+	// clip to panel
+	if(x < 0)
+	{
+		w += x;
+		x = 0;
+	}
+	if(y < 0)
+	{
+		h += y;
+		y = 0;
+	}
+	if(x + w > (int32_t)ep->width)
+	{
+		w = ep->width - x;
+	}
+	if(y + h > (int32_t)ep->height)
+	{
+		h = ep->height - y;
+	}
+
+	if(!dirty || (w <= 0) || (h <= 0) )
+	{
+		ep->num_skipped++;
+	}
+	else
+	{
+		uint64_t area = (uint64_t)w * h;
+
+		ref = _epaper_policy(ep, area);
+
+		if(ref == EPAPER_REFRESH_FULL)
+		{
+			area = (uint64_t)ep->width * ep->height;
+			dt = ep->full_us + area * ep->pixel_ns / 1000;
+
+			ep->partials = 0;
+			ep->num_full++;
+			ep->full_time_us += dt;
+		}
+		else
+		{
+			dt = ep->partial_us + area * ep->pixel_ns / 1000;
+
+			ep->partials++;
+			ep->num_partial++;
+			ep->partial_time_us += dt;
+		}
+
+		ep->pixels += area;
+	}
+
+	if(refresh)
+	{
+		*refresh = ref;
+	}
+
+	return dt;
+}
+
+static void
+epaper_report(const epaper_t *ep, FILE *fout)
+{
+	const uint64_t total_us = ep->full_time_us + ep->partial_time_us;
+
+	fprintf(fout,
+		"panel    %"PRIu64" full (%.3f s), %"PRIu64" partial (%.3f s), "
+		"%"PRIu64" skipped, %.1f Mpx driven, total %.3f s\n",
+		ep->num_full, ep->full_time_us / 1e6,
+		ep->num_partial, ep->partial_time_us / 1e6,
+		ep->num_skipped, ep->pixels / 1e6, total_us / 1e6);
+}
+
+#endif
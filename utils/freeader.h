@@ -2,6 +2,8 @@
 #define FREEADER_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -10,9 +12,17 @@
 #define FREEADER_TITLE_LEN 128
 #define FREEADER_AUTHOR_LEN 128
 
+typedef enum _rotation_t {
+	ROTATION_0 = 0,
+	ROTATION_90,  // clockwise
+	ROTATION_180,
+	ROTATION_270  // clockwise
+} rotation_t;
+
 typedef struct _head_t head_t;
 typedef struct _encoder_t encoder_t;
 typedef struct _decoder_t decoder_t;
+typedef struct _rotator_t rotator_t;
 
 struct _head_t {
 	char magic [FREEADER_MAGIC_LEN];
@@ -32,6 +42,19 @@ struct _decoder {
 	FILE *fin;
 };
 
+// packed 1-bpp (MSB first) rotator, consumes lines and fills a rotated page
+struct _rotator_t {
+	rotation_t rotation;
+	uint32_t width; // source dimensions
+	uint32_t height;
+	uint32_t src_stride;
+	uint32_t dst_width; // destination dimensions
+	uint32_t dst_height;
+	uint32_t dst_stride;
+	uint8_t *dst;
+	uint8_t *band; // 8 source lines for 90/270
+};
+
 static int
 freeader_encoder_init(encoder_t *enc, const char *path, uint32_t page_number)
 {
@@ -75,4 +98,243 @@ freeader_encoder_deinit(encoder_t *enc, head_t *head)
 	return 0;
 }
 
+static inline rotation_t
+freeader_rotation_from_degrees(int degrees)
+{
+	switch( ( (degrees % 360) + 360) % 360)
+	{
+		case 90:
+			return ROTATION_90;
+		case 180:
+			return ROTATION_180;
+		case 270:
+			return ROTATION_270;
+	}
+
+	return ROTATION_0;
+}
+
+static inline uint8_t
+_freeader_reverse8(uint8_t b)
+{
+	b = ( (b & 0xf0) >> 4) | ( (b & 0x0f) << 4);
+	b = ( (b & 0xcc) >> 2) | ( (b & 0x33) << 2);
+	b = ( (b & 0xaa) >> 1) | ( (b & 0x55) << 1);
+
+	return b;
+}
+
+/*
+ * transpose 8x8 bit matrix in a single 64-bit word, row 0 in MSB
+ * (Hacker's Delight, 7-3)
+ */
+static inline uint64_t
+_freeader_transpose8(uint64_t x)
+{
+	uint64_t t;
+
+	t = (x ^ (x >> 7)) & UINT64_C(0x00aa00aa00aa00aa);
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & UINT64_C(0x0000cccc0000cccc);
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & UINT64_C(0x00000000f0f0f0f0);
+	x = x ^ t ^ (t << 28);
+
+	return x;
+}
+
+static inline bool
+_freeader_get_bit(const uint8_t *buf, uint32_t stride, uint32_t x, uint32_t y)
+{
+	return buf[y*stride + (x >> 3)] & (0x80 >> (x & 7));
+}
+
+static inline void
+_freeader_set_bit(uint8_t *buf, uint32_t stride, uint32_t x, uint32_t y,
+	bool val)
+{
+	uint8_t *dst = &buf[y*stride + (x >> 3)];
+	const uint8_t mask = 0x80 >> (x & 7);
+
+	if(val)
+	{
+		*dst |= mask;
+	}
+	else
+	{
+		*dst &= ~mask;
+	}
+}
+
+static int
+freeader_rotator_init(rotator_t *rot, rotation_t rotation, uint32_t width,
+	uint32_t height)
+{
+	memset(rot, 0x0, sizeof(rotator_t));
+
+	rot->rotation = rotation;
+	rot->width = width;
+	rot->height = height;
+	rot->src_stride = (width >> 3) + !!(width & 7);
+
+	if( (rotation == ROTATION_90) || (rotation == ROTATION_270) )
+	{
+		rot->dst_width = height;
+		rot->dst_height = width;
+
+		rot->band = calloc(8, rot->src_stride);
+		if(!rot->band)
+		{
+			return -1;
+		}
+	}
+	else
+	{
+		rot->dst_width = width;
+		rot->dst_height = height;
+	}
+
+	rot->dst_stride = (rot->dst_width >> 3) + !!(rot->dst_width & 7);
+	rot->dst = calloc(rot->dst_height, rot->dst_stride);
+	if(!rot->dst)
+	{
+		free(rot->band);
+		return -1;
+	}
+
+	return 0;
+}
+
+static void
+freeader_rotator_deinit(rotator_t *rot)
+{
+	free(rot->band);
+	free(rot->dst);
+}
+
+// slow path for bands not aligned to 8x8 blocks
+static void
+_freeader_rotator_band_slow(rotator_t *rot, uint32_t y0, uint32_t rows)
+{
+	for(uint32_t r = 0; r < rows; r++)
+	{
+		const uint32_t y = y0 + r;
+
+		for(uint32_t x = 0; x < rot->width; x++)
+		{
+			const bool val = _freeader_get_bit(rot->band, rot->src_stride, x, r);
+
+			if(rot->rotation == ROTATION_90)
+			{
+				_freeader_set_bit(rot->dst, rot->dst_stride, rot->height - 1 - y, x, val);
+			}
+			else
+			{
+				_freeader_set_bit(rot->dst, rot->dst_stride, y, rot->width - 1 - x, val);
+			}
+		}
+	}
+}
+
+static void
+_freeader_rotator_band(rotator_t *rot, uint32_t y0, uint32_t rows)
+{
+	if( (rows != 8) || (rot->width & 7) || (rot->height & 7) )
+	{
+		_freeader_rotator_band_slow(rot, y0, rows);
+		return;
+	}
+
+	const bool cw = rot->rotation == ROTATION_90;
+	const uint32_t col = cw
+		? (rot->height - 8 - y0) >> 3
+		: y0 >> 3;
+
+	for(uint32_t k = 0; k < rot->src_stride; k++)
+	{
+		uint64_t x = 0;
+
+		// clockwise: bottom source row ends up in the leftmost column
+		for(uint32_t r = 0; r < 8; r++)
+		{
+			const uint32_t row = cw ? 7 - r : r;
+
+			x = (x << 8) | rot->band[row*rot->src_stride + k];
+		}
+
+		if(!x) // blank block, destination is zero-initialized per page
+		{
+			continue;
+		}
+
+		x = _freeader_transpose8(x);
+
+		for(uint32_t c = 0; c < 8; c++)
+		{
+			const uint32_t dst_y = cw
+				? (k << 3) + c
+				: rot->width - 1 - (k << 3) - c;
+
+			rot->dst[dst_y*rot->dst_stride + col] = x >> (56 - (c << 3));
+		}
+	}
+}
+
+/*
+ * feed a single decoded/source line, lines must arrive in order
+ * returns true when the rotated page is complete
+ */
+static bool
+freeader_rotator_line(rotator_t *rot, const uint8_t *line, uint32_t y)
+{
+	if(y == 0)
+	{
+		memset(rot->dst, 0x0, rot->dst_height * rot->dst_stride);
+	}
+
+	switch(rot->rotation)
+	{
+		case ROTATION_0:
+		{
+			memcpy(&rot->dst[y*rot->dst_stride], line, rot->src_stride);
+		} break;
+		case ROTATION_180:
+		{
+			uint8_t *dst = &rot->dst[(rot->height - 1 - y)*rot->dst_stride];
+			const uint32_t pad = (rot->src_stride << 3) - rot->width;
+
+			if(!pad)
+			{
+				for(uint32_t k = 0; k < rot->src_stride; k++)
+				{
+					dst[rot->src_stride - 1 - k] = _freeader_reverse8(line[k]);
+				}
+			}
+			else
+			{
+				for(uint32_t x = 0; x < rot->width; x++)
+				{
+					_freeader_set_bit(dst, 0, rot->width - 1 - x, 0,
+						_freeader_get_bit(line, 0, x, 0));
+				}
+			}
+		} break;
+		case ROTATION_90:
+			// fall-through
+		case ROTATION_270:
+		{
+			const uint32_t r = y & 7;
+
+			memcpy(&rot->band[r*rot->src_stride], line, rot->src_stride);
+
+			if( (r == 7) || (y == rot->height - 1) )
+			{
+				_freeader_rotator_band(rot, y - r, r + 1);
+			}
+		} break;
+	}
+
+	return y == rot->height - 1;
+}
+
 #endif
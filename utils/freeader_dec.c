@@ -27,6 +27,7 @@ struct _app_t {
 	size_t cnt;
 
 	head_t *head;
+	rotator_t rot;
 };
 
 static int
@@ -35,12 +36,26 @@ _out(const struct jbg85_dec_state *state __attribute__((unused)),
 {
 	app_t *app = data;
 
-	if(fwrite(start, len, 1, app->fout) != 1)
+	if(app->rot.rotation != ROTATION_0)
+	{
+		const uint32_t y0 = y % app->head->page_height;
+
+		if(freeader_rotator_line(&app->rot, start, y0))
+		{
+			const size_t sz = app->rot.dst_height * app->rot.dst_stride;
+
+			if(fwrite(app->rot.dst, sz, 1, app->fout) != 1)
+			{
+				fprintf(stderr, "fwrite\n");
+			}
+		}
+	}
+	else if(fwrite(start, len, 1, app->fout) != 1)
 	{
 		fprintf(stderr, "fwrite\n");
 	}
 
-	if(y == 600 - 1) //FIXME
+	if(y == app->head->page_height - 1)
 	{
 		return 1;
 	}
@@ -162,6 +177,12 @@ main(int argc, char **argv)
 		page = atoi(argv[3]);
 	}
 
+	int degrees = 0;
+	if(argc >= 5)
+	{
+		degrees = atoi(argv[4]);
+	}
+
 	head_t head;
 	fread(&head, 1, sizeof(head_t), app.fin);
 	if(strncmp(head.magic, FREEADER_MAGIC, FREEADER_MAGIC_LEN))
@@ -179,7 +200,14 @@ main(int argc, char **argv)
 		head.page_height,
 		head.page_numbe)
 #endif
-	fprintf(app.fout, "P4\n%10"PRIu32"\n%10"PRIu32"\n", head.page_width, head.page_height);
+	if(freeader_rotator_init(&app.rot, freeader_rotation_from_degrees(degrees),
+		head.page_width, head.page_height) != 0)
+	{
+		return -1;
+	}
+
+	fprintf(app.fout, "P4\n%10"PRIu32"\n%10"PRIu32"\n",
+		app.rot.dst_width, app.rot.dst_height);
 
 	const uint32_t page_number = head.page_number;
 
@@ -218,6 +246,8 @@ main(int argc, char **argv)
 		free(app.outbuf);
 	}
 
+	freeader_rotator_deinit(&app.rot);
+
 	if(app.fin)
 	{
 		fclose(app.fin);
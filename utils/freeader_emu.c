@@ -3,11 +3,20 @@
 #include <string.h>
 #include <math.h>
 #include <limits.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <ctype.h>
+#include <time.h>
 
 #include <freeader.h>
+#include <epaper.h>
 #include <jbig85.h>
 
 #include <d2tk/frontend_pugl.h>
+#include <d2tk/trace.h>
+#if defined(FREEADER_HEADLESS)
+#	include <d2tk/frontend_offscreen.h>
+#endif
 
 #define WIDTH 800
 #define HEIGHT 600
@@ -15,11 +24,23 @@
 #define FOOTER 24
 #define BUFSZ (WIDTH * HEIGHT / 8)
 
+typedef enum _batch_t {
+	BATCH_NONE = 0,
+	BATCH_SEQUENTIAL,
+	BATCH_RANDOM,
+	BATCH_PINGPONG
+} batch_t;
+
 typedef struct _app_t app_t;
 
 struct _app_t {
 	d2tk_pugl_config_t config;
 	d2tk_pugl_t *dpugl;
+#if defined(FREEADER_HEADLESS)
+	d2tk_offscreen_config_t offscreen_config;
+	d2tk_offscreen_t *doffscreen;
+#endif
+	d2tk_base_t *base;
 
 	uint32_t argb [800*600];
 
@@ -38,7 +59,21 @@ struct _app_t {
 	size_t cnt;
 
 	head_t *head;
+	rotator_t rot;
 	bool dirty;
+
+	bool decoding;
+	uint32_t band_lines;
+	uint32_t nbands;
+	uint64_t rev;
+	uint64_t *band_rev;
+
+	bool timed;
+	uint64_t convert_ns;
+	uint64_t decode_ns;
+
+	bool panel;
+	epaper_t epaper;
 };
 
 #if 0
@@ -53,38 +88,94 @@ static const uint8_t bitmask [8] = {
 	0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01
 };
 
+static inline uint64_t
+_now_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec*UINT64_C(1000000000) + ts.tv_nsec;
+}
+
+// rows of argb are width pixels apart, width needs not be a multiple of 8
+static void
+_expand(uint32_t *argb, const uint8_t *src, uint32_t width, uint32_t height,
+	uint32_t stride)
+{
+	for(uint32_t j = 0; j < height; j++)
+	{
+		const uint8_t *line = &src[j*stride];
+		uint32_t *dst = &argb[j*width];
+
+		for(uint32_t i = 0; i < width; i++)
+		{
+			dst[i] = line[i >> 3] & bitmask[i & 7]
+				? fg
+				: bg;
+		}
+	}
+}
+
 static int
 _out(const struct jbg85_dec_state *state __attribute__((unused)),
 	uint8_t *start, size_t len, unsigned long y, void *data)
 {
 	app_t *app = data;
 
-	const int y0 = y % app->head->page_height;
-	int offset = y0 * app->head->page_width;
+	const uint32_t y0 = y % app->head->page_height;
+	const bool last = y0 == app->head->page_height - 1;
+	const uint64_t t0 = app->timed ? _now_ns() : 0;
+	int intr = 0;
+
+	if(app->rot.rotation != ROTATION_0)
+	{
+		// rotated pages are only complete after the last line
+		if(freeader_rotator_line(&app->rot, start, y0))
+		{
+			_expand(app->argb, app->rot.dst, app->rot.dst_width, app->rot.dst_height,
+				app->rot.dst_stride);
+
+			app->rev++;
+			for(uint32_t b = 0; b < app->nbands; b++)
+			{
+				app->band_rev[b] = app->rev;
+			}
 
-	for(size_t i=0; i<len; i++)
+			intr = 1;
+		}
+	}
+	else
 	{
-		const uint8_t raw = start[i];
+		_expand(&app->argb[y0 * app->head->page_width], start,
+			app->head->page_width, 1, len);
 
-		for(int j=0; j<8; j++, offset++)
+		// interrupt decoder at the end of each band
+		if( ( (y0 + 1) % app->band_lines == 0) || last)
 		{
-			app->argb[offset] = raw & bitmask[j]
-				? fg
-				: bg;
+			app->band_rev[y0 / app->band_lines] = ++app->rev;
+
+			intr = 1;
 		}
 	}
 
-	if(y == 600 - 1) //FIXME
+	if(app->timed)
 	{
-		return 1;
+		app->convert_ns += _now_ns() - t0;
 	}
 
-	return 0;
+	if(last)
+	{
+		app->decoding = false;
+	}
+
+	return intr;
 }
 
 static void
 _page_set(app_t *app, unsigned page)
 {
+	const uint64_t t0 = d2tk_trace_begin();
+
 	if(page > app->head->page_number - 1)
 	{
 		page = app->head->page_number - 1;
@@ -94,6 +185,7 @@ _page_set(app_t *app, unsigned page)
 
 	app->len = 0;
 	app->cnt = 0;
+	app->decoding = true;
 	jbg85_dec_init(&app->state, app->outbuf, app->outbuflen, _out, app);
 	fseek(app->fin, app->head->page_offset[app->page], SEEK_SET);
 
@@ -114,10 +206,25 @@ _page_set(app_t *app, unsigned page)
 			fseek(app->fin, len, SEEK_CUR);
 		}
 	}
+
+	d2tk_trace_end("freeader", "_page_set", t0);
 }
 
 static void
-_next(app_t *app)
+_redisplay(app_t *app)
+{
+	if(app->dpugl)
+	{
+		d2tk_pugl_redisplay(app->dpugl);
+	}
+	else
+	{
+		app->dirty = true;
+	}
+}
+
+static bool
+_decode(app_t *app)
 {
 	// process remaining bytes from input buffer
 	while(app->cnt != app->len)
@@ -130,9 +237,9 @@ _next(app_t *app)
 
 		if(result == JBG_EOK_INTR)
 		{
-			d2tk_pugl_redisplay(app->dpugl);
+			_redisplay(app);
 
-			return;
+			return true;
 		}
 
     if(result != JBG_EAGAIN)
@@ -155,9 +262,9 @@ _next(app_t *app)
 
 			if(result == JBG_EOK_INTR)
 			{
-				d2tk_pugl_redisplay(app->dpugl);
+				_redisplay(app);
 
-				return;
+				return true;
 			}
 
 			if(result != JBG_EAGAIN)
@@ -167,22 +274,88 @@ _next(app_t *app)
 		}
   }
 
-	return;
+	return false;
+}
+
+static void
+_next(app_t *app)
+{
+	const uint64_t t0 = d2tk_trace_begin();
+	const uint64_t t1 = app->timed ? _now_ns() : 0;
+
+	if(!_decode(app))
+	{
+		app->decoding = false; // premature end of data
+	}
+
+	if(app->timed)
+	{
+		app->decode_ns += _now_ns() - t1;
+	}
+
+	d2tk_trace_end("freeader", "_next", t0);
+}
+
+static void
+_panel_update(app_t *app)
+{
+	if(!app->panel)
+	{
+		return;
+	}
+
+	// dirty area of the previous frame
+	d2tk_rect_t rect;
+	const bool dirty = d2tk_base_get_dirty_rect(app->base, &rect);
+
+	epaper_update(&app->epaper, dirty, rect.x, rect.y, rect.w, rect.h, NULL);
 }
 
 static void
 _expose_page(app_t *app, const d2tk_rect_t *rect)
 {
-	d2tk_base_t *base = d2tk_pugl_get_base(app->dpugl);
+	d2tk_base_t *base = app->base;
+
+	const uint32_t w = app->rot.dst_width;
+	const uint32_t h = app->rot.dst_height;
+	const uint32_t stride = w * sizeof(uint32_t);
+
+	// fit page into rect, like the backends do for a single bitmap
+	float scale = 1.f;
+	if( (d2tk_coord_t)h != rect->h)
+	{
+		scale = (float)rect->h / h;
+	}
+	if(w * scale > rect->w)
+	{
+		scale = (float)rect->w / w;
+	}
+
+	const d2tk_coord_t fw = w * scale;
+	const d2tk_coord_t fh = h * scale;
+	const d2tk_coord_t fx = rect->x + (rect->w - fw) / 2;
+	const d2tk_coord_t fy = rect->y + (rect->h - fh) / 2;
 
-	d2tk_base_bitmap(base, WIDTH, HEIGHT, STRIDE, app->argb, app->page, rect,
-		D2TK_ALIGN_CENTERED);
+	// each band is a separate bitmap, so only freshly decoded bands are dirty
+	for(uint32_t b = 0; b < app->nbands; b++)
+	{
+		const uint32_t y0 = b * app->band_lines;
+		const uint32_t y1 = (y0 + app->band_lines < h)
+			? y0 + app->band_lines
+			: h;
+		const d2tk_coord_t by0 = fy + (d2tk_coord_t)y0 * fh / (d2tk_coord_t)h;
+		const d2tk_coord_t by1 = fy + (d2tk_coord_t)y1 * fh / (d2tk_coord_t)h;
+		const d2tk_rect_t brect = D2TK_RECT(fx, by0, fw, by1 - by0);
+
+		d2tk_base_bitmap(base, w, y1 - y0, stride, &app->argb[y0 * w],
+			app->band_rev[b], &brect, D2TK_ALIGN_CENTERED);
+	}
 }
 
 static void
 _expose_footer(app_t *app, const d2tk_rect_t *rect)
 {
-	d2tk_base_t *base = d2tk_pugl_get_base(app->dpugl);
+	d2tk_base_t *base = app->base;
 
 	const int32_t old_page = app->page + 1;
 	int32_t new_page = old_page;
@@ -197,7 +370,7 @@ _expose_footer(app_t *app, const d2tk_rect_t *rect)
 		{
 			case 0:
 			{
-				if(d2tk_base_button_label_is_changed(base, D2TK_ID, -1, "Home",
+				if(d2tk_base_button_label_is_changed(base, D2TK_ID, D2TK_LIT("Home"),
 					D2TK_ALIGN_CENTERED, hrect))
 				{
 					new_page = 1;
@@ -205,7 +378,7 @@ _expose_footer(app_t *app, const d2tk_rect_t *rect)
 			} break;
 			case 1:
 			{
-				if(d2tk_base_button_label_is_changed(base, D2TK_ID, -1, "Prev",
+				if(d2tk_base_button_label_is_changed(base, D2TK_ID, D2TK_LIT("Prev"),
 					D2TK_ALIGN_CENTERED, hrect)
 					|| d2tk_base_get_left(base)
 					|| d2tk_base_get_up(base) )
@@ -215,7 +388,7 @@ _expose_footer(app_t *app, const d2tk_rect_t *rect)
 			} break;
 			case 2:
 			{
-				if(d2tk_base_button_label_is_changed(base, D2TK_ID, -1, "Next",
+				if(d2tk_base_button_label_is_changed(base, D2TK_ID, D2TK_LIT("Next"),
 					D2TK_ALIGN_CENTERED, hrect)
 					|| d2tk_base_get_right(base)
 					|| d2tk_base_get_down(base) )
@@ -225,7 +398,7 @@ _expose_footer(app_t *app, const d2tk_rect_t *rect)
 			} break;
 			case 3:
 			{
-				if(d2tk_base_button_label_is_changed(base, D2TK_ID, -1, "End",
+				if(d2tk_base_button_label_is_changed(base, D2TK_ID, D2TK_LIT("End"),
 					D2TK_ALIGN_CENTERED, hrect))
 				{
 					new_page = app->head->page_number;
@@ -238,7 +411,7 @@ _expose_footer(app_t *app, const d2tk_rect_t *rect)
 			} break;
 			case 5:
 			{
-				d2tk_base_label(base, -1, "Freeader", 1.f, hrect,
+				d2tk_base_label(base, D2TK_LIT("Freeader"), 1.f, hrect,
 					D2TK_ALIGN_MIDDLE | D2TK_ALIGN_RIGHT);
 			} break;
 		}
@@ -256,10 +429,12 @@ _expose_footer(app_t *app, const d2tk_rect_t *rect)
 
 	if(new_page != old_page)
 	{
+		d2tk_trace_instant("freeader", "input");
+
 		app->page = new_page - 1;
 
 		_page_set(app, app->page);
-		_next(app);
+		_redisplay(app); // next expose decodes and shows the first band
 	}
 }
 
@@ -267,6 +442,15 @@ static int
 _expose(void *data, d2tk_coord_t w, d2tk_coord_t h)
 {
 	app_t *app = data;
+	const uint64_t t0 = d2tk_trace_begin();
+
+	_panel_update(app);
+
+	// decode the next band, one per frame, the first one after a page turn
+	if(app->decoding)
+	{
+		_next(app);
+	}
 
 	const d2tk_rect_t rect = D2TK_RECT(0, 0, w, h);
 
@@ -289,30 +473,357 @@ _expose(void *data, d2tk_coord_t w, d2tk_coord_t h)
 		}
 	}
 
+	d2tk_trace_end("freeader", "_expose", t0);
+
+	return 0;
+}
+
+static void
+_trace_dump(const char *trace_file)
+{
+	if(!trace_file)
+	{
+		return;
+	}
+
+	FILE *fout = fopen(trace_file, "wb");
+	if(!fout)
+	{
+		fprintf(stderr, "cannot open %s\n", trace_file);
+		return;
+	}
+
+	d2tk_trace_dump(fout);
+	fclose(fout);
+}
+
+#if defined(FREEADER_HEADLESS)
+static int
+_cmp_ns(const void *a, const void *b)
+{
+	const uint64_t *A = a;
+	const uint64_t *B = b;
+
+	return (*A > *B) - (*A < *B);
+}
+
+static void
+_report(const char *name, uint64_t *ns, unsigned n)
+{
+	qsort(ns, n, sizeof(uint64_t), _cmp_ns);
+
+	const unsigned p50 = (n - 1) * 50 / 100;
+	const unsigned p90 = (n - 1) * 90 / 100;
+	const unsigned p99 = (n - 1) * 99 / 100;
+
+	fprintf(stdout, "%-8s p50 %8.3f ms  p90 %8.3f ms  p99 %8.3f ms  max %8.3f ms\n",
+		name, ns[p50] / 1e6, ns[p90] / 1e6, ns[p99] / 1e6, ns[n - 1] / 1e6);
+}
+
+static void
+_dump_ppm(app_t *app, const char *dump_dir, unsigned turn)
+{
+	char path [PATH_MAX];
+	snprintf(path, sizeof(path), "%s/%04u.ppm", dump_dir, turn);
+
+	FILE *fout = fopen(path, "wb");
+	if(!fout)
+	{
+		fprintf(stderr, "cannot open %s\n", path);
+		return;
+	}
+
+	size_t stride;
+	const uint32_t *pixels = d2tk_offscreen_get_pixels(app->doffscreen, &stride);
+	const d2tk_coord_t w = app->offscreen_config.w;
+	const d2tk_coord_t h = app->offscreen_config.h;
+
+	fprintf(fout, "P6\n%d %d\n255\n", w, h);
+
+	for(d2tk_coord_t y = 0; y < h; y++)
+	{
+		const uint32_t *row = (const uint32_t *)((const uint8_t *)pixels + y*stride);
+
+		for(d2tk_coord_t x = 0; x < w; x++)
+		{
+			const uint8_t rgb [3] = {
+				(row[x] >> 16) & 0xff,
+				(row[x] >> 8) & 0xff,
+				row[x] & 0xff
+			};
+
+			fwrite(rgb, sizeof(rgb), 1, fout);
+		}
+	}
+
+	fclose(fout);
+}
+
+static unsigned
+_batch_page(app_t *app, batch_t batch, unsigned page, int *dir,
+	unsigned *seed)
+{
+	const unsigned page_number = app->head->page_number;
+
+	switch(batch)
+	{
+		case BATCH_SEQUENTIAL:
+		{
+			return (page + 1) % page_number;
+		}
+		case BATCH_RANDOM:
+		{
+			return rand_r(seed) % page_number;
+		}
+		case BATCH_PINGPONG:
+		{
+			// walk to the end and back again
+			if( (*dir > 0) && (page + 1 >= page_number) )
+			{
+				*dir = -1;
+			}
+			else if( (*dir < 0) && (page == 0) )
+			{
+				*dir = 1;
+			}
+
+			return page_number > 1
+				? page + *dir
+				: page;
+		}
+		case BATCH_NONE:
+		{
+			// never reached
+		} break;
+	}
+
+	return page;
+}
+
+static int
+_batch(app_t *app, batch_t batch, unsigned turns, const char *dump_dir)
+{
+	uint64_t *decode = calloc(turns, sizeof(uint64_t));
+	uint64_t *convert = calloc(turns, sizeof(uint64_t));
+	uint64_t *render = calloc(turns, sizeof(uint64_t));
+	uint64_t *total = calloc(turns, sizeof(uint64_t));
+	uint64_t *first = calloc(turns, sizeof(uint64_t));
+
+	if(!decode || !convert || !render || !total || !first)
+	{
+		free(decode);
+		free(convert);
+		free(render);
+		free(total);
+		free(first);
+
+		return -1;
+	}
+
+	// render initial page to warm up caches
+	d2tk_offscreen_step(app->doffscreen);
+
+	unsigned page = app->page;
+	unsigned seed = 1;
+	int dir = 1;
+
+	app->timed = true;
+
+	for(unsigned turn = 0; turn < turns; turn++)
+	{
+		page = _batch_page(app, batch, page, &dir, &seed);
+
+		app->convert_ns = 0;
+		app->decode_ns = 0;
+		app->dirty = false;
+
+		const uint64_t t0 = _now_ns();
+
+		_page_set(app, page);
+
+		app->decode_ns += _now_ns() - t0;
+
+		// first band is decoded and shown from within _expose
+		d2tk_offscreen_step(app->doffscreen);
+
+		const uint64_t t1 = _now_ns();
+
+		// remaining bands, one per step
+		while(app->decoding)
+		{
+			d2tk_offscreen_step(app->doffscreen);
+		}
+
+		const uint64_t t2 = _now_ns();
+
+		convert[turn] = app->convert_ns;
+		decode[turn] = app->decode_ns - app->convert_ns;
+		render[turn] = (t2 - t0) - app->decode_ns;
+		first[turn] = t1 - t0;
+		total[turn] = t2 - t0;
+
+		if(dump_dir)
+		{
+			_dump_ppm(app, dump_dir, turn);
+		}
+	}
+
+	app->timed = false;
+
+	fprintf(stdout, "%u page turns\n", turns);
+	_report("decode", decode, turns);
+	_report("convert", convert, turns);
+	_report("render", render, turns);
+	_report("first", first, turns);
+	_report("total", total, turns);
+
+	if(app->panel)
+	{
+		_panel_update(app);
+		epaper_report(&app->epaper, stdout);
+	}
+
+	free(decode);
+	free(convert);
+	free(render);
+	free(total);
+	free(first);
+
 	return 0;
 }
+#endif
 
 int
-main(int argc __attribute__((unused)), char **argv)
+main(int argc, char **argv)
 {
 	static app_t app;
+	batch_t batch = BATCH_NONE;
+	unsigned turns = 100;
+	const char *dump_dir __attribute__((unused)) = NULL;
+	const char *trace_file = NULL;
+	uint32_t band_lines = 0;
+	epaper_policy_t policy = EPAPER_POLICY_PARTIAL;
 
 	app.page = UINT_MAX;
 
-	if(!argv[1])
+	int c;
+	while((c = getopt(argc, argv, "hb:n:d:t:p:e:")) != -1)
+	{
+		switch(c)
+		{
+			case 'h':
+			{
+				fprintf(stderr,
+					"USAGE\n"
+					"   %s [OPTIONS] file [page [rotation]]\n"
+					"\n"
+					"OPTIONS\n"
+					"   [-h]                   print usage information\n"
+					"   [-b] sequence          headless batch mode (seq|random|pingpong)\n"
+					"   [-n] turns             number of page turns in batch mode (%u)\n"
+					"   [-d] directory         dump batch frames as PPM into directory\n"
+					"   [-t] trace-file        record and export Chrome trace JSON\n"
+					"   [-p] lines             progressive rendering every n lines (%"PRIu32")\n"
+					"   [-e] policy            simulate e-paper panel (full|partial|area)\n\n"
+					, argv[0], turns, band_lines);
+			}	return 0;
+			case 'b':
+			{
+				if(!strcasecmp(optarg, "seq"))
+				{
+					batch = BATCH_SEQUENTIAL;
+				}
+				else if(!strcasecmp(optarg, "random"))
+				{
+					batch = BATCH_RANDOM;
+				}
+				else if(!strcasecmp(optarg, "pingpong"))
+				{
+					batch = BATCH_PINGPONG;
+				}
+				else
+				{
+					fprintf(stderr, "Unknown batch sequence `%s'.\n", optarg);
+					return -1;
+				}
+			}	break;
+			case 'n':
+			{
+				turns = atoi(optarg);
+			}	break;
+			case 'd':
+			{
+				dump_dir = optarg;
+			}	break;
+			case 't':
+			{
+				trace_file = optarg;
+			}	break;
+			case 'p':
+			{
+				band_lines = atoi(optarg);
+			}	break;
+			case 'e':
+			{
+				if(epaper_policy_from_string(optarg, &policy) != 0)
+				{
+					fprintf(stderr, "Unknown panel policy `%s'.\n", optarg);
+					return -1;
+				}
+
+				app.panel = true;
+			}	break;
+			case '?':
+			{
+				if( (optopt == 'b') || (optopt == 'n') || (optopt == 'd')
+					|| (optopt == 't') || (optopt == 'p') || (optopt == 'e') )
+					fprintf(stderr, "Option `-%c' requires an argument.\n", optopt);
+				else if(isprint(optopt))
+					fprintf(stderr, "Unknown option `-%c'.\n", optopt);
+				else
+					fprintf(stderr, "Unknown option character `\\x%x'.\n", optopt);
+			}	return -1;
+			default:
+			{
+			}	return -1;
+		}
+	}
+
+#if !defined(FREEADER_HEADLESS)
+	if(batch != BATCH_NONE)
+	{
+		fprintf(stderr, "batch mode needs the cairo backend\n");
+		return -1;
+	}
+#endif
+
+	if( (optind >= argc) || (turns == 0) )
 	{
 		return -1;
 	}
 
+	const char *path = argv[optind];
+
+	if(trace_file)
+	{
+		d2tk_trace_enable(true);
+	}
+
 	int page = 1;
-	if(argv[2])
+	int degrees = 0;
+	if(optind + 1 < argc)
 	{
-		page = atoi(argv[2]);
+		page = atoi(argv[optind + 1]);
+
+		if(optind + 2 < argc)
+		{
+			degrees = atoi(argv[optind + 2]);
+		}
 	}
 
 	app.scale = 1.f; //DPI_SCREEN / DPI_DISPLAY;
 
-	app.fin = fopen(argv[1], "rb");
+	app.fin = fopen(path, "rb");
 	if(!app.fin)
 	{
 		return -1;
@@ -331,6 +842,29 @@ main(int argc __attribute__((unused)), char **argv)
 
 	const uint32_t page_number = head.page_number;
 
+	if( (head.page_width * head.page_height > WIDTH * HEIGHT)
+		|| (freeader_rotator_init(&app.rot,
+			freeader_rotation_from_degrees(degrees), head.page_width,
+			head.page_height) != 0) )
+	{
+		return -1;
+	}
+
+	// progressive rendering only for unrotated pages
+	if( (band_lines == 0) || (band_lines > app.rot.dst_height)
+		|| (app.rot.rotation != ROTATION_0) )
+	{
+		band_lines = app.rot.dst_height;
+	}
+
+	app.band_lines = band_lines;
+	app.nbands = (app.rot.dst_height + band_lines - 1) / band_lines;
+	app.band_rev = calloc(app.nbands, sizeof(uint64_t));
+	if(!app.band_rev)
+	{
+		return -1;
+	}
+
 	size_t offset_size = page_number*sizeof(uint32_t);
 	app.head = malloc(sizeof(head_t) + offset_size);
 	memcpy(app.head, &head, sizeof(head));
@@ -346,8 +880,47 @@ main(int argc __attribute__((unused)), char **argv)
 	app.inbuf = malloc(app.inbuflen);
 	app.outbuf = malloc(app.outbuflen);
 
-	const d2tk_coord_t w = WIDTH;
-	const d2tk_coord_t h = HEIGHT + FOOTER;
+	const d2tk_coord_t w = app.rot.dst_width;
+	const d2tk_coord_t h = app.rot.dst_height + FOOTER;
+
+	epaper_init(&app.epaper, policy, w, h);
+
+#if defined(FREEADER_HEADLESS)
+	if(batch != BATCH_NONE)
+	{
+		d2tk_offscreen_config_t *config = &app.offscreen_config;
+		config->bundle_path = "/usr/local/share/freeader/"; //FIXME
+		config->w = w;
+		config->h = h;
+		config->expose = _expose;
+		config->data = &app;
+
+		app.doffscreen = d2tk_offscreen_new(config);
+		if(!app.doffscreen)
+		{
+			return -1;
+		}
+
+		app.base = d2tk_offscreen_get_base(app.doffscreen);
+
+		_page_set(&app, page - 1);
+
+		const int ret = _batch(&app, batch, turns, dump_dir);
+
+		_trace_dump(trace_file);
+
+		d2tk_offscreen_free(app.doffscreen);
+
+		free(app.head);
+		free(app.inbuf);
+		free(app.outbuf);
+		free(app.band_rev);
+		freeader_rotator_deinit(&app.rot);
+		fclose(app.fin);
+
+		return ret;
+	}
+#endif
 
 	d2tk_pugl_config_t *config = &app.config;
 	config->parent = 0;
@@ -368,12 +941,21 @@ main(int argc __attribute__((unused)), char **argv)
 		return -1;
 	}
 
+	app.base = d2tk_pugl_get_base(app.dpugl);
+
 	_page_set(&app, page - 1);
-	_next(&app);
 
 	sig_atomic_t done = 0; //FIXME
 	d2tk_pugl_run(app.dpugl, &done);
 
+	_trace_dump(trace_file);
+
+	if(app.panel)
+	{
+		_panel_update(&app);
+		epaper_report(&app.epaper, stdout);
+	}
+
 	d2tk_pugl_free(app.dpugl);
 
 	if(app.head)
@@ -391,5 +973,12 @@ main(int argc __attribute__((unused)), char **argv)
 		free(app.outbuf);
 	}
 
+	if(app.band_rev)
+	{
+		free(app.band_rev);
+	}
+
+	freeader_rotator_deinit(&app.rot);
+
 	return 0;
 }
@@ -27,7 +27,8 @@ struct _app_t {
 
 	head_t *head;
 
-	uint8_t *lines [3];
+	uint8_t *line;
+	rotator_t rot;
 
 	png_bytep *row_pointers;
 	uint8_t **raw_pointers;
@@ -159,10 +160,8 @@ _app_free(app_t *app)
 	free(app->row_pointers);
 	free(app->raw_pointers);
 
-	for(uint8_t l = 0; l < 3; l++)
-	{
-		free(app->lines[l]);
-	}
+	free(app->line);
+	freeader_rotator_deinit(&app->rot);
 
 	free(app->head);
 
@@ -171,7 +170,8 @@ _app_free(app_t *app)
 
 static app_t *
 _app_new(uint32_t width, uint32_t height, uint32_t page_number,
-	const char *title, const char *author, const char *output_file)
+	rotation_t rotation, const char *title, const char *author,
+	const char *output_file)
 {
 	app_t *app = calloc(1, sizeof(app_t));
 	if(!app)
@@ -183,6 +183,11 @@ _app_new(uint32_t width, uint32_t height, uint32_t page_number,
 	app->height = height;
 	app->page_number = page_number;
 
+	if(freeader_rotator_init(&app->rot, rotation, width, height) != 0)
+	{
+		goto fail;
+	}
+
 	const size_t head_size = sizeof(head_t) + page_number*sizeof(uint32_t);
 	app->head = calloc(head_size, 1);
 	if(!app->head)
@@ -193,18 +198,15 @@ _app_new(uint32_t width, uint32_t height, uint32_t page_number,
 	memcpy(app->head->magic, FREEADER_MAGIC, FREEADER_MAGIC_LEN);
 	strncpy(app->head->title, title, FREEADER_TITLE_LEN);
 	strncpy(app->head->author, author, FREEADER_AUTHOR_LEN);
-	app->head->page_width = width;
-	app->head->page_height = height;
+	app->head->page_width = app->rot.dst_width;
+	app->head->page_height = app->rot.dst_height;
 	app->head->page_number = page_number;
 
 	const size_t buflen = (width >> 3) + !!(width & 7);
-	for(uint8_t l = 0; l < 3; l++)
+	app->line = malloc(buflen);
+	if(!app->line)
 	{
-		app->lines[l] = malloc(buflen);
-		if(!app->lines[l])
-		{
-			goto fail;
-		}
+		goto fail;
 	}
 
 	app->row_pointers = malloc(sizeof(png_bytep) * height);
@@ -250,6 +252,7 @@ main(int argc, char **argv)
 	uint32_t width = 800;
 	uint32_t height = 600;
 	uint8_t thresh = 0xff;
+	int degrees = 0;
 	image_format_t image_format = IMAGE_FORMAT_PBM;
 	const char *output_file = "out.pig";
 	const char *title = "Unknown";
@@ -261,7 +264,7 @@ main(int argc, char **argv)
 		"Released under Artistic License 2.0 by Open Music Kontrollers\n", argv[0]);
 	
 	int c;
-	while((c = getopt(argc, argv, "vhW:H:F:T:O:t:a:")) != -1)
+	while((c = getopt(argc, argv, "vhW:H:F:T:R:O:t:a:")) != -1)
 	{
 		switch(c)
 		{
@@ -296,10 +299,11 @@ main(int argc, char **argv)
 					"   [-H] height            height in pixels (%"PRIu32")\n"
 					"   [-F] image-format      image format (pbm|png)\n"
 					"   [-T] threshold         greyscale threshold (0x%02"PRIx8")\n"
+					"   [-R] rotation          clockwise rotation (0|90|180|270) (%i)\n"
 					"   [-O] output-file       output file (%s)\n"
 					"   [-t] title             set book title (%s)\n"
 					"   [-a] author            set book author (%s)\n\n"
-					, argv[0], width, height, thresh, output_file, title, author);
+					, argv[0], width, height, thresh, degrees, output_file, title, author);
 			}	return 0;
 			case 'W':
 			{
@@ -313,6 +317,10 @@ main(int argc, char **argv)
 			{
 				thresh = atoi(optarg);
 			}	break;
+			case 'R':
+			{
+				degrees = atoi(optarg);
+			}	break;
 			case 'F':
 			{
 				if(!strcasecmp(optarg, "png"))
@@ -339,7 +347,7 @@ main(int argc, char **argv)
 			case '?':
 			{
 				if(  (optopt == 'W') || (optopt == 'H')
-					|| (optopt == 'F') || (optopt == 'T')
+					|| (optopt == 'F') || (optopt == 'T') || (optopt == 'R')
 					|| (optopt == 'O') || (optopt == 't') || (optopt == 'a') )
 					fprintf(stderr, "Option `-%c' requires an argument.\n", optopt);
 				else if(isprint(optopt))
@@ -355,19 +363,24 @@ main(int argc, char **argv)
 
 	const uint32_t page_number = argc - optind;
 
-	app_t *app = _app_new(width, height, page_number, title, author,
-		output_file);
+	app_t *app = _app_new(width, height, page_number,
+		freeader_rotation_from_degrees(degrees), title, author, output_file);
 	if(!app)
 	{
 		goto fail;
 	}
 
+	// encoded page dimensions, swapped for 90/270
+	const uint32_t enc_width = app->rot.dst_width;
+	const uint32_t enc_height = app->rot.dst_height;
+	const uint32_t enc_stride = app->rot.dst_stride;
+
 	struct jbg85_enc_state state;
 
 	for(uint32_t p = 0; p < page_number; p++)
 	{
-		jbg85_enc_init(&state, width, height, _out, app);
-		jbg85_enc_options(&state, JBG_TPBON, height, 8); // defaults
+		jbg85_enc_init(&state, enc_width, enc_height, _out, app);
+		jbg85_enc_options(&state, JBG_TPBON, enc_height, 8); // defaults
 
 		app->head->page_offset[p] = ftell(app->enc.fout);
 
@@ -391,13 +404,10 @@ main(int argc, char **argv)
 			} break;
 		}
 
+		// pack source lines and feed them through the rotator
 		for(uint32_t j = 0; j < height; j++)
 		{
-			uint8_t *line = app->lines[j % 3];
-			uint8_t *prevline = NULL;
-			uint8_t *prevprevline = NULL;
-
-			uint8_t *dst = line;
+			uint8_t *dst = app->line;
 
 			switch(image_format)
 			{
@@ -427,13 +437,22 @@ main(int argc, char **argv)
 				} break;
 			}
 
+			freeader_rotator_line(&app->rot, app->line, j);
+		}
+
+		for(uint32_t j = 0; j < enc_height; j++)
+		{
+			uint8_t *line = &app->rot.dst[j*enc_stride];
+			uint8_t *prevline = NULL;
+			uint8_t *prevprevline = NULL;
+
 			if(j > 0)
 			{
-				prevline = app->lines[ (j - 1) % 3];
+				prevline = line - enc_stride;
 			}
 			if(j > 1)
 			{
-				prevprevline = app->lines[ (j - 2) % 3];
+				prevprevline = line - 2*enc_stride;
 			}
 			jbg85_enc_lineout(&state, line, prevline, prevprevline);
 		}
@@ -17,13 +17,25 @@
 
 #define MAX_PATH_LEN 1024
 
+//#define FONT_FACE "cairo:monospace"
+#define FONT_FACE "Gentium"
+
+typedef struct _line_t line_t;
 typedef struct _item_t item_t;
 typedef struct _app_t app_t;
 
+// shaped once at its fixed position, as it is the same on every page
+struct _line_t {
+	cairo_scaled_font_t *font;
+	cairo_glyph_t *glyphs;
+	int nglyphs;
+};
+
 struct _item_t {
 	char title [FREEADER_TITLE_LEN];
 	char author [FREEADER_AUTHOR_LEN];
 	bool is_folder;
+	line_t lines [2]; // title, author
 };
 
 struct _app_t {
@@ -68,16 +80,60 @@ _save_to_pbm(const char *path, unsigned width, unsigned height, unsigned stride,
 }
 
 static void
-_render_item(cairo_t *ctx, const item_t *item, float Y, float DY, bool hi)
+_shape_line(cairo_t *ctx, line_t *line, const char *text,
+	cairo_font_slant_t slant, cairo_font_weight_t weight, float x, float y)
 {
-	//const char *font_face = "cairo:monospace";
-	const char *font_face = "Gentium";
 	cairo_text_extents_t extents;
 
+	cairo_select_font_face(ctx, FONT_FACE, slant, weight);
+	cairo_text_extents(ctx, text, &extents);
+
+	line->font = cairo_scaled_font_reference(cairo_get_scaled_font(ctx));
+	line->glyphs = NULL;
+	line->nglyphs = 0;
+
+	if(cairo_scaled_font_text_to_glyphs(line->font,
+			x - extents.x_bearing, y - extents.y_bearing, text, -1,
+			&line->glyphs, &line->nglyphs, NULL, NULL, NULL) != CAIRO_STATUS_SUCCESS)
+	{
+		line->glyphs = NULL;
+		line->nglyphs = 0;
+	}
+}
+
+static void
+_shape_item(cairo_t *ctx, item_t *item, float Y, float DY)
+{
 	DY /= 7;
 	cairo_set_font_size(ctx, 2*DY);
 	const float R = DY*3;
 
+	_shape_line(ctx, &item->lines[0], item->title,
+		CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD,
+		R + DY/2, Y + DY/2 + DY);
+	_shape_line(ctx, &item->lines[1], item->author,
+		CAIRO_FONT_SLANT_ITALIC, CAIRO_FONT_WEIGHT_NORMAL,
+		R + DY/2, Y + DY/2 + DY*3);
+}
+
+static void
+_unshape_item(item_t *item)
+{
+	for(unsigned l = 0; l < 2; l++)
+	{
+		line_t *line = &item->lines[l];
+
+		cairo_glyph_free(line->glyphs);
+		cairo_scaled_font_destroy(line->font);
+	}
+}
+
+static void
+_render_item(cairo_t *ctx, const item_t *item, float Y, float DY, bool hi)
+{
+	DY /= 7;
+	const float R = DY*3;
+
 	cairo_new_sub_path(ctx);
 	cairo_arc(ctx, R + DY/2, Y + DY/2 + R, R, M_PI/2, 3*M_PI/2);
 	cairo_arc(ctx, 1.0 - DY/2 - R, Y + DY/2 + R, R, 3*M_PI/2, M_PI/2);
@@ -108,30 +164,12 @@ _render_item(cairo_t *ctx, const item_t *item, float Y, float DY, bool hi)
 		cairo_fill(ctx);
 	}
 
+	for(unsigned l = 0; l < 2; l++)
 	{
-		cairo_text_extents(ctx, item->title, &extents);
-		const float dx = extents.x_bearing;
-		const float dy = extents.y_bearing;
-
-		cairo_move_to(ctx, R + DY/2, Y + DY/2 + DY);
-		cairo_rel_move_to(ctx, -dx, -dy);
-
-		cairo_select_font_face(ctx, font_face,
-			CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
-		cairo_show_text(ctx, item->title);
-	}
-
-	{
-		cairo_text_extents(ctx, item->author, &extents);
-		const float dx = extents.x_bearing;
-		const float dy = extents.y_bearing;
-
-		cairo_move_to(ctx, R + DY/2, Y + DY/2 + DY*3);
-		cairo_rel_move_to(ctx, -dx, -dy);
+		const line_t *line = &item->lines[l];
 
-		cairo_select_font_face(ctx, font_face,
-			CAIRO_FONT_SLANT_ITALIC, CAIRO_FONT_WEIGHT_NORMAL);
-		cairo_show_text(ctx, item->author);
+		cairo_set_scaled_font(ctx, line->font);
+		cairo_show_glyphs(ctx, line->glyphs, line->nglyphs);
 	}
 
 	if(hi)
@@ -141,17 +179,32 @@ _render_item(cairo_t *ctx, const item_t *item, float Y, float DY, bool hi)
 }
 
 static void
-_render(app_t *app, const char *fmt, const item_t *items, unsigned num,
+_render(app_t *app, const char *fmt, item_t *items, unsigned num,
 	unsigned width, unsigned height, unsigned stride, const void *data)
 {
+	const float DY = 1.0 / 8;
 	unsigned i = 0;
 
+	{
+		float Y = 0.0;
+
+		cairo_save(app->ctx);
+
+		for(item_t *item = items;
+			item - items < num;
+			item++, Y += DY)
+		{
+			_shape_item(app->ctx, item, Y, DY);
+		}
+
+		cairo_restore(app->ctx);
+	}
+
 	for(const item_t *item1 = items;
 		item1 - items < num;
 		item1++, i++)
 	{
 		float Y = 0.0;
-		const float DY = 1.0 / 8;
 
 		// save state
 		cairo_save(app->ctx);
@@ -181,6 +234,13 @@ _render(app_t *app, const char *fmt, const item_t *items, unsigned num,
 		snprintf(path, sizeof(path), fmt, i);
 		_save_to_pbm(path, width, height, stride, data);
 	}
+
+	for(item_t *item = items;
+		item - items < num;
+		item++)
+	{
+		_unshape_item(item);
+	}
 }
 
 static item_t *
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+#ifndef _D2TK_BACKEND_MONO_H
+#define _D2TK_BACKEND_MONO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _d2tk_mono_surf_t d2tk_mono_surf_t;
+
+// target of the mono backend, passed as context to its driver's new and to
+// custom draw callbacks, pixels are packed most significant bits first with
+// 0 being black and (1 << bpp) - 1 being white
+struct _d2tk_mono_surf_t {
+	uint8_t *buf; // 32-bit aligned
+	uint32_t w;
+	uint32_t h;
+	uint32_t stride; // in bytes, multiple of 4
+	uint8_t bpp; // 1 or 2
+};
+
+static inline uint8_t
+d2tk_mono_surf_get(const d2tk_mono_surf_t *surf, uint32_t x, uint32_t y)
+{
+	const uint32_t bit = x * surf->bpp;
+	const uint8_t byte = surf->buf[y*surf->stride + (bit >> 3)];
+
+	return (byte >> (8 - surf->bpp - (bit & 7))) & ( (1 << surf->bpp) - 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _D2TK_BACKEND_MONO_H
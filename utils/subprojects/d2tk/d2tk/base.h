@@ -21,6 +21,7 @@
 #include <stdlib.h>
 
 #include <d2tk/core.h>
+#include <d2tk/hash.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -109,7 +110,7 @@ typedef enum _d2tk_flag_t {
 
 #define D2TK_ID_IDX(IDX) ((d2tk_id_t)__LINE__ << 16) | (IDX)
 #define D2TK_ID_FILE_IDX(IDX) \
-	((d2tk_id_t)d2tk_hash(__FILE__, -1) << 32) | D2TK_ID_IDX((IDX))
+	((d2tk_id_t)D2TK_HASH_LIT(__FILE__) << 32) | D2TK_ID_IDX((IDX))
 #define D2TK_ID D2TK_ID_IDX(0)
 #define D2TK_ID_FILE D2TK_ID_FILE_IDX(0)
 
@@ -329,6 +330,9 @@ d2tk_base_is_active_hot(d2tk_base_t *base, d2tk_id_t id,
 D2TK_API void
 d2tk_base_cursor(d2tk_base_t *base, const d2tk_rect_t *rect);
 
+D2TK_API void
+d2tk_base_stats(d2tk_base_t *base, const d2tk_rect_t *rect);
+
 D2TK_API d2tk_state_t
 d2tk_base_button_label_image(d2tk_base_t *base, d2tk_id_t id, ssize_t lbl_len,
 	const char *lbl, d2tk_align_t align, ssize_t path_len, const char *path, 
@@ -392,9 +396,10 @@ d2tk_base_bitmap(d2tk_base_t *base, uint32_t w, uint32_t h, uint32_t stride,
 	const uint32_t *argb, uint64_t rev, const d2tk_rect_t *rect,
 	d2tk_align_t align);
 
+// rev identifies the content of data, 0 has it hashed instead
 D2TK_API void
 d2tk_base_custom(d2tk_base_t *base, uint32_t size, const void *data,
-	const d2tk_rect_t *rect, d2tk_core_custom_t custom);
+	uint64_t rev, const d2tk_rect_t *rect, d2tk_core_custom_t custom);
 
 D2TK_API d2tk_state_t
 d2tk_base_meter(d2tk_base_t *base, d2tk_id_t id, const d2tk_rect_t *rect,
@@ -556,6 +561,9 @@ d2tk_base_new(const d2tk_core_driver_t *driver, void *data);
 D2TK_API void
 d2tk_base_set_ttls(d2tk_base_t *base, uint32_t sprites, uint32_t memcaches);
 
+D2TK_API void
+d2tk_base_set_budgets(d2tk_base_t *base, size_t sprites, size_t memcaches);
+
 D2TK_API void
 d2tk_base_free(d2tk_base_t *base);
 
@@ -631,6 +639,21 @@ d2tk_base_set_dimensions(d2tk_base_t *base, d2tk_coord_t w, d2tk_coord_t h);
 D2TK_API void
 d2tk_base_get_dimensions(d2tk_base_t *base, d2tk_coord_t *w, d2tk_coord_t *h);
 
+D2TK_API bool
+d2tk_base_get_dirty_rect(d2tk_base_t *base, d2tk_rect_t *rect);
+
+D2TK_API const d2tk_rect_t *
+d2tk_base_get_dirty_rects(d2tk_base_t *base, unsigned *nrects);
+
+D2TK_API void
+d2tk_base_get_stats(d2tk_base_t *base, d2tk_stats_t *frame, d2tk_stats_t *total);
+
+D2TK_API void
+d2tk_base_set_record(d2tk_base_t *base, FILE *fout);
+
+D2TK_API int
+d2tk_base_replay(d2tk_base_t *base, FILE *fin);
+
 #ifdef __cplusplus
 }
 #endif
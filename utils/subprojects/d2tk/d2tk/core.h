@@ -20,6 +20,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
 
 #include <d2tk/d2tk.h>
 
@@ -33,6 +34,7 @@ typedef struct _d2tk_widget_t d2tk_widget_t;
 typedef struct _d2tk_point_t d2tk_point_t;
 typedef struct _d2tk_core_t d2tk_core_t;
 typedef struct _d2tk_core_driver_t d2tk_core_driver_t;
+typedef struct _d2tk_stats_t d2tk_stats_t;
 typedef void (*d2tk_core_custom_t)(void *ctx, uint32_t size, const void *data);
 
 typedef enum _d2tk_align_t {
@@ -59,6 +61,30 @@ struct _d2tk_point_t {
 	d2tk_coord_t y;
 };
 
+// performance counters, per frame or cumulative
+struct _d2tk_stats_t {
+	uint64_t frames;
+	uint64_t bytes; // of command stream
+	uint64_t bboxes;
+	uint64_t appeared; // bboxes
+	uint64_t disappeared; // bboxes
+	uint64_t fills; // damaged areas
+	uint64_t area; // damaged pixels, after merging to rectangles
+	uint64_t sprite_hits;
+	uint64_t sprite_misses;
+	uint64_t sprite_evictions;
+	uint64_t memcache_hits;
+	uint64_t memcache_misses;
+	uint64_t memcache_evictions;
+	uint64_t layout_hits; // text layouts
+	uint64_t layout_misses;
+	uint64_t layout_evictions;
+	uint64_t mem_grows; // command buffer reallocations
+	uint64_t passes;
+	uint64_t diff_ns;
+	uint64_t pass_ns [2];
+};
+
 #define D2TK_RECT(X, Y, W, H) \
 	((d2tk_rect_t){ .x = (X), .y = (Y), .w = (W), .h = (H) })
 
@@ -178,9 +204,10 @@ d2tk_core_bitmap(d2tk_core_t *core, const d2tk_rect_t *rect, uint32_t w,
 	uint32_t h, uint32_t stride, const uint32_t *argb, uint64_t rev,
 	d2tk_align_t align);
 
+// rev identifies the content of data, 0 has it hashed instead
 D2TK_API void
 d2tk_core_custom(d2tk_core_t *core, const d2tk_rect_t *rect, uint32_t size,
-	const void *data, d2tk_core_custom_t custom);
+	const void *data, uint64_t rev, d2tk_core_custom_t custom);
 
 D2TK_API void
 d2tk_core_stroke_width(d2tk_core_t *core, d2tk_coord_t width);
@@ -197,6 +224,9 @@ d2tk_core_new(const d2tk_core_driver_t *driver, void *data);
 D2TK_API void
 d2tk_core_set_ttls(d2tk_core_t *core, uint32_t sprites, uint32_t memcaches);
 
+D2TK_API void
+d2tk_core_set_budgets(d2tk_core_t *core, size_t sprites, size_t memcaches);
+
 D2TK_API void
 d2tk_core_free(d2tk_core_t *core);
 
@@ -206,6 +236,21 @@ d2tk_core_set_dimensions(d2tk_core_t *core, d2tk_coord_t w, d2tk_coord_t h);
 D2TK_API void
 d2tk_core_get_dimensions(d2tk_core_t *core, d2tk_coord_t *w, d2tk_coord_t *h);
 
+D2TK_API bool
+d2tk_core_get_dirty_rect(d2tk_core_t *core, d2tk_rect_t *rect);
+
+D2TK_API const d2tk_rect_t *
+d2tk_core_get_dirty_rects(d2tk_core_t *core, unsigned *nrects);
+
+D2TK_API void
+d2tk_core_get_stats(d2tk_core_t *core, d2tk_stats_t *frame, d2tk_stats_t *total);
+
+D2TK_API void
+d2tk_core_set_record(d2tk_core_t *core, FILE *fout);
+
+D2TK_API int
+d2tk_core_replay(d2tk_core_t *core, FILE *fin);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,15 @@ extern "C" {
 #endif
 
 typedef int (*d2tk_fbdev_expose_t)(void *data, d2tk_coord_t w, d2tk_coord_t h);
+typedef int (*d2tk_fbdev_update_t)(void *data, const d2tk_rect_t *rect);
+
+typedef enum _d2tk_fbdev_format_t {
+	D2TK_FBDEV_FORMAT_AUTO = 0, // query from device
+	D2TK_FBDEV_FORMAT_XRGB8888,
+	D2TK_FBDEV_FORMAT_RGB565,
+	D2TK_FBDEV_FORMAT_Y8,
+	D2TK_FBDEV_FORMAT_Y1 // MSB first, 1 is white
+} d2tk_fbdev_format_t;
 
 typedef struct _d2tk_fbdev_t d2tk_fbdev_t;
 typedef struct _d2tk_fbdev_config_t d2tk_fbdev_config_t;
@@ -35,7 +44,15 @@ struct _d2tk_fbdev_config_t {
 	const char *fb_device;
 	const char *bundle_path;
 	d2tk_fbdev_expose_t expose;
+	d2tk_fbdev_update_t update; // optional, called per flushed rect
+	uint32_t timeout; // optional periodic redisplay in ms, 0 disables
+	bool stats; // show overlay with performance counters
 	void *data;
+
+	// geometry of file-backed framebuffers, devices are queried instead
+	d2tk_fbdev_format_t format;
+	d2tk_coord_t w;
+	d2tk_coord_t h;
 };
 
 D2TK_API d2tk_fbdev_t *
@@ -50,6 +67,9 @@ d2tk_fbdev_step(d2tk_fbdev_t *fbdev);
 D2TK_API void
 d2tk_fbdev_run(d2tk_fbdev_t *fbdev, const sig_atomic_t *done);
 
+D2TK_API void
+d2tk_fbdev_redisplay(d2tk_fbdev_t *fbdev);
+
 D2TK_API d2tk_base_t *
 d2tk_fbdev_get_base(d2tk_fbdev_t *fbdev);
 
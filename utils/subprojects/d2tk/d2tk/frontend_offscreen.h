@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+#ifndef _D2TK_FRONTEND_OFFSCREEN_H
+#define _D2TK_FRONTEND_OFFSCREEN_H
+
+#include <d2tk/base.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int (*d2tk_offscreen_expose_t)(void *data, d2tk_coord_t w, d2tk_coord_t h);
+
+typedef struct _d2tk_offscreen_t d2tk_offscreen_t;
+typedef struct _d2tk_offscreen_config_t d2tk_offscreen_config_t;
+
+struct _d2tk_offscreen_config_t {
+	const char *bundle_path;
+	d2tk_coord_t w;
+	d2tk_coord_t h;
+	d2tk_offscreen_expose_t expose;
+	void *data;
+};
+
+D2TK_API d2tk_offscreen_t *
+d2tk_offscreen_new(const d2tk_offscreen_config_t *config);
+
+D2TK_API void
+d2tk_offscreen_free(d2tk_offscreen_t *offscreen);
+
+D2TK_API int
+d2tk_offscreen_step(d2tk_offscreen_t *offscreen);
+
+D2TK_API const uint32_t *
+d2tk_offscreen_get_pixels(d2tk_offscreen_t *offscreen, size_t *stride);
+
+D2TK_API d2tk_base_t *
+d2tk_offscreen_get_base(d2tk_offscreen_t *offscreen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _D2TK_FRONTEND_OFFSCREEN_H
@@ -40,6 +40,7 @@ struct _d2tk_pugl_config_t {
 	d2tk_coord_t h;
 	bool fixed_size;
 	bool fixed_aspect;
+	bool stats; // show overlay with performance counters
 	d2tk_pugl_expose_t expose;
 	void *data;
 };
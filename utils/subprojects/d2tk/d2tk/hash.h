@@ -28,12 +28,55 @@ extern "C" {
 #endif
 
 typedef struct _d2tk_hash_dict_t d2tk_hash_dict_t;
+typedef struct _d2tk_hasher_t d2tk_hasher_t;
+typedef struct _d2tk_hash_stream_t d2tk_hash_stream_t;
 
 struct _d2tk_hash_dict_t {
 	const void *key;
 	size_t len;
 };
 
+// incremental hashing, same results as d2tk_hash_foreach for same keys
+struct _d2tk_hasher_t {
+	uint64_t state;
+};
+
+// keys longer than this take the wide path, which runs independent lanes over
+// blocks of this size
+#define D2TK_HASH_BLOCK 1024
+#define D2TK_HASH_LANES 8
+
+// streaming of a single key in chunks of any size, same result as d2tk_hash
+// over the concatenation of all chunks
+struct _d2tk_hash_stream_t {
+	uint64_t acc [D2TK_HASH_LANES];
+	uint64_t len;
+	uint8_t buf [D2TK_HASH_BLOCK]; // 8-byte aligned
+	uint32_t fill;
+};
+
+// FNV-1a of a string literal folded at compile time, up to the last 64
+// characters are hashed, its length is always accounted for
+#define _D2TK_HASH_LIT_LEN(S) (sizeof(S) - 1)
+#define _D2TK_HASH_LIT_STEP(S, I, H) \
+	( ( (H) ^ (uint8_t)(S)[(I) < _D2TK_HASH_LIT_LEN(S) \
+		? _D2TK_HASH_LIT_LEN(S) - 1 - (I) : 0] ) \
+	* ( (I) < _D2TK_HASH_LIT_LEN(S) ? UINT64_C(0x100000001b3) : 1 ) )
+#define _D2TK_HASH_LIT_8(S, I, H) \
+	_D2TK_HASH_LIT_STEP(S, (I)+7, _D2TK_HASH_LIT_STEP(S, (I)+6, \
+	_D2TK_HASH_LIT_STEP(S, (I)+5, _D2TK_HASH_LIT_STEP(S, (I)+4, \
+	_D2TK_HASH_LIT_STEP(S, (I)+3, _D2TK_HASH_LIT_STEP(S, (I)+2, \
+	_D2TK_HASH_LIT_STEP(S, (I)+1, _D2TK_HASH_LIT_STEP(S, (I), (H)))))))))
+#define D2TK_HASH_LIT(S) \
+	_D2TK_HASH_LIT_8(S, 56, _D2TK_HASH_LIT_8(S, 48, \
+	_D2TK_HASH_LIT_8(S, 40, _D2TK_HASH_LIT_8(S, 32, \
+	_D2TK_HASH_LIT_8(S, 24, _D2TK_HASH_LIT_8(S, 16, \
+	_D2TK_HASH_LIT_8(S, 8, _D2TK_HASH_LIT_8(S, 0, \
+	UINT64_C(0xcbf29ce484222325) ^ _D2TK_HASH_LIT_LEN(S)))))))))
+
+// length and pointer of a string literal, e.g. for labels
+#define D2TK_LIT(S) (ssize_t)_D2TK_HASH_LIT_LEN(S), (S)
+
 D2TK_API uint64_t
 d2tk_hash(const void *data, ssize_t nbytes);
 
@@ -43,6 +86,34 @@ d2tk_hash_foreach(const void *data, ssize_t nbytes, ...) __attribute__((sentinel
 D2TK_API uint64_t
 d2tk_hash_dict(const d2tk_hash_dict_t *dict);
 
+D2TK_API void
+d2tk_hasher_init(d2tk_hasher_t *hasher);
+
+D2TK_API void
+d2tk_hasher_update(d2tk_hasher_t *hasher, const void *key, size_t len);
+
+D2TK_API void
+d2tk_hasher_update_str(d2tk_hasher_t *hasher, const char *str);
+
+D2TK_API void
+d2tk_hasher_update_u32(d2tk_hasher_t *hasher, uint32_t val);
+
+D2TK_API void
+d2tk_hasher_update_u64(d2tk_hasher_t *hasher, uint64_t val);
+
+D2TK_API uint64_t
+d2tk_hasher_final(const d2tk_hasher_t *hasher);
+
+D2TK_API void
+d2tk_hash_stream_init(d2tk_hash_stream_t *stream);
+
+D2TK_API void
+d2tk_hash_stream_update(d2tk_hash_stream_t *stream, const void *data,
+	size_t len);
+
+D2TK_API uint64_t
+d2tk_hash_stream_final(const d2tk_hash_stream_t *stream);
+
 #ifdef __cplusplus
 }
 #endif
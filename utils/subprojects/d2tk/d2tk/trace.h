@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+#ifndef _D2TK_TRACE_H
+#define _D2TK_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <d2tk/d2tk.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define D2TK_TRACE_MAX 0x1000 // must be power of two
+
+typedef struct _d2tk_trace_event_t d2tk_trace_event_t;
+
+struct _d2tk_trace_event_t {
+	const char *name; // must be a static string
+	const char *cat; // must be a static string
+	uint64_t ts; // nanoseconds, monotonic
+	uint64_t dur; // nanoseconds, 0 for instant events
+	bool instant;
+};
+
+D2TK_API void
+d2tk_trace_enable(bool enabled);
+
+D2TK_API bool
+d2tk_trace_is_enabled();
+
+D2TK_API void
+d2tk_trace_clear();
+
+D2TK_API uint64_t
+d2tk_trace_now();
+
+D2TK_API uint64_t
+d2tk_trace_begin();
+
+D2TK_API void
+d2tk_trace_end(const char *cat, const char *name, uint64_t begin);
+
+D2TK_API void
+d2tk_trace_instant(const char *cat, const char *name);
+
+D2TK_API size_t
+d2tk_trace_get_events(const d2tk_trace_event_t **events, size_t *offset);
+
+D2TK_API int
+d2tk_trace_dump(FILE *fout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _D2TK_TRACE_H
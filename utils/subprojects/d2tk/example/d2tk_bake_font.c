@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+// bakes printable ASCII of a TrueType font into the 1-bpp glyph atlas of the
+// mono backend, e.g. d2tk.bake_font -s 32 Roboto-Bold.ttf > src/font_mono.h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <math.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb_truetype.h"
+#pragma GCC diagnostic pop
+
+#define FIRST 0x20
+#define LAST 0x7e
+#define THRESHOLD 0x80 // coverage from which on a pixel is set
+
+static uint8_t *
+_load(const char *path, size_t *size)
+{
+	FILE *fin = fopen(path, "rb");
+	if(!fin)
+	{
+		return NULL;
+	}
+
+	fseek(fin, 0, SEEK_END);
+	*size = ftell(fin);
+	fseek(fin, 0, SEEK_SET);
+
+	uint8_t *buf = malloc(*size);
+	if(buf && (fread(buf, *size, 1, fin) != 1) )
+	{
+		free(buf);
+		buf = NULL;
+	}
+
+	fclose(fin);
+
+	return buf;
+}
+
+int
+main(int argc, char **argv)
+{
+	int size = 32;
+
+	int c;
+	while( (c = getopt(argc, argv, "s:")) != -1)
+	{
+		switch(c)
+		{
+			case 's':
+			{
+				size = atoi(optarg);
+			} break;
+
+			default:
+			{
+				fprintf(stderr, "Usage: %s [options] font.ttf\n"
+					"  -s  size  em size in pixels (32)\n\n",
+					argv[0]);
+			} return EXIT_FAILURE;
+		}
+	}
+
+	if(optind >= argc)
+	{
+		fprintf(stderr, "%s: no font given\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	size_t len;
+	uint8_t *ttf = _load(argv[optind], &len);
+	if(!ttf)
+	{
+		fprintf(stderr, "%s: cannot load '%s'\n", argv[0], argv[optind]);
+		return EXIT_FAILURE;
+	}
+
+	stbtt_fontinfo info;
+	if(!stbtt_InitFont(&info, ttf, stbtt_GetFontOffsetForIndex(ttf, 0)))
+	{
+		fprintf(stderr, "%s: invalid font '%s'\n", argv[0], argv[optind]);
+		free(ttf);
+		return EXIT_FAILURE;
+	}
+
+	const float scale = stbtt_ScaleForMappingEmToPixels(&info, size);
+	int ascent;
+	int descent;
+	int gap;
+	stbtt_GetFontVMetrics(&info, &ascent, &descent, &gap);
+
+	fprintf(stdout, "// generated by d2tk.bake_font from %s, do not edit\n\n",
+		basename(argv[optind]));
+	fprintf(stdout, "#define _D2TK_MONO_FONT_SIZE %i // em size in pixels\n", size);
+	fprintf(stdout, "#define _D2TK_MONO_FONT_ASCENT %i\n",
+		(int)lroundf(ascent * scale));
+	fprintf(stdout, "#define _D2TK_MONO_FONT_DESCENT %i\n",
+		(int)lroundf(-descent * scale));
+	fprintf(stdout, "#define _D2TK_MONO_FONT_FIRST 0x%02x\n", FIRST);
+	fprintf(stdout, "#define _D2TK_MONO_FONT_LAST 0x%02x\n\n", LAST);
+
+	uint8_t *atlas = NULL;
+	size_t natlas = 0;
+
+	// offset, width, height, x and y offset to pen, advance in 1/64 pixels
+	fprintf(stdout, "static const d2tk_mono_glyph_t _d2tk_mono_glyphs [] = {\n");
+	for(int cp = FIRST; cp <= LAST; cp++)
+	{
+		int w;
+		int h;
+		int xoff;
+		int yoff;
+		int adv;
+		int lsb;
+
+		uint8_t *bmp = stbtt_GetCodepointBitmap(&info, scale, scale, cp,
+			&w, &h, &xoff, &yoff);
+		stbtt_GetCodepointHMetrics(&info, cp, &adv, &lsb);
+
+		const int pitch = (w + 7) / 8;
+		const size_t offset = natlas;
+
+		natlas += pitch*h;
+		atlas = realloc(atlas, natlas);
+		memset(&atlas[offset], 0x0, pitch*h);
+
+		for(int y = 0; y < h; y++)
+		{
+			for(int x = 0; x < w; x++)
+			{
+				if(bmp[y*w + x] >= THRESHOLD)
+				{
+					atlas[offset + y*pitch + x/8] |= 0x80 >> (x % 8);
+				}
+			}
+		}
+
+		stbtt_FreeBitmap(bmp, NULL);
+
+		fprintf(stdout, "\t{ %5zu, %2i, %2i, %3i, %3i, %4i }, // '%c'\n",
+			offset, w, h, xoff, yoff, (int)lroundf(adv * scale * 64), cp);
+	}
+	fprintf(stdout, "};\n\n");
+
+	fprintf(stdout, "static const uint8_t _d2tk_mono_atlas [%zu] = {", natlas);
+	for(size_t i = 0; i < natlas; i++)
+	{
+		fprintf(stdout, "%s0x%02x,", (i % 12) ? " " : "\n\t", atlas[i]);
+	}
+	fprintf(stdout, "\n};\n");
+
+	free(atlas);
+	free(ttf);
+
+	return EXIT_SUCCESS;
+}
@@ -151,9 +151,20 @@ main(int argc, char **argv)
 {
 	static app_t app;
 	static char fb_device [PATH_MAX] = AUTO;
+	static const char *formats [] = {
+		[D2TK_FBDEV_FORMAT_AUTO] = AUTO,
+		[D2TK_FBDEV_FORMAT_XRGB8888] = "xrgb8888",
+		[D2TK_FBDEV_FORMAT_RGB565] = "rgb565",
+		[D2TK_FBDEV_FORMAT_Y8] = "y8",
+		[D2TK_FBDEV_FORMAT_Y1] = "y1"
+	};
+	d2tk_fbdev_format_t format = D2TK_FBDEV_FORMAT_AUTO;
+	d2tk_coord_t w = 0;
+	d2tk_coord_t h = 0;
+	bool stats = false;
 
 	int c;
-	while( (c = getopt(argc, argv, "f:")) != -1)
+	while( (c = getopt(argc, argv, "f:F:g:s")) != -1)
 	{
 		switch(c)
 		{
@@ -161,11 +172,35 @@ main(int argc, char **argv)
 			{
 				strncpy(fb_device, optarg, PATH_MAX-1);
 			} break;
+			case 'F':
+			{
+				for(unsigned i = 0; i < sizeof(formats)/sizeof(*formats); i++)
+				{
+					if(!strcmp(optarg, formats[i]))
+					{
+						format = i;
+					}
+				}
+			} break;
+			case 'g':
+			{
+				if(sscanf(optarg, "%"SCNi32"x%"SCNi32, &w, &h) != 2)
+				{
+					w = h = 0;
+				}
+			} break;
+			case 's':
+			{
+				stats = true;
+			} break;
 
 			default:
 			{
 				fprintf(stderr, "Usage: %s\n"
-					"  -f  fb_device    (auto)\n\n",
+					"  -f  fb_device    (auto)\n"
+					"  -F  format       of file-backed fb_device (xrgb8888, rgb565, y8, y1)\n"
+					"  -g  WxH          geometry of file-backed fb_device\n"
+					"  -s               show performance counters\n\n",
 					argv[0]);
 			} return EXIT_FAILURE;
 		}
@@ -189,7 +224,11 @@ main(int argc, char **argv)
 		.fb_device = fb_device,
 		.bundle_path = "./",
 		.expose = _expose,
-		.data = &app
+		.data = &app,
+		.stats = stats,
+		.format = format,
+		.w = w,
+		.h = h
 	};
 
 	signal(SIGINT, _sig);
@@ -202,10 +241,14 @@ main(int argc, char **argv)
 	app.fbdev = d2tk_fbdev_new(&config);
 	if(app.fbdev)
 	{
+		const bool is_device = (format == D2TK_FBDEV_FORMAT_AUTO);
 		uint32_t num;
 
-		_find_by_format_foreach("/sys/class/vtconsole", "vtcon%"SCNu32, &num,
-			_unbind);
+		if(is_device)
+		{
+			_find_by_format_foreach("/sys/class/vtconsole", "vtcon%"SCNu32, &num,
+				_unbind);
+		}
 
 		d2tk_example_init();
 
@@ -215,8 +258,11 @@ main(int argc, char **argv)
 
 		d2tk_example_deinit();
 
-		_find_by_format_foreach("/sys/class/vtconsole", "vtcon%"SCNu32, &num,
-			_bind);
+		if(is_device)
+		{
+			_find_by_format_foreach("/sys/class/vtconsole", "vtcon%"SCNu32, &num,
+				_bind);
+		}
 
 		return EXIT_SUCCESS;
 	}
@@ -59,8 +59,10 @@ main(int argc __attribute__((unused)), char **argv __attribute__((unused)))
 	d2tk_coord_t w = scale * 1280;
 	d2tk_coord_t h = scale * 720;
 
+	bool stats = false;
+
 	int c;
-	while( (c = getopt(argc, argv, "w:h:")) != -1)
+	while( (c = getopt(argc, argv, "w:h:s")) != -1)
 	{
 		switch(c)
 		{
@@ -72,12 +74,17 @@ main(int argc __attribute__((unused)), char **argv __attribute__((unused)))
 			{
 				h = atoi(optarg);
 			} break;
+			case 's':
+			{
+				stats = true;
+			} break;
 
 			default:
 			{
 				fprintf(stderr, "Usage: %s\n"
 					"  -w  width\n"
-					"  -h  height\n\n",
+					"  -h  height\n"
+					"  -s  show performance counters\n\n",
 					argv[0]);
 			} return EXIT_FAILURE;
 		}
@@ -92,6 +99,7 @@ main(int argc __attribute__((unused)), char **argv __attribute__((unused)))
 		.h = h,
 		.fixed_size = false,
 		.fixed_aspect = false,
+		.stats = stats,
 		.expose = _expose,
 		.data = &app
 	};
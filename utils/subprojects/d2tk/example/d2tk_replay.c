@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <string.h>
+
+#include <d2tk/frontend_offscreen.h>
+#include <d2tk/trace.h>
+
+#define MAX_STATS 64
+
+typedef struct _stat_t stat_t;
+
+struct _stat_t {
+	const char *cat;
+	const char *name;
+	uint64_t count;
+	uint64_t dur;
+};
+
+static stat_t stats [MAX_STATS];
+static unsigned nstats = 0;
+
+static void
+_account(const d2tk_trace_event_t *evt)
+{
+	for(unsigned i = 0; i < nstats; i++)
+	{
+		stat_t *stat = &stats[i];
+
+		if(!strcmp(stat->name, evt->name) && !strcmp(stat->cat, evt->cat))
+		{
+			stat->count++;
+			stat->dur += evt->dur;
+			return;
+		}
+	}
+
+	if(nstats < MAX_STATS)
+	{
+		stat_t *stat = &stats[nstats++];
+
+		stat->cat = evt->cat;
+		stat->name = evt->name;
+		stat->count = 1;
+		stat->dur = evt->dur;
+	}
+}
+
+static int
+_cmp(const void *a, const void *b)
+{
+	const stat_t *sa = a;
+	const stat_t *sb = b;
+
+	return (sa->dur < sb->dur) - (sa->dur > sb->dur);
+}
+
+int
+main(int argc, char **argv)
+{
+	static d2tk_offscreen_config_t config = {
+		.bundle_path = "./",
+		.w = 800,
+		.h = 600
+	};
+	unsigned loops = 1;
+	bool quiet = false;
+
+	int c;
+	while( (c = getopt(argc, argv, "b:g:n:q")) != -1)
+	{
+		switch(c)
+		{
+			case 'b':
+			{
+				config.bundle_path = optarg;
+			} break;
+			case 'g':
+			{
+				if(sscanf(optarg, "%"SCNi32"x%"SCNi32, &config.w, &config.h) != 2)
+				{
+					config.w = 800;
+					config.h = 600;
+				}
+			} break;
+			case 'n':
+			{
+				loops = atoi(optarg);
+			} break;
+			case 'q':
+			{
+				quiet = true;
+			} break;
+
+			default:
+			{
+				fprintf(stderr, "Usage: %s [options] recording\n"
+					"  -b  bundle_path  of fonts and images (./)\n"
+					"  -g  WxH          geometry of offscreen surface (800x600)\n"
+					"  -n  loops        number of times to replay (1)\n"
+					"  -q               quiet, only print summary\n\n",
+					argv[0]);
+			} return EXIT_FAILURE;
+		}
+	}
+
+	if(optind >= argc)
+	{
+		fprintf(stderr, "%s: no recording given\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	FILE *fin = fopen(argv[optind], "rb");
+	if(!fin)
+	{
+		fprintf(stderr, "%s: cannot open '%s'\n", argv[0], argv[optind]);
+		return EXIT_FAILURE;
+	}
+
+	d2tk_offscreen_t *offscreen = d2tk_offscreen_new(&config);
+	if(!offscreen)
+	{
+		fclose(fin);
+		return EXIT_FAILURE;
+	}
+
+	d2tk_base_t *base = d2tk_offscreen_get_base(offscreen);
+	uint64_t frames = 0;
+	uint64_t total = 0;
+	uint64_t worst = 0;
+	bool truncated = false;
+	int ret = EXIT_SUCCESS;
+
+	d2tk_trace_enable(true);
+
+	for(unsigned loop = 0; loop < loops; loop++)
+	{
+		rewind(fin);
+
+		while(true)
+		{
+			d2tk_trace_clear();
+
+			const uint64_t t0 = d2tk_trace_now();
+			const int status = d2tk_base_replay(base, fin);
+			const uint64_t dt = d2tk_trace_now() - t0;
+
+			if(status == 1) // end of recording
+			{
+				break;
+			}
+			else if(status < 0)
+			{
+				fprintf(stderr, "%s: malformed recording at frame %"PRIu64"\n",
+					argv[0], frames);
+				ret = EXIT_FAILURE;
+				loop = loops;
+				break;
+			}
+
+			const d2tk_trace_event_t *events;
+			size_t offset;
+			const size_t nevents = d2tk_trace_get_events(&events, &offset);
+
+			if(nevents == D2TK_TRACE_MAX)
+			{
+				truncated = true; // ring may have wrapped
+			}
+
+			for(size_t i = 0; i < nevents; i++)
+			{
+				_account(&events[(offset + i) & (D2TK_TRACE_MAX - 1)]);
+			}
+
+			unsigned nrects = 0;
+			d2tk_base_get_dirty_rects(base, &nrects);
+
+			if(!quiet)
+			{
+				fprintf(stdout, "frame %6"PRIu64"  %9.3f ms  %3u rects\n",
+					frames, dt / 1e6, nrects);
+			}
+
+			frames++;
+			total += dt;
+			if(dt > worst)
+			{
+				worst = dt;
+			}
+		}
+	}
+
+	d2tk_trace_enable(false);
+
+	if(frames)
+	{
+		fprintf(stdout, "\n%"PRIu64" frames, %.3f ms total, %.3f ms mean, "
+			"%.3f ms worst\n\n", frames, total / 1e6, total / 1e6 / frames,
+			worst / 1e6);
+	}
+
+	qsort(stats, nstats, sizeof(stat_t), _cmp);
+
+	// spans nest, e.g. bbox includes its children and passes include bboxes
+	fprintf(stdout, "%-8s %-16s %10s %12s %10s\n",
+		"cat", "name", "count", "total ms", "mean us");
+	for(unsigned i = 0; i < nstats; i++)
+	{
+		const stat_t *stat = &stats[i];
+
+		fprintf(stdout, "%-8s %-16s %10"PRIu64" %12.3f %10.3f\n",
+			stat->cat, stat->name, stat->count, stat->dur / 1e6,
+			stat->dur / 1e3 / stat->count);
+	}
+
+	if(truncated)
+	{
+		fprintf(stderr, "\nwarning: trace ring overflowed in some frames, "
+			"timings per name are incomplete\n");
+	}
+
+	d2tk_offscreen_free(offscreen);
+	fclose(fin);
+
+	return ret;
+}
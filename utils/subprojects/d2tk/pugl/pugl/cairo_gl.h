@@ -20,10 +20,13 @@
 #include <stdint.h>
 
 #include "pugl/gl.h"
+#include "pugl/pugl.h"
 
 typedef struct {
 	unsigned texture_id;
 	uint8_t* buffer;
+	int      width;
+	int      height;
 } PuglCairoGL;
 
 static cairo_surface_t*
@@ -66,6 +69,27 @@ pugl_cairo_gl_configure(PuglCairoGL* ctx,
 	glGenTextures(1, &ctx->texture_id);
 	glBindTexture(GL_TEXTURE_RECTANGLE_ARB, ctx->texture_id);
 	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
+
+	ctx->width  = 0;
+	ctx->height = 0;
+}
+
+static void
+pugl_cairo_gl_quad(int width, int height)
+{
+	glBegin(GL_QUADS);
+	glTexCoord2f(0.0f, (GLfloat)height);
+	glVertex2f(-1.0f, -1.0f);
+
+	glTexCoord2f((GLfloat)width, (GLfloat)height);
+	glVertex2f(1.0f, -1.0f);
+
+	glTexCoord2f((GLfloat)width, 0.0f);
+	glVertex2f(1.0f, 1.0f);
+
+	glTexCoord2f(0.0f, 0.0f);
+	glVertex2f(-1.0f, 1.0f);
+	glEnd();
 }
 
 static void
@@ -83,21 +107,58 @@ pugl_cairo_gl_draw(PuglCairoGL* ctx, int width, int height)
 	glTexImage2D(GL_TEXTURE_RECTANGLE_ARB, 0, GL_RGBA8,
 	             width, height, 0,
 	             GL_BGRA, GL_UNSIGNED_BYTE, ctx->buffer);
+	ctx->width  = width;
+	ctx->height = height;
 
-	glBegin(GL_QUADS);
-	glTexCoord2f(0.0f, (GLfloat)height);
-	glVertex2f(-1.0f, -1.0f);
+	pugl_cairo_gl_quad(width, height);
 
-	glTexCoord2f((GLfloat)width, (GLfloat)height);
-	glVertex2f(1.0f, -1.0f);
+	glDisable(GL_TEXTURE_2D);
+	glDisable(GL_TEXTURE_RECTANGLE_ARB);
+	glPopMatrix();
+}
 
-	glTexCoord2f((GLfloat)width, 0.0f);
-	glVertex2f(1.0f, 1.0f);
+/**
+   Upload and draw only the damaged rectangles, leaving the rest of the
+   framebuffer untouched.
+*/
+static void
+pugl_cairo_gl_draw_rects(PuglCairoGL* ctx, int width, int height,
+                         const PuglRect* rects, int nrects)
+{
+	if (ctx->width != width || ctx->height != height) {
+		// texture not yet allocated at this size
+		pugl_cairo_gl_draw(ctx, width, height);
+		return;
+	}
 
-	glTexCoord2f(0.0f, 0.0f);
-	glVertex2f(-1.0f, 1.0f);
-	glEnd();
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+	glViewport(0, 0, width, height);
+
+	glPushMatrix();
+	glEnable(GL_TEXTURE_RECTANGLE_ARB);
+	glEnable(GL_TEXTURE_2D);
+	glEnable(GL_SCISSOR_TEST);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+
+	for (int i = 0; i < nrects; ++i) {
+		const PuglRect* r = &rects[i];
+
+		glPixelStorei(GL_UNPACK_SKIP_PIXELS, r->x);
+		glPixelStorei(GL_UNPACK_SKIP_ROWS, r->y);
+		glTexSubImage2D(GL_TEXTURE_RECTANGLE_ARB, 0,
+		                r->x, r->y, r->width, r->height,
+		                GL_BGRA, GL_UNSIGNED_BYTE, ctx->buffer);
+
+		// GL window coordinates have their origin at the bottom left
+		glScissor(r->x, height - r->y - r->height, r->width, r->height);
+		pugl_cairo_gl_quad(width, height);
+	}
 
+	glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+	glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glDisable(GL_SCISSOR_TEST);
 	glDisable(GL_TEXTURE_2D);
 	glDisable(GL_TEXTURE_RECTANGLE_ARB);
 	glPopMatrix();
@@ -175,6 +175,21 @@ typedef enum {
 	PUGL_CROSSING_UNGRAB       /**< Crossing due to a grab release. */
 } PuglCrossingMode;
 
+/**
+   Maximum number of damaged rectangles per redisplay.
+*/
+#define PUGL_MAX_DAMAGE 64
+
+/**
+   Rectangle in view coordinates, with the origin at the top left.
+*/
+typedef struct {
+	int x;
+	int y;
+	int width;
+	int height;
+} PuglRect;
+
 /**
    Common header for all event structs.
 */
@@ -507,6 +522,18 @@ puglGetVisible(PuglView* view);
 PUGL_API void
 puglGetSize(PuglView* view, int* width, int* height);
 
+/**
+   Set the damaged regions of the current expose.
+
+   When the platform supports partial presentation and the view has neither
+   been exposed externally nor resized, only these rectangles are presented,
+   otherwise the whole view.  An empty list presents nothing, a negative
+   count or more than PUGL_MAX_DAMAGE rectangles present the whole view.
+   The damage is reset after each expose.
+*/
+PUGL_API void
+puglSetDamage(PuglView* view, const PuglRect* rects, int nrects);
+
 /**
    @name Context
    Functions for accessing the drawing context.
@@ -59,6 +59,9 @@ struct PuglViewImpl {
 	bool     redisplay;
 	bool     resizable;
 	bool     visible;
+
+	PuglRect damage[PUGL_MAX_DAMAGE];
+	int      ndamage;
 };
 
 PuglInternals* puglInitInternals(void);
@@ -80,6 +83,7 @@ puglInit(int* pargc __attribute__((unused)), char** argv __attribute__((unused))
 	view->impl     = impl;
 	view->width    = 640;
 	view->height   = 480;
+	view->ndamage  = -1;
 
 	return view;
 }
@@ -170,6 +174,35 @@ puglGetSize(PuglView* view, int* width, int* height)
 	*height = view->height;
 }
 
+void
+puglSetDamage(PuglView* view, const PuglRect* rects, int nrects)
+{
+	if (nrects < 0 || nrects > PUGL_MAX_DAMAGE) {
+		view->ndamage = -1;
+		return;
+	}
+
+	view->ndamage = 0;
+	for (int i = 0; i < nrects; ++i) {
+		// clip to view
+		const int x0 = rects[i].x > 0 ? rects[i].x : 0;
+		const int y0 = rects[i].y > 0 ? rects[i].y : 0;
+		int       x1 = rects[i].x + rects[i].width;
+		int       y1 = rects[i].y + rects[i].height;
+
+		x1 = x1 < view->width ? x1 : view->width;
+		y1 = y1 < view->height ? y1 : view->height;
+
+		if (x1 > x0 && y1 > y0) {
+			PuglRect* dst = &view->damage[view->ndamage++];
+			dst->x      = x0;
+			dst->y      = y0;
+			dst->width  = x1 - x0;
+			dst->height = y1 - y0;
+		}
+	}
+}
+
 void
 puglIgnoreKeyRepeat(PuglView* view, bool ignore)
 {
@@ -84,6 +84,10 @@ static int attrListSgl[] = {
 /** Null-terminated list of attributes in order of preference. */
 static int* attrLists[] = { attrListDbl, attrListSgl, NULL };
 
+/** GLX_MESA_copy_sub_buffer, presents part of the back buffer. */
+typedef void (*PuglCopySubBufferFunc)(Display*, GLXDrawable,
+                                      int, int, int, int);
+
 #endif  // PUGL_HAVE_GL
 
 struct PuglInternalsImpl {
@@ -99,12 +103,14 @@ struct PuglInternalsImpl {
 #ifdef PUGL_HAVE_GL
 	GLXContext       ctx;
 	int              doubleBuffered;
+	PuglCopySubBufferFunc copySubBuffer;
 #endif
 #if defined(PUGL_HAVE_CAIRO) && defined(PUGL_HAVE_GL)
 	PuglCairoGL      cairo_gl;
 #endif
 	Atom             clipboard;
 	Atom             utf8_string;
+	bool             exposed;
 };
 
 PuglInternals*
@@ -162,6 +168,12 @@ createContext(PuglView* view, XVisualInfo* vi)
 	if (view->ctx_type & PUGL_GL) {
 		impl->ctx = glXCreateContext(impl->display, vi, 0, GL_TRUE);
 		glXGetConfig(impl->display, vi, GLX_DOUBLEBUFFER, &impl->doubleBuffered);
+
+		const char* exts = glXQueryExtensionsString(impl->display, impl->screen);
+		if (exts && strstr(exts, "GLX_MESA_copy_sub_buffer")) {
+			impl->copySubBuffer = (PuglCopySubBufferFunc)glXGetProcAddressARB(
+				(const GLubyte*)"glXCopySubBufferMESA");
+		}
 	}
 #endif
 #ifdef PUGL_HAVE_CAIRO
@@ -230,20 +242,45 @@ void
 puglLeaveContext(PuglView* view, bool flush)
 {
 #ifdef PUGL_HAVE_GL
+	PuglInternals* const impl = view->impl;
+
 	if (flush && view->ctx_type & PUGL_GL) {
+		/* Partial presentation needs a back buffer which survives presentation,
+		   as the areas outside the damage have not been redrawn. */
+		const bool partial = (view->ndamage >= 0) && !impl->exposed
+			&& (!impl->doubleBuffered || impl->copySubBuffer);
+
 #ifdef PUGL_HAVE_CAIRO
 		if (view->ctx_type == PUGL_CAIRO_GL) {
-			pugl_cairo_gl_draw(&view->impl->cairo_gl, view->width, view->height);
+			if (partial) {
+				pugl_cairo_gl_draw_rects(&impl->cairo_gl, view->width, view->height,
+				                         view->damage, view->ndamage);
+			} else {
+				pugl_cairo_gl_draw(&impl->cairo_gl, view->width, view->height);
+			}
 		}
 #endif
 
 		glFlush();
-		if (view->impl->doubleBuffered) {
-			glXSwapBuffers(view->impl->display, view->impl->win);
+		if (impl->doubleBuffered) {
+			if (partial) {
+				for (int i = 0; i < view->ndamage; ++i) {
+					const PuglRect* r = &view->damage[i];
+
+					impl->copySubBuffer(impl->display, impl->win,
+					                    r->x, view->height - r->y - r->height,
+					                    r->width, r->height);
+				}
+			} else {
+				glXSwapBuffers(impl->display, impl->win);
+			}
 		}
+
+		view->ndamage = -1;
+		impl->exposed = false;
 	}
 
-	glXMakeCurrent(view->impl->display, None, NULL);
+	glXMakeCurrent(impl->display, None, NULL);
 #endif
 }
 
@@ -730,6 +767,8 @@ puglProcessEvents(PuglView* view)
 		if (event.type == PUGL_EXPOSE) {
 			// Expand expose event to be dispatched after loop
 			merge_draw_events(&expose_event, &event);
+			// Window contents were lost, present the whole view
+			view->impl->exposed = true;
 		} else if (event.type == PUGL_CONFIGURE) {
 			// Expand configure event to be dispatched after loop
 			merge_draw_events(&config_event, &event);
@@ -766,6 +805,7 @@ puglProcessEvents(PuglView* view)
 		}
 #endif
 #endif
+		view->impl->exposed = true;
 		puglDispatchEvent(view, (const PuglEvent*)&config_event);
 	}
 
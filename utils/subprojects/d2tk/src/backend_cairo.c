@@ -36,27 +36,228 @@
 #include "core_internal.h"
 #include <d2tk/backend.h>
 #include <d2tk/hash.h>
+#include <d2tk/trace.h>
+
+#define _D2TK_CAIRO_POOL_CLASS	32 // size class granularity in pixels
+#define _D2TK_CAIRO_POOL_TTL		0x40 // frames a released surface is kept
 
 typedef enum _sprite_type_t {
 	SPRITE_TYPE_NONE = 0,
 	SPRITE_TYPE_SURF = 1,
-	SPRITE_TYPE_FONT = 2
+	SPRITE_TYPE_FONT = 2,
+	SPRITE_TYPE_POOL = 3,
+	SPRITE_TYPE_LAYOUT = 4
 } sprite_type_t;
 
+typedef struct _d2tk_cairo_layout_t d2tk_cairo_layout_t;
+typedef struct _d2tk_cairo_layout_key_t d2tk_cairo_layout_key_t;
+typedef struct _d2tk_cairo_surf_t d2tk_cairo_surf_t;
+typedef struct _d2tk_cairo_pool_t d2tk_cairo_pool_t;
 typedef struct _d2tk_backend_cairo_t d2tk_backend_cairo_t;
 
+// shaped text, glyphs are positioned relative to the origin
+struct _d2tk_cairo_layout_t {
+	cairo_text_extents_t extents;
+	int nglyphs;
+	cairo_glyph_t glyphs [];
+};
+
+// what, besides the string, shaping depends on
+struct _d2tk_cairo_layout_key_t {
+	uint64_t face; // hash of font face path
+	double font [4]; // linear part of font matrix
+	double ctm [4]; // linear part of user-to-device matrix
+};
+
+// tags font faces with the hash of their path
+static const cairo_user_data_key_t _d2tk_cairo_face_key;
+
+// rendered-to surface with its context, buffer is sized to its size class
+struct _d2tk_cairo_surf_t {
+	d2tk_cairo_surf_t *next;
+	cairo_format_t format;
+	d2tk_coord_t cw; // size class
+	d2tk_coord_t ch;
+	size_t bufsz;
+	uint8_t *buf;
+	cairo_surface_t *surf;
+	cairo_t *ctx;
+	uint64_t frame; // released to pool in
+};
+
+// released surfaces, most recently released first, they only live in what
+// sprites leave of the sprite budget
+struct _d2tk_cairo_pool_t {
+	d2tk_cairo_surf_t *head;
+	size_t bytes;
+	uint64_t frame;
+};
+
 struct _d2tk_backend_cairo_t {
 	cairo_t *ctx;
 	char *bundle_path;
 	FT_Library library;
 	cairo_pattern_t *pat;
+	d2tk_cairo_pool_t *pool; // shared with nested backends
 };
 
+static inline d2tk_coord_t
+_d2tk_cairo_pool_class(d2tk_coord_t len)
+{
+	return (len + _D2TK_CAIRO_POOL_CLASS - 1)
+		/ _D2TK_CAIRO_POOL_CLASS * _D2TK_CAIRO_POOL_CLASS;
+}
+
+static void
+_d2tk_cairo_surf_free(d2tk_cairo_surf_t *csurf)
+{
+	if(csurf->ctx)
+	{
+		cairo_destroy(csurf->ctx);
+	}
+
+	if(csurf->surf)
+	{
+		cairo_surface_finish(csurf->surf);
+		cairo_surface_destroy(csurf->surf);
+	}
+
+	free(csurf->buf);
+	free(csurf);
+}
+
+// get a cleared surface of given size, preferably recycled
+static d2tk_cairo_surf_t *
+_d2tk_cairo_surf_acquire(d2tk_cairo_pool_t *pool, cairo_format_t format,
+	d2tk_coord_t w, d2tk_coord_t h)
+{
+	const d2tk_coord_t cw = _d2tk_cairo_pool_class(w);
+	const d2tk_coord_t ch = _d2tk_cairo_pool_class(h);
+	const int stride = cairo_format_stride_for_width(format, cw);
+	d2tk_cairo_surf_t **match = NULL;
+
+	for(d2tk_cairo_surf_t **prev = &pool->head; *prev; prev = &(*prev)->next)
+	{
+		d2tk_cairo_surf_t *cur = *prev;
+
+		if( (cur->format != format) || (cur->cw != cw) || (cur->ch != ch) )
+		{
+			continue;
+		}
+
+		match = prev;
+
+		// prefer one with a matching surface and context
+		if( (cairo_image_surface_get_width(cur->surf) == w)
+			&& (cairo_image_surface_get_height(cur->surf) == h) )
+		{
+			break;
+		}
+	}
+
+	d2tk_cairo_surf_t *csurf;
+
+	if(match)
+	{
+		csurf = *match;
+		*match = csurf->next;
+		pool->bytes -= csurf->bufsz;
+	}
+	else
+	{
+		csurf = calloc(1, sizeof(d2tk_cairo_surf_t));
+		if(!csurf)
+		{
+			return NULL;
+		}
+
+		csurf->format = format;
+		csurf->cw = cw;
+		csurf->ch = ch;
+		csurf->bufsz = (size_t)stride * ch;
+		csurf->buf = malloc(csurf->bufsz);
+		if(!csurf->buf)
+		{
+			free(csurf);
+			return NULL;
+		}
+	}
+
+	csurf->next = NULL;
+
+	if(!csurf->surf
+		|| (cairo_image_surface_get_width(csurf->surf) != w)
+		|| (cairo_image_surface_get_height(csurf->surf) != h) )
+	{
+		if(csurf->ctx)
+		{
+			cairo_destroy(csurf->ctx);
+		}
+
+		if(csurf->surf)
+		{
+			cairo_surface_finish(csurf->surf);
+			cairo_surface_destroy(csurf->surf);
+		}
+
+		csurf->surf = cairo_image_surface_create_for_data(csurf->buf, format,
+			w, h, stride);
+		csurf->ctx = cairo_create(csurf->surf);
+	}
+
+	// only clear what the surface covers of the buffer
+	const size_t len = cairo_format_stride_for_width(format, w);
+
+	cairo_surface_flush(csurf->surf);
+	for(d2tk_coord_t y = 0; y < h; y++)
+	{
+		memset(&csurf->buf[y*stride], 0x0, len);
+	}
+	cairo_surface_mark_dirty(csurf->surf);
+
+	return csurf;
+}
+
+static inline void
+_d2tk_cairo_surf_release(d2tk_cairo_pool_t *pool, d2tk_cairo_surf_t *csurf)
+{
+	csurf->frame = pool->frame;
+	csurf->next = pool->head;
+	pool->head = csurf;
+	pool->bytes += csurf->bufsz;
+}
+
+// drop surfaces released long ago or not fitting into the sprite budget
+static void
+_d2tk_cairo_pool_trim(d2tk_cairo_pool_t *pool, size_t avail)
+{
+	size_t bytes = 0;
+
+	for(d2tk_cairo_surf_t **prev = &pool->head; *prev; )
+	{
+		d2tk_cairo_surf_t *cur = *prev;
+
+		if( (pool->frame - cur->frame > _D2TK_CAIRO_POOL_TTL)
+			|| (bytes + cur->bufsz > avail) )
+		{
+			*prev = cur->next;
+			pool->bytes -= cur->bufsz;
+			_d2tk_cairo_surf_free(cur);
+			continue;
+		}
+
+		bytes += cur->bufsz;
+		prev = &cur->next;
+	}
+}
+
 static void
 d2tk_cairo_free(void *data)
 {
 	d2tk_backend_cairo_t *backend = data;
 
+	_d2tk_cairo_pool_trim(backend->pool, 0);
+	free(backend->pool);
 	FT_Done_FreeType(backend->library);
 	free(backend->bundle_path);
 	free(backend);
@@ -78,6 +279,14 @@ d2tk_cairo_new(const char *bundle_path, void *pctx)
 		return NULL;
 	}
 
+	backend->pool = calloc(1, sizeof(d2tk_cairo_pool_t));
+	if(!backend->pool)
+	{
+		fprintf(stderr, "calloc failed\n");
+		free(backend);
+		return NULL;
+	}
+
 	backend->ctx = pctx;
 	backend->bundle_path = strdup(bundle_path);
 	FT_Init_FreeType(&backend->library);
@@ -86,36 +295,46 @@ d2tk_cairo_new(const char *bundle_path, void *pctx)
 }
 
 static inline void
-d2tk_cairo_pre(void *data, d2tk_core_t *core __attribute((unused)),
-	d2tk_coord_t w, d2tk_coord_t h, unsigned pass)
+d2tk_cairo_pre(void *data, d2tk_core_t *core,
+	d2tk_coord_t w __attribute__((unused)), d2tk_coord_t h __attribute__((unused)),
+	unsigned pass)
 {
 	d2tk_backend_cairo_t *backend = data;
 	cairo_t *ctx = backend->ctx;
 
 	if(pass == 0) // is this 1st pass ?
 	{
+		d2tk_cairo_pool_t *pool = backend->pool;
+		size_t used;
+		const size_t budget = d2tk_core_get_sprite_budget(core, &used);
+
+		pool->frame++;
+		_d2tk_cairo_pool_trim(pool, used < budget ? budget - used : 0);
+
 		return;
 	}
 
 	cairo_save(ctx);
 
 	{
-		d2tk_rect_t rect;
-		uint32_t *pixels = d2tk_core_get_pixels(core, &rect);
-
-		cairo_surface_t *surf = cairo_image_surface_create_for_data(
-			(uint8_t *)pixels, CAIRO_FORMAT_ARGB32, w, h, w*sizeof(uint32_t));
-		//FIXME reuse/update surfaces
+		// clear dirty areas to background
+		unsigned nrects;
+		const d2tk_rect_t *rects = d2tk_core_get_dirty_rects(core, &nrects);
+		const uint32_t rgba = d2tk_core_get_bg_color(core);
 
-		cairo_rectangle(ctx, rect.x, rect.y, rect.w, rect.h);
+		cairo_new_path(ctx);
+		for(unsigned i = 0; i < nrects; i++)
+		{
+			cairo_rectangle(ctx, rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+		}
 		cairo_clip(ctx);
 
-		cairo_new_sub_path(ctx);
-		cairo_set_source_surface(ctx, surf, 0, 0);
+		cairo_set_source_rgba(ctx,
+			( (rgba >> 24) & 0xff) / 255.f,
+			( (rgba >> 16) & 0xff) / 255.f,
+			( (rgba >>  8) & 0xff) / 255.f,
+			( (rgba >>  0) & 0xff) / 255.f);
 		cairo_paint(ctx);
-
-		cairo_surface_finish(surf);
-		cairo_surface_destroy(surf);
 	}
 }
 
@@ -134,34 +353,17 @@ d2tk_cairo_post(void *data, d2tk_core_t *core __attribute__((unused)),
 
 #ifdef D2TK_DEBUG //FIXME needs multiple buffers to work
 	{
-		d2tk_rect_t rect;
-		uint32_t *pixels = d2tk_core_get_pixels(core, &rect);
+		unsigned nrects;
+		const d2tk_rect_t *rects = d2tk_core_get_dirty_rects(core, &nrects);
 
-		// brighten up the pixels for proper hilighting
-		for(d2tk_coord_t y = 0, Y = 0; y < h; y++, Y+=w)
+		// brighten up the dirty areas for proper hilighting
+		cairo_new_path(ctx);
+		for(unsigned i = 0; i < nrects; i++)
 		{
-			for(d2tk_coord_t x = 0; x < w; x++)
-			{
-				if(pixels[Y + x])
-				{
-					pixels[Y + x] = 0x5f005f5f; // premultiplied ARGB
-				}
-			}
+			cairo_rectangle(ctx, rects[i].x, rects[i].y, rects[i].w, rects[i].h);
 		}
-
-		cairo_surface_t *surf = cairo_image_surface_create_for_data(
-			(uint8_t *)pixels, CAIRO_FORMAT_ARGB32, w, h, w*sizeof(uint32_t));
-		//FIXME reuse/update suface
-
-		cairo_rectangle(ctx, 0, 0, w, h);
-		cairo_clip(ctx);
-
-		cairo_new_sub_path(ctx);
-		cairo_set_source_surface(ctx, surf, 0, 0);
-		cairo_paint(ctx);
-
-		cairo_surface_finish(surf);
-		cairo_surface_destroy(surf);
+		cairo_set_source_rgba(ctx, 0.f, 1.f, 1.f, 0.37f);
+		cairo_fill(ctx);
 	}
 #endif
 
@@ -203,11 +405,18 @@ _d2tk_cairo_font_face_destroy(cairo_font_face_t *face)
 }
 
 static inline void
-d2tk_cairo_sprite_free(void *data __attribute__((unused)),
-	uint8_t type, uintptr_t body)
+d2tk_cairo_sprite_free(void *data, uint8_t type, uintptr_t body)
 {
+	d2tk_backend_cairo_t *backend = data;
+
 	switch((sprite_type_t)type)
 	{
+		case SPRITE_TYPE_POOL:
+		{
+			d2tk_cairo_surf_t *csurf = (d2tk_cairo_surf_t *)body;
+
+			_d2tk_cairo_surf_release(backend->pool, csurf);
+		} break;
 		case SPRITE_TYPE_SURF:
 		{
 			cairo_surface_t *surf = (cairo_surface_t *)body;
@@ -221,6 +430,12 @@ d2tk_cairo_sprite_free(void *data __attribute__((unused)),
 
 			_d2tk_cairo_font_face_destroy(face);
 		} break;
+		case SPRITE_TYPE_LAYOUT:
+		{
+			d2tk_cairo_layout_t *layout = (d2tk_cairo_layout_t *)body;
+
+			free(layout);
+		} break;
 		case SPRITE_TYPE_NONE:
 		{
 			// nothing to do
@@ -236,6 +451,71 @@ _d2tk_cairo_free_font_face(void *data)
 	FT_Done_Face(face);
 }
 
+// shape and measure text with current font or reuse it from earlier frames
+static const d2tk_cairo_layout_t *
+_d2tk_cairo_layout_get(d2tk_core_t *core, cairo_t *ctx, const char *text)
+{
+	d2tk_cairo_layout_key_t key;
+	cairo_matrix_t mat;
+
+	memset(&key, 0x0, sizeof(key)); // no padding in hash
+	key.face = (uintptr_t)cairo_font_face_get_user_data(cairo_get_font_face(ctx),
+		&_d2tk_cairo_face_key);
+
+	cairo_get_font_matrix(ctx, &mat);
+	key.font[0] = mat.xx;
+	key.font[1] = mat.yx;
+	key.font[2] = mat.xy;
+	key.font[3] = mat.yy;
+
+	cairo_get_matrix(ctx, &mat);
+	key.ctm[0] = mat.xx;
+	key.ctm[1] = mat.yx;
+	key.ctm[2] = mat.xy;
+	key.ctm[3] = mat.yy;
+
+	const uint64_t hash = d2tk_hash_foreach(&key, sizeof(key),
+		text, strlen(text),
+		NULL);
+	uintptr_t *sprite = d2tk_core_get_layout(core, hash, SPRITE_TYPE_LAYOUT);
+	if(!sprite)
+	{
+		return NULL;
+	}
+
+	if(!*sprite)
+	{
+		cairo_scaled_font_t *font = cairo_get_scaled_font(ctx);
+		cairo_glyph_t *glyphs = NULL;
+		int nglyphs = 0;
+
+		if(cairo_scaled_font_text_to_glyphs(font, 0.0, 0.0, text, -1,
+			&glyphs, &nglyphs, NULL, NULL, NULL) != CAIRO_STATUS_SUCCESS)
+		{
+			nglyphs = 0;
+		}
+
+		const size_t sz = sizeof(d2tk_cairo_layout_t)
+			+ nglyphs*sizeof(cairo_glyph_t);
+		d2tk_cairo_layout_t *layout = calloc(1, sz);
+
+		if(layout)
+		{
+			layout->nglyphs = nglyphs;
+			memcpy(layout->glyphs, glyphs, nglyphs*sizeof(cairo_glyph_t));
+			cairo_scaled_font_glyph_extents(font, layout->glyphs, nglyphs,
+				&layout->extents);
+
+			*sprite = (uintptr_t)layout;
+			d2tk_core_set_layout_size(core, sprite, sz);
+		}
+
+		cairo_glyph_free(glyphs);
+	}
+
+	return (const d2tk_cairo_layout_t *)*sprite;
+}
+
 static inline void
 _d2tk_cairo_surf_draw(cairo_t *ctx, cairo_surface_t *surf, d2tk_coord_t xo,
 	d2tk_coord_t yo, d2tk_align_t align, const d2tk_rect_t *rect)
@@ -315,6 +595,7 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 	d2tk_backend_cairo_t *backend = data;
 	cairo_t *ctx = backend->ctx;
 
+	const uint64_t t_instr = d2tk_trace_begin();
 	const d2tk_instr_t instr = com->instr;
 	switch(instr)
 	{
@@ -465,7 +746,7 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 			{
 				if(body->cached)
 				{
-					uintptr_t *sprite = d2tk_core_get_sprite(core, body->hash, SPRITE_TYPE_SURF);
+					uintptr_t *sprite = d2tk_core_get_sprite(core, body->hash, SPRITE_TYPE_POOL);
 					assert(sprite);
 
 					if(!*sprite)
@@ -473,29 +754,26 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 #ifdef D2TK_DEBUG
 						//fprintf(stderr, "\tcreating sprite\n");
 #endif
-						const size_t stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32,
-							body->clip.w);
-						const size_t bufsz = stride * body->clip.h;
-						void *buf = calloc(1, bufsz);
-						cairo_surface_t *surf = cairo_image_surface_create_for_data(buf,
-							CAIRO_FORMAT_ARGB32, body->clip.w, body->clip.h, stride);
-						assert(surf);
-
-						const cairo_user_data_key_t key = { 0 };
-						cairo_surface_set_user_data(surf, &key, buf, _d2tk_cairo_buf_free);
+						d2tk_cairo_surf_t *csurf = _d2tk_cairo_surf_acquire(backend->pool,
+							CAIRO_FORMAT_ARGB32, body->clip.w, body->clip.h);
+						assert(csurf);
 
 						d2tk_backend_cairo_t backend2 = *backend;
-						backend2.ctx = cairo_create(surf);
+						backend2.ctx = csurf->ctx;
 
+						// pooled contexts must come back in pristine state
+						cairo_save(backend2.ctx);
 						D2TK_COM_FOREACH_CONST(com, bbox)
 						{
 							d2tk_cairo_process(&backend2, core, bbox, 0, 0, clip, pass);
 						}
+						cairo_restore(backend2.ctx);
+						cairo_new_path(backend2.ctx);
 
-						cairo_surface_flush(surf);
-						cairo_destroy(backend2.ctx);
+						cairo_surface_flush(csurf->surf);
 
-						*sprite = (uintptr_t)surf;
+						*sprite = (uintptr_t)csurf;
+						d2tk_core_set_sprite_size(core, sprite, csurf->bufsz);
 					}
 					else
 					{
@@ -524,10 +802,10 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 
 				if(body->cached)
 				{
-					uintptr_t *sprite = d2tk_core_get_sprite(core, body->hash, SPRITE_TYPE_SURF);
+					uintptr_t *sprite = d2tk_core_get_sprite(core, body->hash, SPRITE_TYPE_POOL);
 					assert(sprite && *sprite);
 
-					cairo_surface_t *surf = (cairo_surface_t *)*sprite;
+					cairo_surface_t *surf = ((d2tk_cairo_surf_t *)*sprite)->surf;
 					assert(surf);
 
 					// paint pre-rendered sprite
@@ -588,6 +866,8 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 				cairo_font_face_t *face = cairo_ft_font_face_create_for_ft_face(ft_face, 0);
 				const cairo_user_data_key_t key = { 0 };
 				cairo_font_face_set_user_data(face, &key, ft_face, _d2tk_cairo_free_font_face);
+				cairo_font_face_set_user_data(face, &_d2tk_cairo_face_key,
+					(void *)(uintptr_t)hash, NULL);
 
 				*sprite = (uintptr_t)face;
 			}
@@ -607,8 +887,11 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 		{
 			const d2tk_body_text_t *body = &com->body->text;
 
-			cairo_text_extents_t extents;
-			cairo_text_extents(ctx, body->text, &extents);
+			const d2tk_cairo_layout_t *layout = _d2tk_cairo_layout_get(core, ctx,
+				body->text);
+			assert(layout);
+
+			const cairo_text_extents_t extents = layout->extents;
 			int32_t x = -extents.x_bearing;
 			int32_t y = -extents.y_bearing;
 
@@ -642,8 +925,10 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 				y -= extents.height;
 			}
 
-			cairo_move_to(ctx, x + xo, y + yo);
-			cairo_show_text(ctx, body->text);
+			cairo_save(ctx);
+			cairo_translate(ctx, x + xo, y + yo);
+			cairo_show_glyphs(ctx, layout->glyphs, layout->nglyphs);
+			cairo_restore(ctx);
 		} break;
 		case D2TK_INSTR_IMAGE:
 		{
@@ -682,6 +967,7 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 				cairo_surface_set_user_data(surf, &key, pixels, _d2tk_cairo_img_free);
 
 				*sprite = (uintptr_t)surf;
+				d2tk_core_set_sprite_size(core, sprite, W*H*sizeof(uint32_t));
 			}
 
 			cairo_surface_t *surf = (cairo_surface_t *)*sprite;
@@ -717,34 +1003,28 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 		{
 			const d2tk_body_custom_t *body = &com->body->custom;
 
-			const uint64_t hash = d2tk_hash(body->data, body->size);
-			uintptr_t *sprite = d2tk_core_get_sprite(core, hash, SPRITE_TYPE_SURF);
+			const uint64_t hash = body->hash;
+			uintptr_t *sprite = d2tk_core_get_sprite(core, hash, SPRITE_TYPE_POOL);
 			assert(sprite);
 
 			if(!*sprite)
 			{
-				const size_t stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32,
-					body->w);
-				const size_t bufsz = stride * body->h;
-				void *buf = calloc(1, bufsz);
-				cairo_surface_t *surf = cairo_image_surface_create_for_data(buf,
-					CAIRO_FORMAT_ARGB32, body->w, body->h, stride);
-				assert(surf);
-
-				const cairo_user_data_key_t key = { 0 };
-				cairo_surface_set_user_data(surf, &key, buf, _d2tk_cairo_buf_free);
+				d2tk_cairo_surf_t *csurf = _d2tk_cairo_surf_acquire(backend->pool,
+					CAIRO_FORMAT_ARGB32, body->w, body->h);
+				assert(csurf);
 
-				cairo_t *ctx2 = cairo_create(surf);
+				cairo_save(csurf->ctx);
+				body->custom(csurf->ctx, body->size, body->data);
+				cairo_restore(csurf->ctx);
+				cairo_new_path(csurf->ctx);
 
-				body->custom(ctx2, body->size, body->data);
+				cairo_surface_flush(csurf->surf);
 
-				cairo_surface_flush(surf);
-				cairo_destroy(ctx2);
-
-				*sprite = (uintptr_t)surf;
+				*sprite = (uintptr_t)csurf;
+				d2tk_core_set_sprite_size(core, sprite, csurf->bufsz);
 			}
 
-			cairo_surface_t *surf = (cairo_surface_t *)*sprite;
+			cairo_surface_t *surf = ((d2tk_cairo_surf_t *)*sprite)->surf;
 			assert(surf);
 
 			_d2tk_cairo_surf_draw(ctx, surf, xo, yo, D2TK_ALIGN_LEFT | D2TK_ALIGN_TOP,
@@ -761,6 +1041,9 @@ d2tk_cairo_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 			fprintf(stderr, "%s: unknown command (%i)\n", __func__, com->instr);
 		} break;
 	}
+
+	// bbox spans include their children
+	d2tk_trace_end("cairo", d2tk_instr_name(instr), t_instr);
 }
 
 const d2tk_core_driver_t d2tk_core_driver = {
@@ -0,0 +1,1812 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+#include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmisleading-indentation"
+#pragma GCC diagnostic ignored "-Wimplicit-fallthrough="
+#pragma GCC diagnostic ignored "-Wshift-negative-value"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#pragma GCC diagnostic pop
+
+#include "core_internal.h"
+#include <d2tk/backend.h>
+#include <d2tk/backend_mono.h>
+#include <d2tk/hash.h>
+#include <d2tk/trace.h>
+
+#define _D2TK_MONO_STACK 16 // depth of save/restore
+#define _D2TK_MONO_TOL 0.25f // max distance of flattened curves in pixels
+
+typedef enum _sprite_type_t {
+	SPRITE_TYPE_NONE = 0,
+	SPRITE_TYPE_SURF = 1
+} sprite_type_t;
+
+typedef uint32_t __attribute__((may_alias)) d2tk_mono_word_t;
+
+typedef struct _d2tk_mono_glyph_t d2tk_mono_glyph_t;
+typedef struct _d2tk_mono_sprite_t d2tk_mono_sprite_t;
+typedef struct _d2tk_mono_rect_t d2tk_mono_rect_t;
+typedef struct _d2tk_mono_state_t d2tk_mono_state_t;
+typedef struct _d2tk_mono_sub_t d2tk_mono_sub_t;
+typedef struct _d2tk_mono_edge_t d2tk_mono_edge_t;
+typedef struct _d2tk_mono_cross_t d2tk_mono_cross_t;
+typedef struct _d2tk_mono_scratch_t d2tk_mono_scratch_t;
+typedef struct _d2tk_backend_mono_t d2tk_backend_mono_t;
+
+// bitmap of glyph in atlas, rows are padded to bytes
+struct _d2tk_mono_glyph_t {
+	uint16_t offset;
+	uint8_t w;
+	uint8_t h;
+	int8_t xoff; // from pen
+	int8_t yoff;
+	uint16_t advance; // in 1/64 pixels
+};
+
+#include "font_mono.h"
+
+// pre-rendered pixels with their coverage, mask has 1 bpp
+struct _d2tk_mono_sprite_t {
+	d2tk_mono_surf_t surf;
+	uint32_t mstride;
+	uint8_t *mask;
+	size_t size;
+	uint32_t data [];
+};
+
+struct _d2tk_mono_rect_t {
+	d2tk_coord_t x0;
+	d2tk_coord_t y0;
+	d2tk_coord_t x1;
+	d2tk_coord_t y1;
+};
+
+struct _d2tk_mono_state_t {
+	uint16_t shade; // level in 1/16, dithered in between
+	uint8_t alpha; // in 1/16, screen-door transparency
+	float width;
+	float size;
+	float cs; // of rotation
+	float sn;
+	float deg;
+	d2tk_mono_rect_t clip;
+};
+
+struct _d2tk_mono_sub_t {
+	uint32_t first;
+	uint32_t npts;
+	bool closed;
+};
+
+// y0 < y1, dir tells about original orientation
+struct _d2tk_mono_edge_t {
+	float x0;
+	float y0;
+	float y1;
+	float dxdy;
+	int dir;
+};
+
+struct _d2tk_mono_cross_t {
+	float x;
+	int dir;
+};
+
+// current path and rasterizer buffers, in device coordinates
+struct _d2tk_mono_scratch_t {
+	float *pts;
+	uint32_t npts;
+	uint32_t maxpts;
+	d2tk_mono_sub_t *subs;
+	uint32_t nsubs;
+	uint32_t maxsubs;
+	bool current; // has current point
+	d2tk_mono_edge_t *edges;
+	uint32_t nedges;
+	uint32_t maxedges;
+	d2tk_mono_cross_t *crosses;
+	uint32_t maxcrosses;
+};
+
+struct _d2tk_backend_mono_t {
+	d2tk_mono_surf_t *surf;
+	uint8_t *mask; // only when rendering to sprite
+	uint32_t mstride;
+	bool offscreen;
+	d2tk_mono_rect_t clip; // what scissors are reset to
+	unsigned top;
+	unsigned lost; // saves beyond stack depth
+	d2tk_mono_state_t state [_D2TK_MONO_STACK];
+	d2tk_mono_scratch_t *scratch; // shared with nested backends
+};
+
+// ordered dither threshold matrix
+static const uint8_t _d2tk_mono_bayer [4][4] = {
+	{  0,  8,  2, 10 },
+	{ 12,  4, 14,  6 },
+	{  3, 11,  1,  9 },
+	{ 15,  7, 13,  5 }
+};
+
+// convert logical msb-first word to and from memory order
+static inline uint32_t
+_d2tk_mono_be32(uint32_t v)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	return __builtin_bswap32(v);
+#else
+	return v;
+#endif
+}
+
+static inline uint8_t
+_d2tk_mono_max(uint8_t bpp)
+{
+	return (1 << bpp) - 1;
+}
+
+// word of pixels of a row, the dither pattern repeats every 4 pixels, so it
+// is the same for each byte and thus for each word independent of endianness
+static inline uint32_t
+_d2tk_mono_pattern(uint8_t bpp, uint16_t shade, d2tk_coord_t y)
+{
+	const uint8_t *bayer = _d2tk_mono_bayer[y & 3];
+	const uint8_t base = shade >> 4;
+	const uint8_t frac = shade & 0xf;
+	uint32_t bits = 0;
+
+	for(unsigned x = 0; x < 4; x++)
+	{
+		bits = (bits << bpp) | (base + (bayer[x] < frac));
+	}
+
+	if(bpp == 1)
+	{
+		bits |= bits << 4;
+	}
+
+	return bits * 0x01010101;
+}
+
+// word of pixels of a row that are painted at all
+static inline uint32_t
+_d2tk_mono_door(uint8_t bpp, uint8_t alpha, d2tk_coord_t y)
+{
+	const uint8_t *bayer = _d2tk_mono_bayer[y & 3];
+	uint32_t bits = 0;
+
+	for(unsigned x = 0; x < 4; x++)
+	{
+		bits = (bits << bpp) | ( (bayer[x] < alpha) ? _d2tk_mono_max(bpp) : 0);
+	}
+
+	if(bpp == 1)
+	{
+		bits |= bits << 4;
+	}
+
+	return bits * 0x01010101;
+}
+
+// fill bits [b0, b1) of row word-wise
+static inline void
+_d2tk_mono_bits(uint8_t *row, uint32_t b0, uint32_t b1, uint32_t pat,
+	uint32_t door)
+{
+	d2tk_mono_word_t *words = (d2tk_mono_word_t *)row;
+	const uint32_t w0 = b0 >> 5;
+	const uint32_t w1 = (b1 - 1) >> 5;
+	const uint32_t m0 = _d2tk_mono_be32(UINT32_MAX >> (b0 & 31)) & door;
+	const uint32_t m1 = _d2tk_mono_be32(UINT32_MAX << (31 - ( (b1 - 1) & 31)))
+		& door;
+
+	if(w0 == w1)
+	{
+		const uint32_t m = m0 & m1;
+
+		words[w0] = (words[w0] & ~m) | (pat & m);
+		return;
+	}
+
+	words[w0] = (words[w0] & ~m0) | (pat & m0);
+
+	if(door == UINT32_MAX)
+	{
+		for(uint32_t w = w0 + 1; w < w1; w++)
+		{
+			words[w] = pat;
+		}
+	}
+	else
+	{
+		for(uint32_t w = w0 + 1; w < w1; w++)
+		{
+			words[w] = (words[w] & ~door) | (pat & door);
+		}
+	}
+
+	words[w1] = (words[w1] & ~m1) | (pat & m1);
+}
+
+// paint pixels [x0, x1) of row y within current clip
+static void
+_d2tk_mono_span(d2tk_backend_mono_t *backend, d2tk_coord_t y, d2tk_coord_t x0,
+	d2tk_coord_t x1, uint16_t shade, uint8_t alpha)
+{
+	const d2tk_mono_rect_t *clip = &backend->state[backend->top].clip;
+
+	if( (y < clip->y0) || (y >= clip->y1) )
+	{
+		return;
+	}
+
+	if(x0 < clip->x0)
+	{
+		x0 = clip->x0;
+	}
+
+	if(x1 > clip->x1)
+	{
+		x1 = clip->x1;
+	}
+
+	if( (x0 >= x1) || (alpha == 0) )
+	{
+		return;
+	}
+
+	d2tk_mono_surf_t *surf = backend->surf;
+	const uint8_t bpp = surf->bpp;
+
+	_d2tk_mono_bits(&surf->buf[y*surf->stride], x0*bpp, x1*bpp,
+		_d2tk_mono_pattern(bpp, shade, y), _d2tk_mono_door(bpp, alpha, y));
+
+	if(backend->mask)
+	{
+		_d2tk_mono_bits(&backend->mask[y*backend->mstride], x0, x1,
+			UINT32_MAX, _d2tk_mono_door(1, alpha, y));
+	}
+}
+
+static inline void
+_d2tk_mono_clip_intersect(d2tk_mono_rect_t *clip, d2tk_coord_t x0,
+	d2tk_coord_t y0, d2tk_coord_t x1, d2tk_coord_t y1)
+{
+	if(clip->x0 < x0)
+	{
+		clip->x0 = x0;
+	}
+
+	if(clip->y0 < y0)
+	{
+		clip->y0 = y0;
+	}
+
+	if(clip->x1 > x1)
+	{
+		clip->x1 = x1;
+	}
+
+	if(clip->y1 > y1)
+	{
+		clip->y1 = y1;
+	}
+}
+
+// start over with pristine state clipped to given rectangle of target
+static void
+_d2tk_mono_reset(d2tk_backend_mono_t *backend, d2tk_coord_t x0, d2tk_coord_t y0,
+	d2tk_coord_t x1, d2tk_coord_t y1)
+{
+	d2tk_mono_state_t *state = &backend->state[0];
+
+	backend->clip.x0 = 0;
+	backend->clip.y0 = 0;
+	backend->clip.x1 = backend->surf->w;
+	backend->clip.y1 = backend->surf->h;
+	_d2tk_mono_clip_intersect(&backend->clip, x0, y0, x1, y1);
+
+	backend->top = 0;
+	backend->lost = 0;
+
+	state->shade = 0;
+	state->alpha = 16;
+	state->width = 2.f;
+	state->size = 10.f;
+	state->cs = 1.f;
+	state->sn = 0.f;
+	state->deg = 0.f;
+	state->clip = backend->clip;
+
+	backend->scratch->npts = 0;
+	backend->scratch->nsubs = 0;
+	backend->scratch->current = false;
+}
+
+static inline uint16_t
+_d2tk_mono_shade(uint8_t bpp, uint32_t rgba)
+{
+	const uint32_t r = (rgba >> 24) & 0xff;
+	const uint32_t g = (rgba >> 16) & 0xff;
+	const uint32_t b = (rgba >>  8) & 0xff;
+	const uint32_t luma = (r*77 + g*150 + b*29) >> 8;
+
+	return (luma * 16 * _d2tk_mono_max(bpp) + 127) / 255;
+}
+
+static inline uint8_t
+_d2tk_mono_alpha(uint32_t rgba)
+{
+	return ( (rgba & 0xff) * 16 + 127) / 255;
+}
+
+static void *
+_d2tk_mono_grow(void *ptr, uint32_t *max, uint32_t need, size_t sz)
+{
+	if(need <= *max)
+	{
+		return ptr;
+	}
+
+	uint32_t nmax = *max ? *max : 64;
+	while(nmax < need)
+	{
+		nmax <<= 1;
+	}
+
+	ptr = realloc(ptr, nmax * sz);
+	assert(ptr);
+	*max = nmax;
+
+	return ptr;
+}
+
+static void
+_d2tk_mono_move_to(d2tk_backend_mono_t *backend, float x, float y)
+{
+	d2tk_mono_scratch_t *scratch = backend->scratch;
+	const d2tk_mono_state_t *state = &backend->state[backend->top];
+
+	scratch->subs = _d2tk_mono_grow(scratch->subs, &scratch->maxsubs,
+		scratch->nsubs + 1, sizeof(d2tk_mono_sub_t));
+	scratch->pts = _d2tk_mono_grow(scratch->pts, &scratch->maxpts,
+		scratch->npts + 1, 2*sizeof(float));
+
+	d2tk_mono_sub_t *sub = &scratch->subs[scratch->nsubs++];
+	sub->first = scratch->npts;
+	sub->npts = 1;
+	sub->closed = false;
+
+	float *pt = &scratch->pts[2*scratch->npts++];
+	pt[0] = state->cs*x - state->sn*y;
+	pt[1] = state->sn*x + state->cs*y;
+
+	scratch->current = true;
+}
+
+static void
+_d2tk_mono_line_to(d2tk_backend_mono_t *backend, float x, float y)
+{
+	d2tk_mono_scratch_t *scratch = backend->scratch;
+	const d2tk_mono_state_t *state = &backend->state[backend->top];
+
+	if(!scratch->current)
+	{
+		_d2tk_mono_move_to(backend, x, y);
+		return;
+	}
+
+	d2tk_mono_sub_t *sub = &scratch->subs[scratch->nsubs - 1];
+
+	if(sub->closed) // continue from start of closed sub path
+	{
+		const uint32_t first = sub->first;
+
+		scratch->subs = _d2tk_mono_grow(scratch->subs, &scratch->maxsubs,
+			scratch->nsubs + 1, sizeof(d2tk_mono_sub_t));
+		scratch->pts = _d2tk_mono_grow(scratch->pts, &scratch->maxpts,
+			scratch->npts + 1, 2*sizeof(float));
+
+		sub = &scratch->subs[scratch->nsubs++];
+		sub->first = scratch->npts;
+		sub->npts = 1;
+		sub->closed = false;
+
+		memcpy(&scratch->pts[2*scratch->npts++], &scratch->pts[2*first],
+			2*sizeof(float));
+	}
+
+	scratch->pts = _d2tk_mono_grow(scratch->pts, &scratch->maxpts,
+		scratch->npts + 1, 2*sizeof(float));
+
+	float *pt = &scratch->pts[2*scratch->npts++];
+	pt[0] = state->cs*x - state->sn*y;
+	pt[1] = state->sn*x + state->cs*y;
+
+	sub->npts++;
+}
+
+static void
+_d2tk_mono_close_path(d2tk_backend_mono_t *backend)
+{
+	d2tk_mono_scratch_t *scratch = backend->scratch;
+
+	if(scratch->current)
+	{
+		scratch->subs[scratch->nsubs - 1].closed = true;
+	}
+}
+
+static inline unsigned
+_d2tk_mono_segments(float r, float angle)
+{
+	const float step = (r > _D2TK_MONO_TOL)
+		? 2.f * acosf(1.f - _D2TK_MONO_TOL / r)
+		: (float)M_PI_2;
+	const float n = ceilf(fabsf(angle) / step);
+
+	return n < 1.f ? 1 : n;
+}
+
+// like cairo, connects to start of arc from current point
+static void
+_d2tk_mono_arc(d2tk_backend_mono_t *backend, float xc, float yc, float r,
+	float a, float b)
+{
+	const unsigned n = _d2tk_mono_segments(r, b - a);
+	const float da = (b - a) / n;
+
+	_d2tk_mono_line_to(backend, xc + r*cosf(a), yc + r*sinf(a));
+
+	for(unsigned i = 1; i <= n; i++)
+	{
+		const float t = a + da*i;
+
+		_d2tk_mono_line_to(backend, xc + r*cosf(t), yc + r*sinf(t));
+	}
+}
+
+static void
+_d2tk_mono_curve_to(d2tk_backend_mono_t *backend, float x1, float y1,
+	float x2, float y2, float x3, float y3)
+{
+	d2tk_mono_scratch_t *scratch = backend->scratch;
+	const d2tk_mono_state_t *state = &backend->state[backend->top];
+
+	if(!scratch->current)
+	{
+		_d2tk_mono_move_to(backend, x1, y1);
+	}
+
+	// current point back in user space
+	const float *pt = &scratch->pts[2*(scratch->npts - 1)];
+	const float x0 = state->cs*pt[0] + state->sn*pt[1];
+	const float y0 = -state->sn*pt[0] + state->cs*pt[1];
+
+	const float len = hypotf(x1 - x0, y1 - y0) + hypotf(x2 - x1, y2 - y1)
+		+ hypotf(x3 - x2, y3 - y2);
+	const unsigned n = len < 8.f ? 2 : (len > 256.f ? 64 : len / 4.f);
+
+	for(unsigned i = 1; i <= n; i++)
+	{
+		const float t = (float)i / n;
+		const float u = 1.f - t;
+		const float c0 = u*u*u;
+		const float c1 = 3.f*u*u*t;
+		const float c2 = 3.f*u*t*t;
+		const float c3 = t*t*t;
+
+		_d2tk_mono_line_to(backend,
+			c0*x0 + c1*x1 + c2*x2 + c3*x3,
+			c0*y0 + c1*y1 + c2*y2 + c3*y3);
+	}
+}
+
+static void
+_d2tk_mono_edge(d2tk_mono_scratch_t *scratch, float x0, float y0,
+	float x1, float y1)
+{
+	if(y0 == y1)
+	{
+		return; // horizontal edges never cross a sample
+	}
+
+	scratch->edges = _d2tk_mono_grow(scratch->edges, &scratch->maxedges,
+		scratch->nedges + 1, sizeof(d2tk_mono_edge_t));
+
+	d2tk_mono_edge_t *edge = &scratch->edges[scratch->nedges++];
+
+	if(y0 < y1)
+	{
+		edge->x0 = x0;
+		edge->y0 = y0;
+		edge->y1 = y1;
+		edge->dir = 1;
+	}
+	else
+	{
+		edge->x0 = x1;
+		edge->y0 = y1;
+		edge->y1 = y0;
+		edge->dir = -1;
+	}
+
+	edge->dxdy = (x1 - x0) / (y1 - y0);
+}
+
+// scanline fill of edges with non-zero winding rule, sampled at pixel centers
+static void
+_d2tk_mono_raster(d2tk_backend_mono_t *backend)
+{
+	d2tk_mono_scratch_t *scratch = backend->scratch;
+	const d2tk_mono_state_t *state = &backend->state[backend->top];
+	const d2tk_mono_rect_t *clip = &state->clip;
+
+	if(!scratch->nedges || !state->alpha)
+	{
+		scratch->nedges = 0;
+		return;
+	}
+
+	float ymin = scratch->edges[0].y0;
+	float ymax = scratch->edges[0].y1;
+
+	for(uint32_t i = 1; i < scratch->nedges; i++)
+	{
+		const d2tk_mono_edge_t *edge = &scratch->edges[i];
+
+		if(edge->y0 < ymin)
+		{
+			ymin = edge->y0;
+		}
+
+		if(edge->y1 > ymax)
+		{
+			ymax = edge->y1;
+		}
+	}
+
+	const d2tk_coord_t ys = fmaxf(floorf(ymin), clip->y0);
+	const d2tk_coord_t ye = fminf(ceilf(ymax), clip->y1);
+
+	scratch->crosses = _d2tk_mono_grow(scratch->crosses, &scratch->maxcrosses,
+		scratch->nedges, sizeof(d2tk_mono_cross_t));
+
+	for(d2tk_coord_t y = ys; y < ye; y++)
+	{
+		const float yc = y + 0.5f;
+		uint32_t n = 0;
+
+		for(uint32_t i = 0; i < scratch->nedges; i++)
+		{
+			const d2tk_mono_edge_t *edge = &scratch->edges[i];
+
+			if( (yc < edge->y0) || (yc >= edge->y1) )
+			{
+				continue;
+			}
+
+			const d2tk_mono_cross_t cross = {
+				.x = edge->x0 + (yc - edge->y0)*edge->dxdy,
+				.dir = edge->dir
+			};
+
+			// insertion sort, there usually are just a few crossings
+			uint32_t j = n++;
+			for( ; (j > 0) && (scratch->crosses[j-1].x > cross.x); j--)
+			{
+				scratch->crosses[j] = scratch->crosses[j-1];
+			}
+			scratch->crosses[j] = cross;
+		}
+
+		int wind = 0;
+		float xs = 0.f;
+
+		for(uint32_t i = 0; i < n; i++)
+		{
+			const d2tk_mono_cross_t *cross = &scratch->crosses[i];
+			const int prev = wind;
+
+			wind += cross->dir;
+
+			if(!prev && wind)
+			{
+				xs = cross->x;
+			}
+			else if(prev && !wind)
+			{
+				const float x0 = fmaxf(ceilf(xs - 0.5f), clip->x0);
+				const float x1 = fminf(ceilf(cross->x - 0.5f), clip->x1);
+
+				if(x0 < x1)
+				{
+					_d2tk_mono_span(backend, y, x0, x1, state->shade, state->alpha);
+				}
+			}
+		}
+	}
+
+	scratch->nedges = 0;
+}
+
+static void
+_d2tk_mono_clear_path(d2tk_mono_scratch_t *scratch)
+{
+	scratch->npts = 0;
+	scratch->nsubs = 0;
+	scratch->current = false;
+}
+
+static void
+_d2tk_mono_fill(d2tk_backend_mono_t *backend)
+{
+	d2tk_mono_scratch_t *scratch = backend->scratch;
+
+	for(uint32_t s = 0; s < scratch->nsubs; s++)
+	{
+		const d2tk_mono_sub_t *sub = &scratch->subs[s];
+		const float *pts = &scratch->pts[2*sub->first];
+
+		// sub paths are closed implicitly
+		for(uint32_t i = 0; i < sub->npts; i++)
+		{
+			const float *p = &pts[2*i];
+			const float *q = &pts[2*( (i + 1) % sub->npts)];
+
+			_d2tk_mono_edge(scratch, p[0], p[1], q[0], q[1]);
+		}
+	}
+
+	_d2tk_mono_raster(backend);
+	_d2tk_mono_clear_path(scratch);
+}
+
+// thick lines are a union of quads per segment and discs at joins, all of them
+// wound the same way
+static void
+_d2tk_mono_stroke(d2tk_backend_mono_t *backend)
+{
+	d2tk_mono_scratch_t *scratch = backend->scratch;
+	const d2tk_mono_state_t *state = &backend->state[backend->top];
+	const float hw = (state->width < 1.f ? 1.f : state->width) / 2;
+	const unsigned ndisc = hw > 1.f
+		? _d2tk_mono_segments(hw, 2*M_PI)
+		: 0;
+
+	for(uint32_t s = 0; s < scratch->nsubs; s++)
+	{
+		const d2tk_mono_sub_t *sub = &scratch->subs[s];
+		const float *pts = &scratch->pts[2*sub->first];
+		const uint32_t nsegs = sub->closed ? sub->npts : sub->npts - 1;
+
+		if(sub->npts < 2)
+		{
+			continue;
+		}
+
+		for(uint32_t i = 0; i < nsegs; i++)
+		{
+			const float *p = &pts[2*i];
+			const float *q = &pts[2*( (i + 1) % sub->npts)];
+			const float dx = q[0] - p[0];
+			const float dy = q[1] - p[1];
+			const float len = hypotf(dx, dy);
+
+			if(len == 0.f)
+			{
+				continue;
+			}
+
+			const float nx = -dy / len * hw;
+			const float ny = dx / len * hw;
+
+			_d2tk_mono_edge(scratch, p[0] + nx, p[1] + ny, q[0] + nx, q[1] + ny);
+			_d2tk_mono_edge(scratch, q[0] + nx, q[1] + ny, q[0] - nx, q[1] - ny);
+			_d2tk_mono_edge(scratch, q[0] - nx, q[1] - ny, p[0] - nx, p[1] - ny);
+			_d2tk_mono_edge(scratch, p[0] - nx, p[1] - ny, p[0] + nx, p[1] + ny);
+		}
+
+		const uint32_t j0 = sub->closed ? 0 : 1;
+		const uint32_t j1 = sub->closed ? sub->npts : sub->npts - 1;
+
+		for(uint32_t j = j0; ndisc && (j < j1); j++)
+		{
+			const float *c = &pts[2*j];
+			float px = c[0] + hw;
+			float py = c[1];
+
+			for(unsigned k = 1; k <= ndisc; k++)
+			{
+				const float t = -2*M_PI * k / ndisc;
+				const float qx = c[0] + hw*cosf(t);
+				const float qy = c[1] + hw*sinf(t);
+
+				_d2tk_mono_edge(scratch, px, py, qx, qy);
+				px = qx;
+				py = qy;
+			}
+		}
+	}
+
+	_d2tk_mono_raster(backend);
+	_d2tk_mono_clear_path(scratch);
+}
+
+static d2tk_mono_sprite_t *
+_d2tk_mono_sprite_new(uint8_t bpp, uint32_t w, uint32_t h)
+{
+	const uint32_t stride = ( (w*bpp + 31) >> 5) << 2;
+	const uint32_t mstride = ( (w + 31) >> 5) << 2;
+	const size_t size = (size_t)(stride + mstride) * h;
+
+	d2tk_mono_sprite_t *sprite = calloc(1, sizeof(d2tk_mono_sprite_t) + size);
+	if(!sprite)
+	{
+		return NULL;
+	}
+
+	sprite->surf.buf = (uint8_t *)sprite->data;
+	sprite->surf.w = w;
+	sprite->surf.h = h;
+	sprite->surf.stride = stride;
+	sprite->surf.bpp = bpp;
+	sprite->mstride = mstride;
+	sprite->mask = &sprite->surf.buf[stride*h];
+	sprite->size = size;
+
+	return sprite;
+}
+
+static inline void
+_d2tk_mono_sprite_put(d2tk_mono_sprite_t *sprite, uint32_t x, uint32_t y,
+	uint8_t level)
+{
+	d2tk_mono_surf_t *surf = &sprite->surf;
+	const uint32_t bit = x * surf->bpp;
+	const uint8_t shift = 8 - surf->bpp - (bit & 7);
+	uint8_t *byte = &surf->buf[y*surf->stride + (bit >> 3)];
+
+	*byte = (*byte & ~(_d2tk_mono_max(surf->bpp) << shift)) | (level << shift);
+	sprite->mask[y*sprite->mstride + (x >> 3)] |= 0x80 >> (x & 7);
+}
+
+// dither 8-bit RGBA to sprite, premultiplied or not
+static d2tk_mono_sprite_t *
+_d2tk_mono_sprite_rgba(uint8_t bpp, uint32_t w, uint32_t h,
+	const uint8_t *pixels, size_t stride, bool premultiplied)
+{
+	d2tk_mono_sprite_t *sprite = _d2tk_mono_sprite_new(bpp, w, h);
+	if(!sprite)
+	{
+		return NULL;
+	}
+
+	for(uint32_t y = 0; y < h; y++)
+	{
+		const uint32_t *src = (const uint32_t *)&pixels[y*stride];
+
+		for(uint32_t x = 0; x < w; x++)
+		{
+			uint32_t rgba = src[x];
+			const uint8_t a = rgba & 0xff;
+
+			if(a < 0x80)
+			{
+				continue; // transparent
+			}
+
+			if(premultiplied)
+			{
+				const uint32_t r = ( (rgba >> 24) & 0xff) * 0xff / a;
+				const uint32_t g = ( (rgba >> 16) & 0xff) * 0xff / a;
+				const uint32_t b = ( (rgba >>  8) & 0xff) * 0xff / a;
+
+				rgba = (r << 24) | (g << 16) | (b << 8) | a;
+			}
+
+			const uint16_t shade = _d2tk_mono_shade(bpp, rgba);
+			const uint8_t level = (shade >> 4)
+				+ (_d2tk_mono_bayer[y & 3][x & 3] < (shade & 0xf));
+
+			_d2tk_mono_sprite_put(sprite, x, y, level);
+		}
+	}
+
+	return sprite;
+}
+
+// 32 bits starting at any bit of row, zeros beyond its ends
+static inline uint32_t
+_d2tk_mono_fetch(const uint8_t *row, uint32_t nbytes, int64_t bit)
+{
+	const int64_t byte = bit >> 3;
+	uint64_t acc = 0;
+
+	for(int64_t i = byte; i < byte + 5; i++)
+	{
+		acc = (acc << 8) | ( ( (i >= 0) && (i < nbytes) ) ? row[i] : 0);
+	}
+
+	return acc >> (8 - (bit & 7));
+}
+
+// duplicate each of 16 bits
+static inline uint32_t
+_d2tk_mono_spread(uint32_t v)
+{
+	v &= 0xffff;
+	v = (v | (v << 8)) & 0x00ff00ff;
+	v = (v | (v << 4)) & 0x0f0f0f0f;
+	v = (v | (v << 2)) & 0x33333333;
+	v = (v | (v << 1)) & 0x55555555;
+
+	return v | (v << 1);
+}
+
+// copy sprite unscaled with its top left corner at x, y, word by word
+static void
+_d2tk_mono_blit(d2tk_backend_mono_t *backend, const d2tk_mono_sprite_t *sprite,
+	d2tk_coord_t x, d2tk_coord_t y)
+{
+	const d2tk_mono_rect_t *clip = &backend->state[backend->top].clip;
+	d2tk_mono_surf_t *surf = backend->surf;
+	const uint8_t bpp = surf->bpp;
+
+	d2tk_mono_rect_t dst = {
+		.x0 = x,
+		.y0 = y,
+		.x1 = x + sprite->surf.w,
+		.y1 = y + sprite->surf.h
+	};
+	_d2tk_mono_clip_intersect(&dst, clip->x0, clip->y0, clip->x1, clip->y1);
+
+	if( (dst.x0 >= dst.x1) || (dst.y0 >= dst.y1) )
+	{
+		return;
+	}
+
+	assert(sprite->surf.bpp == bpp);
+
+	const uint32_t b0 = dst.x0 * bpp;
+	const uint32_t b1 = dst.x1 * bpp;
+	const uint32_t w0 = b0 >> 5;
+	const uint32_t w1 = (b1 - 1) >> 5;
+	const uint32_t m0 = UINT32_MAX >> (b0 & 31);
+	const uint32_t m1 = UINT32_MAX << (31 - ( (b1 - 1) & 31));
+
+	for(d2tk_coord_t py = dst.y0; py < dst.y1; py++)
+	{
+		const uint32_t sy = py - y;
+		const uint8_t *src = &sprite->surf.buf[sy*sprite->surf.stride];
+		const uint8_t *msk = &sprite->mask[sy*sprite->mstride];
+		d2tk_mono_word_t *words = (d2tk_mono_word_t *)&surf->buf[py*surf->stride];
+		uint8_t *mrow = backend->mask
+			? &backend->mask[py*backend->mstride]
+			: NULL;
+
+		for(uint32_t w = w0; w <= w1; w++)
+		{
+			const int64_t sx = (int64_t)(w << 5) / bpp - x; // of first pixel
+			uint32_t m = UINT32_MAX;
+
+			if(w == w0)
+			{
+				m &= m0;
+			}
+
+			if(w == w1)
+			{
+				m &= m1;
+			}
+
+			const uint32_t cov = _d2tk_mono_fetch(msk, sprite->mstride, sx);
+			m &= (bpp == 1) ? cov : _d2tk_mono_spread(cov >> 16);
+
+			if(!m)
+			{
+				continue;
+			}
+
+			const uint32_t bits = _d2tk_mono_fetch(src, sprite->surf.stride, sx*bpp);
+			const uint32_t old = _d2tk_mono_be32(words[w]);
+
+			words[w] = _d2tk_mono_be32( (old & ~m) | (bits & m) );
+		}
+
+		if(mrow) // nested sprite, merge coverage
+		{
+			for(d2tk_coord_t px = dst.x0; px < dst.x1; px++)
+			{
+				const uint32_t sx = px - x;
+
+				if(msk[sx >> 3] & (0x80 >> (sx & 7)))
+				{
+					mrow[px >> 3] |= 0x80 >> (px & 7);
+				}
+			}
+		}
+	}
+}
+
+// nearest neighbour scaling with runs of equal pixels painted as spans
+static void
+_d2tk_mono_blit_scaled(d2tk_backend_mono_t *backend,
+	const d2tk_mono_sprite_t *sprite, d2tk_coord_t x, d2tk_coord_t y,
+	d2tk_coord_t w, d2tk_coord_t h)
+{
+	const d2tk_mono_rect_t *clip = &backend->state[backend->top].clip;
+	const uint32_t W = sprite->surf.w;
+	const uint32_t H = sprite->surf.h;
+
+	d2tk_mono_rect_t dst = {
+		.x0 = x,
+		.y0 = y,
+		.x1 = x + w,
+		.y1 = y + h
+	};
+	_d2tk_mono_clip_intersect(&dst, clip->x0, clip->y0, clip->x1, clip->y1);
+
+	for(d2tk_coord_t py = dst.y0; py < dst.y1; py++)
+	{
+		const uint32_t sy = (uint64_t)(py - y) * H / h;
+		const uint8_t *msk = &sprite->mask[sy*sprite->mstride];
+		d2tk_coord_t run = dst.x0;
+		int prev = -1;
+
+		for(d2tk_coord_t px = dst.x0; px <= dst.x1; px++)
+		{
+			int cur = -1;
+
+			if(px < dst.x1)
+			{
+				const uint32_t sx = (uint64_t)(px - x) * W / w;
+
+				if(msk[sx >> 3] & (0x80 >> (sx & 7)))
+				{
+					cur = d2tk_mono_surf_get(&sprite->surf, sx, sy);
+				}
+			}
+
+			if(cur != prev)
+			{
+				if(prev != -1)
+				{
+					_d2tk_mono_span(backend, py, run, px, prev << 4, 16);
+				}
+
+				run = px;
+				prev = cur;
+			}
+		}
+	}
+}
+
+static inline void
+_d2tk_mono_sprite_draw(d2tk_backend_mono_t *backend,
+	const d2tk_mono_sprite_t *sprite, d2tk_coord_t xo, d2tk_coord_t yo,
+	d2tk_align_t align, const d2tk_rect_t *rect)
+{
+	const int W = sprite->surf.w;
+	const int H = sprite->surf.h;
+
+	if(!W || !H)
+	{
+		return;
+	}
+
+	d2tk_coord_t w = W;
+	d2tk_coord_t h = H;
+
+	if(h != rect->h)
+	{
+		const float scale = (float)rect->h / h;
+		w *= scale;
+		h = rect->h;
+	}
+
+	if(w > rect->w)
+	{
+		const float scale = (float)rect->w / w;
+		h *= scale;
+		w = rect->w;
+	}
+
+	d2tk_coord_t x = rect->x + xo;
+	d2tk_coord_t y = rect->y + yo;
+
+	if(align & D2TK_ALIGN_LEFT)
+	{
+		x += 0;
+	}
+	else if(align & D2TK_ALIGN_CENTER)
+	{
+		x += rect->w / 2;
+		x -= w / 2;
+	}
+	else if(align & D2TK_ALIGN_RIGHT)
+	{
+		x += rect->w;
+		x -= w;
+	}
+
+	if(align & D2TK_ALIGN_TOP)
+	{
+		y += 0;
+	}
+	else if(align & D2TK_ALIGN_MIDDLE)
+	{
+		y += rect->h / 2;
+		y -= h / 2;
+	}
+	else if(align & D2TK_ALIGN_BOTTOM)
+	{
+		y += rect->h;
+		y -= h;
+	}
+
+	if( (w <= 0) || (h <= 0) )
+	{
+		return;
+	}
+
+	if( (w == W) && (h == H) )
+	{
+		_d2tk_mono_blit(backend, sprite, x, y);
+	}
+	else
+	{
+		_d2tk_mono_blit_scaled(backend, sprite, x, y, w, h);
+	}
+}
+
+static inline const d2tk_mono_glyph_t *
+_d2tk_mono_glyph(const char **str)
+{
+	const uint8_t c = *(*str)++;
+
+	if(c >= 0x80) // no glyphs beyond ASCII
+	{
+		while( (**str & 0xc0) == 0x80)
+		{
+			(*str)++; // skip continuation bytes
+		}
+
+		return &_d2tk_mono_glyphs['?' - _D2TK_MONO_FONT_FIRST];
+	}
+
+	if( (c < _D2TK_MONO_FONT_FIRST) || (c > _D2TK_MONO_FONT_LAST) )
+	{
+		return &_d2tk_mono_glyphs['?' - _D2TK_MONO_FONT_FIRST];
+	}
+
+	return &_d2tk_mono_glyphs[c - _D2TK_MONO_FONT_FIRST];
+}
+
+// paint glyph scaled, destination pixels are set when any of their source
+// pixels are
+static void
+_d2tk_mono_glyph_draw(d2tk_backend_mono_t *backend,
+	const d2tk_mono_glyph_t *glyph, float fx, float fy, float scale,
+	uint16_t shade)
+{
+	const d2tk_mono_rect_t *clip = &backend->state[backend->top].clip;
+	const uint8_t *bmp = &_d2tk_mono_atlas[glyph->offset];
+	const uint32_t pitch = (glyph->w + 7) >> 3;
+
+	const d2tk_coord_t x0 = lroundf(fx);
+	const d2tk_coord_t y0 = lroundf(fy);
+	d2tk_coord_t w = lroundf(fx + glyph->w*scale) - x0;
+	d2tk_coord_t h = lroundf(fy + glyph->h*scale) - y0;
+
+	if(w < 1)
+	{
+		w = 1;
+	}
+
+	if(h < 1)
+	{
+		h = 1;
+	}
+
+	d2tk_mono_rect_t dst = {
+		.x0 = x0,
+		.y0 = y0,
+		.x1 = x0 + w,
+		.y1 = y0 + h
+	};
+	_d2tk_mono_clip_intersect(&dst, clip->x0, clip->y0, clip->x1, clip->y1);
+
+	for(d2tk_coord_t py = dst.y0; py < dst.y1; py++)
+	{
+		const uint32_t sy0 = (py - y0) * glyph->h / h;
+		uint32_t sy1 = (py - y0 + 1) * glyph->h / h;
+
+		if(sy1 <= sy0)
+		{
+			sy1 = sy0 + 1;
+		}
+
+		d2tk_coord_t run = dst.x0;
+		bool prev = false;
+
+		for(d2tk_coord_t px = dst.x0; px <= dst.x1; px++)
+		{
+			bool cur = false;
+
+			if(px < dst.x1)
+			{
+				const uint32_t sx0 = (px - x0) * glyph->w / w;
+				uint32_t sx1 = (px - x0 + 1) * glyph->w / w;
+
+				if(sx1 <= sx0)
+				{
+					sx1 = sx0 + 1;
+				}
+
+				for(uint32_t sy = sy0; !cur && (sy < sy1); sy++)
+				{
+					for(uint32_t sx = sx0; !cur && (sx < sx1); sx++)
+					{
+						cur = bmp[sy*pitch + (sx >> 3)] & (0x80 >> (sx & 7));
+					}
+				}
+			}
+
+			if(cur != prev)
+			{
+				if(prev)
+				{
+					_d2tk_mono_span(backend, py, run, px, shade, 16);
+				}
+
+				run = px;
+				prev = cur;
+			}
+		}
+	}
+}
+
+static void
+d2tk_mono_free(void *data)
+{
+	d2tk_backend_mono_t *backend = data;
+	d2tk_mono_scratch_t *scratch = backend->scratch;
+
+	free(scratch->pts);
+	free(scratch->subs);
+	free(scratch->edges);
+	free(scratch->crosses);
+	free(scratch);
+	free(backend);
+}
+
+static void *
+d2tk_mono_new(const char *bundle_path __attribute__((unused)), void *pctx)
+{
+	d2tk_mono_surf_t *surf = pctx;
+
+	if(!surf || !surf->buf || (surf->stride & 3)
+		|| ( (surf->bpp != 1) && (surf->bpp != 2) ) )
+	{
+		fprintf(stderr, "invalid mono surface\n");
+		return NULL;
+	}
+
+	d2tk_backend_mono_t *backend = calloc(1, sizeof(d2tk_backend_mono_t));
+	if(!backend)
+	{
+		fprintf(stderr, "calloc failed\n");
+		return NULL;
+	}
+
+	backend->scratch = calloc(1, sizeof(d2tk_mono_scratch_t));
+	if(!backend->scratch)
+	{
+		fprintf(stderr, "calloc failed\n");
+		free(backend);
+		return NULL;
+	}
+
+	backend->surf = surf;
+
+	return backend;
+}
+
+static inline void
+d2tk_mono_pre(void *data, d2tk_core_t *core,
+	d2tk_coord_t w __attribute__((unused)), d2tk_coord_t h __attribute__((unused)),
+	unsigned pass)
+{
+	d2tk_backend_mono_t *backend = data;
+
+	_d2tk_mono_reset(backend, 0, 0, backend->surf->w, backend->surf->h);
+
+	if(pass == 0) // is this 1st pass ?
+	{
+		return;
+	}
+
+	// clear dirty areas to background
+	unsigned nrects;
+	const d2tk_rect_t *rects = d2tk_core_get_dirty_rects(core, &nrects);
+	const uint32_t rgba = d2tk_core_get_bg_color(core);
+	const uint16_t shade = _d2tk_mono_shade(backend->surf->bpp, rgba);
+
+	for(unsigned i = 0; i < nrects; i++)
+	{
+		const d2tk_rect_t *rect = &rects[i];
+
+		for(d2tk_coord_t y = rect->y; y < rect->y + rect->h; y++)
+		{
+			_d2tk_mono_span(backend, y, rect->x, rect->x + rect->w, shade, 16);
+		}
+	}
+}
+
+static inline bool
+d2tk_mono_post(void *data __attribute__((unused)),
+	d2tk_core_t *core __attribute__((unused)),
+	d2tk_coord_t w __attribute__((unused)), d2tk_coord_t h __attribute__((unused)),
+	unsigned pass)
+{
+	if(pass == 0) // is this 1st pass ?
+	{
+		return true; // do enter 2nd pass
+	}
+
+	return false; // do NOT enter 3rd pass
+}
+
+static inline void
+d2tk_mono_sprite_free(void *data __attribute__((unused)), uint8_t type,
+	uintptr_t body)
+{
+	switch((sprite_type_t)type)
+	{
+		case SPRITE_TYPE_SURF:
+		{
+			d2tk_mono_sprite_t *sprite = (d2tk_mono_sprite_t *)body;
+
+			free(sprite);
+		} break;
+		case SPRITE_TYPE_NONE:
+		{
+			// nothing to do
+		} break;
+	}
+}
+
+static inline void
+d2tk_mono_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
+	d2tk_coord_t xo, d2tk_coord_t yo, const d2tk_clip_t *clip, unsigned pass)
+{
+	d2tk_backend_mono_t *backend = data;
+	d2tk_mono_state_t *state = &backend->state[backend->top];
+
+	const uint64_t t_instr = d2tk_trace_begin();
+	const d2tk_instr_t instr = com->instr;
+
+	// 1st pass only prepares sprites, drawing happens in 2nd
+	if( (pass == 0) && !backend->offscreen && (instr != D2TK_INSTR_BBOX) )
+	{
+		d2tk_trace_end("mono", d2tk_instr_name(instr), t_instr);
+		return;
+	}
+
+	switch(instr)
+	{
+		case D2TK_INSTR_LINE_TO:
+		{
+			const d2tk_body_line_to_t *body = &com->body->line_to;
+
+			_d2tk_mono_line_to(backend, body->x + xo, body->y + yo);
+		} break;
+		case D2TK_INSTR_MOVE_TO:
+		{
+			const d2tk_body_move_to_t *body = &com->body->move_to;
+
+			_d2tk_mono_move_to(backend, body->x + xo, body->y + yo);
+		} break;
+		case D2TK_INSTR_RECT:
+		{
+			const d2tk_body_rect_t *body = &com->body->rect;
+
+			const d2tk_coord_t x = body->x + xo;
+			const d2tk_coord_t y = body->y + yo;
+
+			_d2tk_mono_move_to(backend, x, y);
+			_d2tk_mono_line_to(backend, x + body->w, y);
+			_d2tk_mono_line_to(backend, x + body->w, y + body->h);
+			_d2tk_mono_line_to(backend, x, y + body->h);
+			_d2tk_mono_close_path(backend);
+		} break;
+		case D2TK_INSTR_ROUNDED_RECT:
+		{
+			const d2tk_body_rounded_rect_t *body = &com->body->rounded_rect;
+
+			const d2tk_coord_t x = body->x + xo;
+			const d2tk_coord_t y = body->y + yo;
+			const d2tk_coord_t w = body->w;
+			const d2tk_coord_t h = body->h;
+			const d2tk_coord_t r = body->r;
+
+			if(r > 0)
+			{
+				static const float mul = M_PI / 180.0;
+
+				backend->scratch->current = false;
+				_d2tk_mono_arc(backend, x + w - r, y + r, r, -90 * mul, 0 * mul);
+				_d2tk_mono_arc(backend, x + w - r, y + h - r, r, 0 * mul, 90 * mul);
+				_d2tk_mono_arc(backend, x + r, y + h - r, r, 90 * mul, 180 * mul);
+				_d2tk_mono_arc(backend, x + r, y + r, r, 180 * mul, 270 * mul);
+				_d2tk_mono_close_path(backend);
+			}
+			else
+			{
+				_d2tk_mono_move_to(backend, x, y);
+				_d2tk_mono_line_to(backend, x + w, y);
+				_d2tk_mono_line_to(backend, x + w, y + h);
+				_d2tk_mono_line_to(backend, x, y + h);
+				_d2tk_mono_close_path(backend);
+			}
+		} break;
+		case D2TK_INSTR_ARC:
+		{
+			const d2tk_body_arc_t *body = &com->body->arc;
+
+			static const float mul = M_PI / 180;
+			const float a = body->a * mul;
+			float b = body->b * mul;
+
+			// same angle normalization as cairo
+			if(body->cw)
+			{
+				while(b < a)
+				{
+					b += 2*M_PI;
+				}
+			}
+			else
+			{
+				while(b > a)
+				{
+					b -= 2*M_PI;
+				}
+			}
+
+			_d2tk_mono_arc(backend, body->x + xo, body->y + yo, body->r, a, b);
+		} break;
+		case D2TK_INSTR_CURVE_TO:
+		{
+			const d2tk_body_curve_to_t *body = &com->body->curve_to;
+
+			_d2tk_mono_curve_to(backend,
+				body->x1 + xo, body->y1 + yo,
+				body->x2 + xo, body->y2 + yo,
+				body->x3 + xo, body->y3 + yo);
+		} break;
+		case D2TK_INSTR_COLOR:
+		{
+			const d2tk_body_color_t *body = &com->body->color;
+
+			state->shade = _d2tk_mono_shade(backend->surf->bpp, body->rgba);
+			state->alpha = _d2tk_mono_alpha(body->rgba);
+		} break;
+		case D2TK_INSTR_LINEAR_GRADIENT:
+		{
+			const d2tk_body_linear_gradient_t *body = &com->body->linear_gradient;
+
+			// flat average of both stops
+			const uint8_t bpp = backend->surf->bpp;
+			state->shade = (_d2tk_mono_shade(bpp, body->rgba[0])
+				+ _d2tk_mono_shade(bpp, body->rgba[1])) / 2;
+			state->alpha = (_d2tk_mono_alpha(body->rgba[0])
+				+ _d2tk_mono_alpha(body->rgba[1])) / 2;
+		} break;
+		case D2TK_INSTR_ROTATE:
+		{
+			const d2tk_body_rotate_t *body = &com->body->rotate;
+
+			static const float mul = M_PI / 180;
+			state->deg += body->deg;
+			state->cs = cosf(state->deg * mul);
+			state->sn = sinf(state->deg * mul);
+		} break;
+		case D2TK_INSTR_STROKE:
+		{
+			_d2tk_mono_stroke(backend);
+		} break;
+		case D2TK_INSTR_FILL:
+		{
+			_d2tk_mono_fill(backend);
+		} break;
+		case D2TK_INSTR_SAVE:
+		{
+			if(backend->lost || (backend->top + 1 == _D2TK_MONO_STACK) )
+			{
+				backend->lost++;
+				break;
+			}
+
+			backend->state[backend->top + 1] = *state;
+			backend->top++;
+		} break;
+		case D2TK_INSTR_RESTORE:
+		{
+			if(backend->lost)
+			{
+				backend->lost--;
+			}
+			else if(backend->top)
+			{
+				backend->top--;
+			}
+		} break;
+		case D2TK_INSTR_BBOX:
+		{
+			const d2tk_body_bbox_t *body = &com->body->bbox;
+
+			if(pass == 0)
+			{
+				if(body->cached)
+				{
+					uintptr_t *sprite = d2tk_core_get_sprite(core, body->hash, SPRITE_TYPE_SURF);
+					assert(sprite);
+
+					if(!*sprite)
+					{
+						d2tk_mono_sprite_t *msprite = _d2tk_mono_sprite_new(
+							backend->surf->bpp, body->clip.w, body->clip.h);
+						assert(msprite);
+
+						d2tk_backend_mono_t *backend2 = malloc(sizeof(d2tk_backend_mono_t));
+						assert(backend2);
+
+						backend2->surf = &msprite->surf;
+						backend2->mask = msprite->mask;
+						backend2->mstride = msprite->mstride;
+						backend2->offscreen = true;
+						backend2->scratch = backend->scratch;
+						_d2tk_mono_reset(backend2, 0, 0, body->clip.w, body->clip.h);
+
+						D2TK_COM_FOREACH_CONST(com, bbox)
+						{
+							d2tk_mono_process(backend2, core, bbox, 0, 0, clip, pass);
+						}
+
+						free(backend2);
+						_d2tk_mono_clear_path(backend->scratch);
+
+						*sprite = (uintptr_t)msprite;
+						d2tk_core_set_sprite_size(core, sprite, msprite->size);
+					}
+				}
+				else if(backend->offscreen) // nested in sprite
+				{
+					D2TK_COM_FOREACH_CONST(com, bbox)
+					{
+						d2tk_mono_process(backend, core, bbox, body->clip.x0, body->clip.y0, clip, pass);
+					}
+				}
+			}
+			else if(pass == 1)
+			{
+				// each bbox starts over within its area-of-interest
+				if(clip)
+				{
+					_d2tk_mono_reset(backend, clip->x0, clip->y0, clip->x1, clip->y1);
+				}
+				else
+				{
+					_d2tk_mono_reset(backend, 0, 0, backend->surf->w, backend->surf->h);
+				}
+
+				if(body->cached)
+				{
+					uintptr_t *sprite = d2tk_core_get_sprite(core, body->hash, SPRITE_TYPE_SURF);
+					assert(sprite && *sprite);
+
+					const d2tk_mono_sprite_t *msprite = (const d2tk_mono_sprite_t *)*sprite;
+
+					// paint pre-rendered sprite
+					_d2tk_mono_blit(backend, msprite, body->clip.x0, body->clip.y0);
+				}
+				else // !body->cached
+				{
+					// render directly
+					D2TK_COM_FOREACH_CONST(com, bbox)
+					{
+						d2tk_mono_process(backend, core, bbox, body->clip.x0, body->clip.y0, clip, pass);
+					}
+				}
+			}
+		} break;
+		case D2TK_INSTR_BEGIN_PATH:
+		{
+			backend->scratch->current = false;
+		} break;
+		case D2TK_INSTR_CLOSE_PATH:
+		{
+			_d2tk_mono_close_path(backend);
+		} break;
+		case D2TK_INSTR_SCISSOR:
+		{
+			const d2tk_body_scissor_t *body = &com->body->scissor;
+
+			const d2tk_coord_t x = body->x + xo;
+			const d2tk_coord_t y = body->y + yo;
+
+			_d2tk_mono_clip_intersect(&state->clip, x, y, x + body->w, y + body->h);
+		} break;
+		case D2TK_INSTR_RESET_SCISSOR:
+		{
+			state->clip = backend->clip;
+		} break;
+		case D2TK_INSTR_FONT_FACE:
+		{
+			// there only is the built-in font
+		} break;
+		case D2TK_INSTR_FONT_SIZE:
+		{
+			const d2tk_body_font_size_t *body = &com->body->font_size;
+
+			state->size = body->size;
+		} break;
+		case D2TK_INSTR_TEXT:
+		{
+			const d2tk_body_text_t *body = &com->body->text;
+
+			if(!state->alpha)
+			{
+				break;
+			}
+
+			const float scale = state->size / _D2TK_MONO_FONT_SIZE;
+
+			// ink extents in font pixels
+			float xmin = FLT_MAX;
+			float xmax = -FLT_MAX;
+			float ymin = FLT_MAX;
+			float ymax = -FLT_MAX;
+			int32_t pen = 0;
+
+			for(const char *str = body->text; *str; )
+			{
+				const d2tk_mono_glyph_t *glyph = _d2tk_mono_glyph(&str);
+
+				if(glyph->w && glyph->h)
+				{
+					const float gx = pen / 64.f + glyph->xoff;
+
+					xmin = fminf(xmin, gx);
+					xmax = fmaxf(xmax, gx + glyph->w);
+					ymin = fminf(ymin, glyph->yoff);
+					ymax = fmaxf(ymax, glyph->yoff + glyph->h);
+				}
+
+				pen += glyph->advance;
+			}
+
+			if(xmin > xmax)
+			{
+				break; // no ink
+			}
+
+			const float x_bearing = xmin * scale;
+			const float y_bearing = ymin * scale;
+			const float width = (xmax - xmin) * scale;
+			const float height = (ymax - ymin) * scale;
+			int32_t x = -x_bearing;
+			int32_t y = -y_bearing;
+
+			if(body->align & D2TK_ALIGN_LEFT)
+			{
+				x += body->x;
+			}
+			else if(body->align & D2TK_ALIGN_CENTER)
+			{
+				x += body->x + body->w / 2;
+				x -= width / 2;
+			}
+			else if(body->align & D2TK_ALIGN_RIGHT)
+			{
+				x += body->x + body->w;
+				x -= width;
+			}
+
+			if(body->align & D2TK_ALIGN_TOP)
+			{
+				y += body->y;
+			}
+			else if(body->align & D2TK_ALIGN_MIDDLE)
+			{
+				y += body->y + body->h / 2;
+				y -= height / 2;
+			}
+			else if(body->align & D2TK_ALIGN_BOTTOM)
+			{
+				y += body->y + body->h;
+				y -= height;
+			}
+
+			// text is not dithered but snapped to nearest level
+			const uint16_t shade = (state->shade + 8) & ~0xf;
+
+			pen = 0;
+			for(const char *str = body->text; *str; )
+			{
+				const d2tk_mono_glyph_t *glyph = _d2tk_mono_glyph(&str);
+
+				if(glyph->w && glyph->h)
+				{
+					_d2tk_mono_glyph_draw(backend, glyph,
+						x + xo + (pen / 64.f + glyph->xoff) * scale,
+						y + yo + glyph->yoff * scale, scale, shade);
+				}
+
+				pen += glyph->advance;
+			}
+		} break;
+		case D2TK_INSTR_IMAGE:
+		{
+			const d2tk_body_image_t *body = &com->body->image;
+
+			const uint64_t hash = d2tk_hash(body->path, -1);
+			uintptr_t *sprite = d2tk_core_get_sprite(core, hash, SPRITE_TYPE_SURF);
+			assert(sprite);
+
+			if(!*sprite)
+			{
+				int W, H, N;
+				stbi_set_unpremultiply_on_load(1);
+				stbi_convert_iphone_png_to_rgb(1);
+				uint8_t *pixels = stbi_load(body->path, &W, &H, &N, 4);
+				assert(pixels);
+
+				// stb_image delivers bytes in RGBA order
+				for(unsigned i = 0; i < W*H*sizeof(uint32_t); i += sizeof(uint32_t))
+				{
+					uint32_t rgba = ( (uint32_t)pixels[i+0] << 24)
+						| ( (uint32_t)pixels[i+1] << 16)
+						| ( (uint32_t)pixels[i+2] << 8)
+						| pixels[i+3];
+
+					memcpy(&pixels[i], &rgba, sizeof(uint32_t));
+				}
+
+				d2tk_mono_sprite_t *msprite = _d2tk_mono_sprite_rgba(
+					backend->surf->bpp, W, H, pixels, W*sizeof(uint32_t), false);
+				assert(msprite);
+				stbi_image_free(pixels);
+
+				*sprite = (uintptr_t)msprite;
+				d2tk_core_set_sprite_size(core, sprite, msprite->size);
+			}
+
+			const d2tk_mono_sprite_t *msprite = (const d2tk_mono_sprite_t *)*sprite;
+			assert(msprite);
+
+			_d2tk_mono_sprite_draw(backend, msprite, xo, yo, body->align,
+				&D2TK_RECT(body->x, body->y, body->w, body->h));
+		} break;
+		case D2TK_INSTR_BITMAP:
+		{
+			const d2tk_body_bitmap_t *body = &com->body->bitmap;
+
+			const uint64_t hash = d2tk_hash(&body->surf, sizeof(body->surf));
+			uintptr_t *sprite = d2tk_core_get_sprite(core, hash, SPRITE_TYPE_SURF);
+			assert(sprite);
+
+			if(!*sprite)
+			{
+				const size_t sz = body->surf.w * sizeof(uint32_t);
+				uint8_t *pixels = malloc(body->surf.h * sz);
+				assert(pixels);
+
+				// premultiplied ARGB to RGBA
+				for(uint32_t y = 0; y < body->surf.h; y++)
+				{
+					const uint32_t *src = (const uint32_t *)
+						( (const uint8_t *)body->surf.argb + y*body->surf.stride);
+					uint32_t *dst = (uint32_t *)&pixels[y*sz];
+
+					for(uint32_t x = 0; x < body->surf.w; x++)
+					{
+						dst[x] = (src[x] << 8) | (src[x] >> 24);
+					}
+				}
+
+				d2tk_mono_sprite_t *msprite = _d2tk_mono_sprite_rgba(
+					backend->surf->bpp, body->surf.w, body->surf.h, pixels, sz, true);
+				assert(msprite);
+				free(pixels);
+
+				*sprite = (uintptr_t)msprite;
+				d2tk_core_set_sprite_size(core, sprite, msprite->size);
+			}
+
+			const d2tk_mono_sprite_t *msprite = (const d2tk_mono_sprite_t *)*sprite;
+			assert(msprite);
+
+			_d2tk_mono_sprite_draw(backend, msprite, xo, yo, body->align,
+				&D2TK_RECT(body->x, body->y, body->w, body->h));
+		} break;
+		case D2TK_INSTR_CUSTOM:
+		{
+			const d2tk_body_custom_t *body = &com->body->custom;
+
+			const uint64_t hash = body->hash;
+			uintptr_t *sprite = d2tk_core_get_sprite(core, hash, SPRITE_TYPE_SURF);
+			assert(sprite);
+
+			if(!*sprite)
+			{
+				d2tk_mono_sprite_t *msprite = _d2tk_mono_sprite_new(
+					backend->surf->bpp, body->w, body->h);
+				assert(msprite);
+
+				// custom draws are opaque
+				memset(msprite->mask, 0xff, msprite->mstride * body->h);
+				body->custom(&msprite->surf, body->size, body->data);
+
+				*sprite = (uintptr_t)msprite;
+				d2tk_core_set_sprite_size(core, sprite, msprite->size);
+			}
+
+			const d2tk_mono_sprite_t *msprite = (const d2tk_mono_sprite_t *)*sprite;
+			assert(msprite);
+
+			_d2tk_mono_sprite_draw(backend, msprite, xo, yo,
+				D2TK_ALIGN_LEFT | D2TK_ALIGN_TOP,
+				&D2TK_RECT(body->x, body->y, body->w, body->h));
+		} break;
+		case D2TK_INSTR_STROKE_WIDTH:
+		{
+			const d2tk_body_stroke_width_t *body = &com->body->stroke_width;
+
+			state->width = body->width;
+		} break;
+		default:
+		{
+			fprintf(stderr, "%s: unknown command (%i)\n", __func__, com->instr);
+		} break;
+	}
+
+	// bbox spans include their children
+	d2tk_trace_end("mono", d2tk_instr_name(instr), t_instr);
+}
+
+const d2tk_core_driver_t d2tk_core_driver = {
+	.new = d2tk_mono_new,
+	.free = d2tk_mono_free,
+	.pre = d2tk_mono_pre,
+	.process = d2tk_mono_process,
+	.post = d2tk_mono_post,
+	.sprite_free = d2tk_mono_sprite_free
+};
@@ -18,6 +18,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 #include <nanovg.h>
@@ -39,20 +40,25 @@
 #if defined(NANOVG_GL2_IMPLEMENTATION)
 #	define nvgCreate nvgCreateGL2
 #	define nvgDelete nvgDeleteGL2
+#	define nvglImageHandle nvglImageHandleGL2
 #elif defined(NANOVG_GL3_IMPLEMENTATION)
 #	define nvgCreate nvgCreateGL3
 #	define nvgDelete nvgDeleteGL3
+#	define nvglImageHandle nvglImageHandleGL3
 #elif defined(NANOVG_GLES2_IMPLEMENTATION)
 #	define nvgCreate nvgCreateGLES2
 #	define nvgDelete nvgDeleteGLES2
+#	define nvglImageHandle nvglImageHandleGLES2
 #elif defined(NANOVG_GLES3_IMPLEMENTATION)
 #	define nvgCreate nvgCreateGLES3
 #	define nvgDelete nvgDeleteGLES3
+#	define nvglImageHandle nvglImageHandleGLES3
 #endif
 
 #include "core_internal.h"
 #include <d2tk/backend.h>
 #include <d2tk/hash.h>
+#include <d2tk/trace.h>
 
 #define D2TK_BACKEND_NANOVG_FBO_MAX 2
 
@@ -60,10 +66,22 @@ typedef enum _sprite_type_t {
 	SPRITE_TYPE_NONE = 0,
 	SPRITE_TYPE_FBO  = 1,
 	SPRITE_TYPE_IMG  = 2,
-	SPRITE_TYPE_FONT = 3
+	SPRITE_TYPE_FONT = 3,
+	SPRITE_TYPE_BITMAP = 4
 } sprite_type_t;
 
 typedef struct _d2tk_backend_nanovg_t d2tk_backend_nanovg_t;
+typedef struct _d2tk_nanovg_bitmap_t d2tk_nanovg_bitmap_t;
+
+// texture of a bitmap buffer, updated in place on new revisions
+struct _d2tk_nanovg_bitmap_t {
+	int img;
+	bool mipmaps;
+	uint64_t rev;
+	uint32_t w;
+	uint32_t h;
+	uint32_t argb []; // copy of uploaded pixels, to find dirty rows
+};
 
 struct _d2tk_backend_nanovg_t {
 	NVGcontext *ctx;
@@ -72,7 +90,6 @@ struct _d2tk_backend_nanovg_t {
 	bool fbop;
 	d2tk_coord_t w;
 	d2tk_coord_t h;
-	int mask;
 };
 
 static void
@@ -89,12 +106,6 @@ d2tk_nanovg_free(void *data)
 		}
 	}
 
-	if(backend->mask)
-	{
-		nvgDeleteImage(backend->ctx, backend->mask);
-		backend->mask = 0;
-	}
-
 	if(backend->ctx)
 	{
 		nvgDelete(backend->ctx);
@@ -168,12 +179,6 @@ d2tk_nanovg_pre(void *data, d2tk_core_t *core, d2tk_coord_t w, d2tk_coord_t h,
 				backend->fbo[f] = NULL;
 			}
 		}
-
-		if(backend->mask)
-		{
-			nvgDeleteImage(ctx, backend->mask);
-			backend->mask = 0;
-		}
 	}
 
 	for(unsigned f = 0; f < D2TK_BACKEND_NANOVG_FBO_MAX; f++)
@@ -209,26 +214,22 @@ d2tk_nanovg_pre(void *data, d2tk_core_t *core, d2tk_coord_t w, d2tk_coord_t h,
 	}
 
 	{
-		// draw mask
-		d2tk_rect_t rect;
-		uint32_t *pixels = d2tk_core_get_pixels(core, &rect);
+		// clear dirty areas to background
+		unsigned nrects;
+		const d2tk_rect_t *rects = d2tk_core_get_dirty_rects(core, &nrects);
+		const uint32_t rgba = d2tk_core_get_bg_color(core);
 
-		if(backend->mask)
-		{
-			nvgUpdateSubImage(ctx, backend->mask, (const uint8_t *)pixels,
-				rect.x, rect.y, rect.w, rect.h);
-		}
-		else
+		nvgBeginPath(ctx);
+		for(unsigned i = 0; i < nrects; i++)
 		{
-			backend->mask = nvgCreateImageRGBA(ctx, w, h, NVG_IMAGE_NEAREST,
-				(const uint8_t *)pixels);
+			nvgRect(ctx, rects[i].x, rects[i].y, rects[i].w, rects[i].h);
 		}
-
-		const NVGpaint bg = nvgImagePattern(ctx, 0, 0, w, h, 0, backend->mask, 1.f);
-		nvgBeginPath(ctx);
-		nvgRect(ctx, rect.x, rect.y, rect.w, rect.h);
 		nvgStrokeWidth(ctx, 0);
-		nvgFillPaint(ctx, bg);
+		nvgFillColor(ctx, nvgRGBA(
+			(rgba >> 24) & 0xff,
+			(rgba >> 16) & 0xff,
+			(rgba >>  8) & 0xff,
+			(rgba >>  0) & 0xff));
 		nvgFill(ctx);
 	}
 }
@@ -273,36 +274,17 @@ d2tk_nanovg_post(void *data, d2tk_core_t *core __attribute__((unused)),
 
 #ifdef D2TK_DEBUG
 	{
-		d2tk_rect_t rect;
-		uint32_t *pixels = d2tk_core_get_pixels(core, &rect);
+		unsigned nrects;
+		const d2tk_rect_t *rects = d2tk_core_get_dirty_rects(core, &nrects);
 
-		// brighten up the pixels for proper hilighting
-		for(d2tk_coord_t y = 0, Y = 0; y < h; y++, Y+=w)
-		{
-			for(d2tk_coord_t x = 0; x < w; x++)
-			{
-				if(pixels[Y + x])
-				{
-					pixels[Y + x] = 0x5fffff00;; // ABGR
-				}
-			}
-		}
-
-		if(backend->mask)
-		{
-			nvgUpdateImage(ctx, backend->mask, (const uint8_t *)pixels);
-		}
-		else
+		// brighten up the dirty areas for proper hilighting
+		nvgBeginPath(ctx);
+		for(unsigned i = 0; i < nrects; i++)
 		{
-			backend->mask = nvgCreateImageRGBA(ctx, w, h, NVG_IMAGE_NEAREST,
-				(const uint8_t *)pixels);
+			nvgRect(ctx, rects[i].x, rects[i].y, rects[i].w, rects[i].h);
 		}
-	
-		const NVGpaint bg = nvgImagePattern(ctx, 0, 0, w, h, 0, backend->mask, 1.f);
-		nvgBeginPath(ctx);
-		nvgRect(ctx, 0, 0, w, h);
 		nvgStrokeWidth(ctx, 0);
-		nvgFillPaint(ctx, bg);
+		nvgFillColor(ctx, nvgRGBA(0x00, 0xff, 0xff, 0x5f));
 		nvgFill(ctx);
 	}
 #endif
@@ -336,6 +318,16 @@ d2tk_nanovg_sprite_free(void *data, uint8_t type, uintptr_t body)
 
 			nvgDeleteImage(ctx, img);
 		} break;
+		case SPRITE_TYPE_BITMAP:
+		{
+			d2tk_nanovg_bitmap_t *bitmap = (d2tk_nanovg_bitmap_t *)body;
+
+			if(bitmap->img)
+			{
+				nvgDeleteImage(ctx, bitmap->img);
+			}
+			free(bitmap);
+		} break;
 		case SPRITE_TYPE_FONT:
 		{
 			// fonts are automatically freed
@@ -347,6 +339,59 @@ d2tk_nanovg_sprite_free(void *data, uint8_t type, uintptr_t body)
 	}
 }
 
+// whether _d2tk_nanovg_surf_draw will shrink an image of given size
+static inline bool
+_d2tk_nanovg_surf_downscaled(uint32_t W, uint32_t H, const d2tk_rect_t *rect)
+{
+	const float w = (float)W * rect->h / H;
+	float h = rect->h;
+
+	if(w > rect->w)
+	{
+		h *= rect->w / w;
+	}
+
+	return h < H;
+}
+
+// copy changed rows and return the range of them
+static inline void
+_d2tk_nanovg_bitmap_sync(d2tk_nanovg_bitmap_t *bitmap,
+	const d2tk_body_bitmap_surf_t *surf, uint32_t *y0, uint32_t *y1)
+{
+	const size_t len = bitmap->w * sizeof(uint32_t);
+
+	*y0 = bitmap->h;
+	*y1 = 0;
+
+	for(uint32_t y = 0; y < bitmap->h; y++)
+	{
+		uint32_t *dst = &bitmap->argb[y * bitmap->w];
+		const uint32_t *src = (const uint32_t *)((const uint8_t *)surf->argb
+			+ y * surf->stride);
+
+		if(memcmp(dst, src, len))
+		{
+			memcpy(dst, src, len);
+
+			if(y < *y0)
+			{
+				*y0 = y;
+			}
+			*y1 = y + 1;
+		}
+	}
+}
+
+static inline void
+_d2tk_nanovg_generate_mipmaps(NVGcontext *ctx, int img)
+{
+	// nanovg leaves texture unit unbound after updates, restore that
+	glBindTexture(GL_TEXTURE_2D, nvglImageHandle(ctx, img));
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 static inline void
 _d2tk_nanovg_surf_draw(NVGcontext *ctx, int img, d2tk_coord_t xo,
 	d2tk_coord_t yo, d2tk_align_t align, const d2tk_rect_t *rect)
@@ -420,6 +465,7 @@ d2tk_nanovg_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 	d2tk_backend_nanovg_t *backend = data;
 	NVGcontext *ctx = backend->ctx;;
 
+	const uint64_t t_instr = d2tk_trace_begin();
 	const d2tk_instr_t instr = com->instr;
 	switch(instr)
 	{
@@ -575,6 +621,8 @@ d2tk_nanovg_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 						nvgluBindFramebuffer(NULL);
 
 						*sprite = (uintptr_t )fbo;
+						d2tk_core_set_sprite_size(core, sprite,
+							body->clip.w * body->clip.h * sizeof(uint32_t));
 					}
 					else
 					{
@@ -730,6 +778,14 @@ d2tk_nanovg_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 			if(!*sprite)
 			{
 				*sprite = nvgCreateImage(ctx, body->path, NVG_IMAGE_GENERATE_MIPMAPS);
+
+				if(*sprite)
+				{
+					int W, H;
+
+					nvgImageSize(ctx, *sprite, &W, &H);
+					d2tk_core_set_sprite_size(core, sprite, W*H*sizeof(uint32_t));
+				}
 			}
 
 			const int img = *sprite;
@@ -741,29 +797,86 @@ d2tk_nanovg_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 		case D2TK_INSTR_BITMAP:
 		{
 			const d2tk_body_bitmap_t *body = &com->body->bitmap;
+			const d2tk_body_bitmap_surf_t *surf = &body->surf;
+			const d2tk_rect_t rect = D2TK_RECT(body->x, body->y, body->w, body->h);
 
-			const uint64_t hash = d2tk_hash(&body->surf, sizeof(body->surf));
-			uintptr_t *sprite = d2tk_core_get_sprite(core, hash, SPRITE_TYPE_IMG);
+			if(!surf->argb || !surf->w || !surf->h)
+			{
+				break;
+			}
+
+			// keyed by buffer and size, new revisions are updated in place
+			const uint64_t hash = d2tk_hash_foreach(
+				&surf->argb, sizeof(surf->argb),
+				&surf->w, sizeof(surf->w),
+				&surf->h, sizeof(surf->h),
+				&surf->stride, sizeof(surf->stride),
+				NULL);
+			uintptr_t *sprite = d2tk_core_get_sprite(core, hash, SPRITE_TYPE_BITMAP);
 			assert(sprite);
 
-			if(!*sprite)
+			d2tk_nanovg_bitmap_t *bitmap = (d2tk_nanovg_bitmap_t *)*sprite;
+			const size_t bufsz = surf->w * surf->h * sizeof(uint32_t);
+			uint32_t y0;
+			uint32_t y1;
+
+			if(!bitmap)
 			{
-				*sprite = nvgCreateImageARGB(ctx, body->surf.w, body->surf.h,
-					NVG_IMAGE_GENERATE_MIPMAPS | NVG_IMAGE_PREMULTIPLIED,
-					(const uint8_t *)body->surf.argb);
-				//TODO use nvgUpdateImage for changed content
+				bitmap = calloc(1, sizeof(d2tk_nanovg_bitmap_t) + bufsz);
+				assert(bitmap);
+
+				bitmap->rev = surf->rev;
+				bitmap->w = surf->w;
+				bitmap->h = surf->h;
+				_d2tk_nanovg_bitmap_sync(bitmap, surf, &y0, &y1);
+
+				*sprite = (uintptr_t)bitmap;
+				d2tk_core_set_sprite_size(core, sprite, 2*bufsz);
 			}
+			else if(bitmap->rev != surf->rev)
+			{
+				bitmap->rev = surf->rev;
+				_d2tk_nanovg_bitmap_sync(bitmap, surf, &y0, &y1);
 
-			const int img = *sprite;
-			assert(img);
+				if(bitmap->img && (y1 > y0) )
+				{
+					nvgUpdateSubImage(ctx, bitmap->img, (const uint8_t *)bitmap->argb,
+						0, y0, bitmap->w, y1 - y0);
 
-			_d2tk_nanovg_surf_draw(ctx, img, xo, yo, body->align,
-					&D2TK_RECT(body->x, body->y, body->w, body->h));
+					if(bitmap->mipmaps)
+					{
+						_d2tk_nanovg_generate_mipmaps(ctx, bitmap->img);
+					}
+				}
+			}
+
+			// only pay for mipmaps once actually shrunk
+			const bool downscaled = _d2tk_nanovg_surf_downscaled(bitmap->w,
+				bitmap->h, &rect);
+
+			if(bitmap->img && downscaled && !bitmap->mipmaps)
+			{
+				nvgDeleteImage(ctx, bitmap->img);
+				bitmap->img = 0;
+			}
+
+			if(!bitmap->img)
+			{
+				bitmap->mipmaps = downscaled;
+				bitmap->img = nvgCreateImageARGB(ctx, bitmap->w, bitmap->h,
+					(downscaled ? NVG_IMAGE_GENERATE_MIPMAPS : 0)
+						| NVG_IMAGE_PREMULTIPLIED,
+					(const uint8_t *)bitmap->argb);
+			}
+
+			assert(bitmap->img);
+
+			_d2tk_nanovg_surf_draw(ctx, bitmap->img, xo, yo, body->align, &rect);
 		} break;
 		case D2TK_INSTR_CUSTOM:
 		{
 			const d2tk_body_custom_t *body = &com->body->custom;
-			const uint64_t hash = d2tk_hash(body->data, body->size);
+			const uint64_t hash = body->hash;
 
 			if(pass == 0)
 			{
@@ -797,6 +910,8 @@ d2tk_nanovg_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 						nvgluBindFramebuffer(NULL);
 
 						*sprite = (uintptr_t )fbo;
+						d2tk_core_set_sprite_size(core, sprite,
+							body->w * body->h * sizeof(uint32_t));
 					}
 					else
 					{
@@ -846,6 +961,9 @@ d2tk_nanovg_process(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 			fprintf(stderr, "%s: unknown command (%i)\n", __func__, com->instr);
 		} break;
 	}
+
+	// bbox spans include their children
+	d2tk_trace_end("nanovg", d2tk_instr_name(instr), t_instr);
 }
 
 const d2tk_core_driver_t d2tk_core_driver = {
@@ -24,15 +24,11 @@
 #include <d2tk/hash.h>
 #include "core_internal.h"
 
-#define _D2TK_MAX_ATOM 0x1000
-#define _D2TK_MASK_ATOMS (_D2TK_MAX_ATOM - 1)
-
 typedef struct _d2tk_flip_t d2tk_flip_t;
 typedef struct _d2tk_atom_body_scroll_t d2tk_atom_body_scroll_t;
 typedef struct _d2tk_atom_body_pane_t d2tk_atom_body_pane_t;
 typedef struct _d2tk_atom_body_flow_t d2tk_atom_body_flow_t;
 typedef union _d2tk_atom_body_t d2tk_atom_body_t;
-typedef struct _d2tk_atom_t d2tk_atom_t;
 
 typedef enum _d2tk_atom_type_t {
 	D2TK_ATOM_NONE,
@@ -72,12 +68,6 @@ union _d2tk_atom_body_t {
 	d2tk_atom_body_flow_t flow;
 };
 
-struct _d2tk_atom_t {
-	d2tk_id_t id;
-	d2tk_atom_type_t type;
-	d2tk_atom_body_t body;
-};
-
 struct _d2tk_base_t {
 	d2tk_flip_t hotitem;
 	d2tk_flip_t activeitem;
@@ -131,8 +121,6 @@ struct _d2tk_base_t {
 	bool focused;
 
 	d2tk_core_t *core;
-
-	d2tk_atom_t atoms [_D2TK_MAX_ATOM];
 };
 
 struct _d2tk_table_t {
@@ -290,34 +278,32 @@ _d2tk_flip_clear_old(d2tk_flip_t *flip)
 	_d2tk_flip_set_old(flip, 0);
 }
 
-static d2tk_atom_body_t *
-_d2tk_base_get_atom(d2tk_base_t *base, d2tk_id_t id, d2tk_atom_type_t type)
+// the default style is immutable, thus only hash it once
+static inline void
+_d2tk_hasher_style(d2tk_hasher_t *hasher, const d2tk_style_t *style)
 {
-	for(unsigned i = 0, idx = (id + i*i) & _D2TK_MASK_ATOMS;
-		i < _D2TK_MAX_ATOM;
-		i++, idx = (id + i*i) & _D2TK_MASK_ATOMS)
-	{
-		d2tk_atom_t *atom = &base->atoms[idx];
+	static uint64_t default_hash = 0;
 
-		if( (atom->id != 0) && (atom->id != id) )
-		{
-			continue;
-		}
-
-		d2tk_atom_body_t *body = &atom->body;
-
-		if( (atom->id == 0) || (atom->type != type) ) // new atom or changed type
-		{
-			memset(atom, 0x0, sizeof(d2tk_atom_t)); // clear atom and its body
-
-			atom->id = id;
-			atom->type = type;
-		}
+	if(style != d2tk_base_get_default_style())
+	{
+		d2tk_hasher_update(hasher, style, sizeof(d2tk_style_t));
+		return;
+	}
 
-		return body;
+	if(!default_hash)
+	{
+		default_hash = d2tk_hash(style, sizeof(d2tk_style_t));
 	}
 
-	return NULL; // no space left
+	d2tk_hasher_update_u64(hasher, default_hash);
+}
+
+// atoms live in the core and are dropped when not used for a while, their
+// bodies stay put for the rest of the frame
+static inline d2tk_atom_body_t *
+_d2tk_base_get_atom(d2tk_base_t *base, d2tk_id_t id, d2tk_atom_type_t type)
+{
+	return d2tk_core_get_atom(base->core, id, type, sizeof(d2tk_atom_body_t));
 }
 
 D2TK_API d2tk_table_t *
@@ -402,10 +388,21 @@ d2tk_frame_begin(d2tk_base_t *base, const d2tk_rect_t *rect,
 	frm->rect.y += h;
 	frm->rect.h -= h;
 
-	const uint64_t hash = d2tk_hash_foreach(rect, sizeof(d2tk_rect_t),
-		style, sizeof(d2tk_style_t),
-		lbl, lbl_len,
-		NULL);
+	if(lbl && (lbl_len == -1) ) // zero terminated string
+	{
+		lbl_len = strlen(lbl);
+	}
+
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	if(lbl)
+	{
+		d2tk_hasher_update(&hasher, lbl, lbl_len);
+	}
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -417,11 +414,6 @@ d2tk_frame_begin(d2tk_base_t *base, const d2tk_rect_t *rect,
 
 		if(lbl)
 		{
-			if(lbl_len == -1) // zero terminated string
-			{
-				lbl_len = strlen(lbl);
-			}
-
 			bnd_inner.h = h;
 
 			d2tk_core_begin_path(core);
@@ -1155,13 +1147,16 @@ _d2tk_draw_scrollbar(d2tk_core_t *core, d2tk_state_t hstate, d2tk_state_t vstate
 	const d2tk_rect_t *hbar, const d2tk_rect_t *vbar, const d2tk_style_t *style,
 	d2tk_flag_t flags)
 {
-	const uint64_t hash = d2tk_hash_foreach(&hstate, sizeof(d2tk_state_t),
-		&vstate, sizeof(d2tk_state_t),
-		hbar, sizeof(d2tk_rect_t),
-		vbar, sizeof(d2tk_rect_t),
-		style, sizeof(d2tk_style_t),
-		&flags, sizeof(d2tk_flag_t),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update_u32(&hasher, hstate);
+	d2tk_hasher_update_u32(&hasher, vstate);
+	d2tk_hasher_update(&hasher, hbar, sizeof(d2tk_rect_t));
+	d2tk_hasher_update(&hasher, vbar, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	d2tk_hasher_update_u32(&hasher, flags);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -1409,11 +1404,14 @@ static void
 _d2tk_draw_pane(d2tk_core_t *core, d2tk_state_t state, const d2tk_rect_t *sub,
 	const d2tk_style_t *style, d2tk_flag_t flags)
 {
-	const uint64_t hash = d2tk_hash_foreach(&state, sizeof(d2tk_state_t),
-		sub, sizeof(d2tk_rect_t),
-		style, sizeof(d2tk_style_t),
-		&flags, sizeof(d2tk_flag_t),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update_u32(&hasher, state);
+	d2tk_hasher_update(&hasher, sub, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	d2tk_hasher_update_u32(&hasher, flags);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -1619,9 +1617,12 @@ d2tk_base_cursor(d2tk_base_t *base, const d2tk_rect_t *rect)
 	d2tk_core_t *core = base->core;
 	const d2tk_style_t *style = d2tk_base_get_style(base);
 
-	const uint64_t hash = d2tk_hash_foreach(rect, sizeof(rect),
-		style, sizeof(d2tk_style_t),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -1658,6 +1659,70 @@ d2tk_base_cursor(d2tk_base_t *base, const d2tk_rect_t *rect)
 	}
 }
 
+#define _D2TK_STATS_LINES 8
+
+// overlay with counters of last frame, one label per line, so that only
+// changed lines get damaged
+D2TK_API void
+d2tk_base_stats(d2tk_base_t *base, const d2tk_rect_t *rect)
+{
+	d2tk_core_t *core = base->core;
+	const d2tk_style_t *style = d2tk_base_get_style(base);
+	d2tk_stats_t stats;
+	char lines [_D2TK_STATS_LINES][64];
+
+	d2tk_core_get_stats(core, &stats, NULL);
+
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
+
+	D2TK_CORE_WIDGET(core, hash, widget)
+	{
+		const size_t ref = d2tk_core_bbox_push(core, true, rect);
+
+		d2tk_core_begin_path(core);
+		d2tk_core_rect(core, rect);
+		d2tk_core_color(core, style->fill_color[D2TK_TRIPLE_NONE]);
+		d2tk_core_stroke_width(core, 0);
+		d2tk_core_fill(core);
+
+		d2tk_core_bbox_pop(core, ref);
+	}
+
+	snprintf(lines[0], sizeof(lines[0]), "stream %"PRIu64" B, %"PRIu64" bboxes",
+		stats.bytes, stats.bboxes);
+	snprintf(lines[1], sizeof(lines[1]), "diff   +%"PRIu64" -%"PRIu64", %.2f ms",
+		stats.appeared, stats.disappeared, stats.diff_ns / 1e6);
+	snprintf(lines[2], sizeof(lines[2]), "damage %"PRIu64" fills, %"PRIu64" px",
+		stats.fills, stats.area);
+	snprintf(lines[3], sizeof(lines[3]), "sprite %"PRIu64" hit %"PRIu64" miss %"
+		PRIu64" evict", stats.sprite_hits, stats.sprite_misses,
+		stats.sprite_evictions);
+	snprintf(lines[4], sizeof(lines[4]), "memc   %"PRIu64" hit %"PRIu64" miss %"
+		PRIu64" evict", stats.memcache_hits, stats.memcache_misses,
+		stats.memcache_evictions);
+	snprintf(lines[5], sizeof(lines[5]), "layout %"PRIu64" hit %"PRIu64" miss %"
+		PRIu64" evict", stats.layout_hits, stats.layout_misses,
+		stats.layout_evictions);
+	snprintf(lines[6], sizeof(lines[6]), "passes %"PRIu64", %.2f + %.2f ms",
+		stats.passes, stats.pass_ns[0] / 1e6, stats.pass_ns[1] / 1e6);
+	snprintf(lines[7], sizeof(lines[7]), "grows  %"PRIu64,
+		stats.mem_grows);
+
+	const d2tk_coord_t h = rect->h / _D2TK_STATS_LINES;
+
+	for(unsigned i = 0; i < _D2TK_STATS_LINES; i++)
+	{
+		d2tk_base_label(base, -1, lines[i], 0.8f,
+			&D2TK_RECT(rect->x, rect->y + i*h, rect->w, h),
+			D2TK_ALIGN_LEFT | D2TK_ALIGN_MIDDLE);
+	}
+}
+
 static inline void
 _d2tk_base_draw_button(d2tk_core_t *core, ssize_t lbl_len, const char *lbl,
 	d2tk_align_t align, ssize_t path_len, const char *path,
@@ -1676,16 +1741,22 @@ _d2tk_base_draw_button(d2tk_core_t *core, ssize_t lbl_len, const char *lbl,
 		path_len = strlen(path);
 	}
 
-	const d2tk_hash_dict_t dict [] = {
-		{ &triple, sizeof(d2tk_triple_t) },
-		{ rect, sizeof(d2tk_rect_t) },
-		{ style, sizeof(d2tk_style_t) },
-		{ &align, sizeof(d2tk_align_t) },
-		{ (lbl ? lbl : path), (lbl ? lbl_len : path_len) },
-		{ path, path_len },
-		{ NULL, 0 }
-	};
-	const uint64_t hash = d2tk_hash_dict(dict);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update_u32(&hasher, triple);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	d2tk_hasher_update_u32(&hasher, align);
+	if(has_lbl)
+	{
+		d2tk_hasher_update(&hasher, lbl, lbl_len);
+	}
+	if(has_img)
+	{
+		d2tk_hasher_update(&hasher, path, path_len);
+	}
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -1856,9 +1927,15 @@ d2tk_base_image(d2tk_base_t *base, ssize_t path_len, const char *path,
 		path_len = strlen(path);
 	}
 
-	const uint64_t hash = d2tk_hash_foreach(rect, sizeof(d2tk_rect_t),
-		(path ? path : NULL), (path ? path_len : 0),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	if(has_img)
+	{
+		d2tk_hasher_update(&hasher, path, path_len);
+	}
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	d2tk_core_t *core = base->core;;
 
@@ -1880,12 +1957,15 @@ d2tk_base_bitmap(d2tk_base_t *base, uint32_t w, uint32_t h, uint32_t stride,
 	const uint32_t *argb, uint64_t rev, const d2tk_rect_t *rect,
 	d2tk_align_t align)
 {
-	const uint64_t hash = d2tk_hash_foreach(rect, sizeof(d2tk_rect_t),
-		&w, sizeof(uint32_t),
-		&h, sizeof(uint32_t),
-		&stride, sizeof(uint32_t),
-		&rev, sizeof(uint64_t),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	d2tk_hasher_update_u32(&hasher, w);
+	d2tk_hasher_update_u32(&hasher, h);
+	d2tk_hasher_update_u32(&hasher, stride);
+	d2tk_hasher_update_u64(&hasher, rev);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	d2tk_core_t *core = base->core;;
 
@@ -1901,11 +1981,23 @@ d2tk_base_bitmap(d2tk_base_t *base, uint32_t w, uint32_t h, uint32_t stride,
 
 D2TK_API void
 d2tk_base_custom(d2tk_base_t *base, uint32_t size, const void *data,
-	const d2tk_rect_t *rect, d2tk_core_custom_t custom)
+	uint64_t rev, const d2tk_rect_t *rect, d2tk_core_custom_t custom)
 {
-	const uint64_t hash = d2tk_hash_foreach(rect, sizeof(d2tk_rect_t),
-		data, size, //FIXME
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	d2tk_hasher_update_u32(&hasher, size);
+	if(rev)
+	{
+		d2tk_hasher_update(&hasher, &data, sizeof(data));
+		d2tk_hasher_update_u64(&hasher, rev);
+	}
+	else
+	{
+		d2tk_hasher_update(&hasher, data, size);
+	}
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	d2tk_core_t *core = base->core;;
 
@@ -1913,7 +2005,7 @@ d2tk_base_custom(d2tk_base_t *base, uint32_t size, const void *data,
 	{
 		const size_t ref = d2tk_core_bbox_push(core, true, rect);
 
-		d2tk_core_custom(core, rect, size, data, custom);
+		d2tk_core_custom(core, rect, size, data, rev, custom);
 
 		d2tk_core_bbox_pop(core, ref);
 	}
@@ -1923,11 +2015,14 @@ static inline void
 _d2tk_base_draw_meter(d2tk_core_t *core, const d2tk_rect_t *rect,
 	d2tk_state_t state, int32_t value, const d2tk_style_t *style)
 {
-	const uint64_t hash = d2tk_hash_foreach(&state, sizeof(d2tk_state_t),
-		rect, sizeof(d2tk_rect_t),
-		style, sizeof(d2tk_style_t),
-		&value, sizeof(int32_t),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update_u32(&hasher, state);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	d2tk_hasher_update_u32(&hasher, value);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -2132,13 +2227,16 @@ _d2tk_base_draw_combo(d2tk_core_t *core, ssize_t nitms, const char **itms,
 	const d2tk_rect_t *rect, d2tk_state_t state, int32_t value,
 	const d2tk_style_t *style)
 {
-	const uint64_t hash = d2tk_hash_foreach(&state, sizeof(d2tk_state_t),
-		rect, sizeof(d2tk_rect_t),
-		style, sizeof(d2tk_style_t),
-		&value, sizeof(int32_t),
-		&nitms, sizeof(ssize_t),
-		itms, sizeof(const char **), //FIXME we should actually cache the labels
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update_u32(&hasher, state);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	d2tk_hasher_update_u32(&hasher, value);
+	d2tk_hasher_update(&hasher, &nitms, sizeof(ssize_t));
+	d2tk_hasher_update(&hasher, itms, sizeof(const char **)); //FIXME we should actually cache the labels
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -2360,12 +2458,15 @@ _d2tk_base_draw_text_field(d2tk_core_t *core, d2tk_state_t state,
 	const d2tk_rect_t *rect, const d2tk_style_t *style, char *value,
 	d2tk_align_t align)
 {
-	const uint64_t hash = d2tk_hash_foreach(&state, sizeof(d2tk_state_t),
-		rect, sizeof(d2tk_rect_t),
-		style, sizeof(d2tk_style_t),
-		&align, sizeof(d2tk_align_t),
-		value, -1,
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update_u32(&hasher, state);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	d2tk_hasher_update_u32(&hasher, align);
+	d2tk_hasher_update_str(&hasher, value);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -2549,23 +2650,26 @@ d2tk_base_label(d2tk_base_t *base, ssize_t lbl_len, const char *lbl,
 
 	d2tk_core_t *core = base->core;
 
-	const uint64_t hash = d2tk_hash_foreach(rect, sizeof(d2tk_rect_t),
-		style, sizeof(d2tk_style_t),
-		lbl, lbl_len,
-		&mul, sizeof(float),
-		&align, sizeof(d2tk_align_t),
-		NULL);
+	if(lbl_len == -1) // zero terminated string
+	{
+		lbl_len = strlen(lbl);
+	}
+
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	d2tk_hasher_update(&hasher, lbl, lbl_len);
+	d2tk_hasher_update(&hasher, &mul, sizeof(float));
+	d2tk_hasher_update_u32(&hasher, align);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
 		d2tk_rect_t bnd;
 		d2tk_rect_shrink(&bnd, rect, style->padding);
 
-		if(lbl_len == -1) // zero terminated string
-		{
-			lbl_len = strlen(lbl);
-		}
-
 		const d2tk_triple_t triple = D2TK_TRIPLE_NONE;
 
 		const size_t ref = d2tk_core_bbox_push(core, true, rect);
@@ -2614,11 +2718,14 @@ d2tk_base_dial_bool(d2tk_base_t *base, d2tk_id_t id, const d2tk_rect_t *rect,
 	const d2tk_style_t *style = d2tk_base_get_style(base);
 	d2tk_core_t *core = base->core;
 
-	const uint64_t hash = d2tk_hash_foreach(&state, sizeof(d2tk_state_t),
-		rect, sizeof(d2tk_rect_t),
-		style, sizeof(d2tk_style_t),
-		value, sizeof(bool),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update_u32(&hasher, state);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	d2tk_hasher_update(&hasher, value, sizeof(bool));
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -2684,11 +2791,14 @@ static inline void
 _d2tk_base_draw_dial(d2tk_core_t *core, const d2tk_rect_t *rect,
 	d2tk_state_t state, float rel, const d2tk_style_t *style)
 {
-	const uint64_t hash = d2tk_hash_foreach(&state, sizeof(d2tk_state_t),
-		rect, sizeof(d2tk_rect_t),
-		style, sizeof(d2tk_style_t),
-		&rel, sizeof(float),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update_u32(&hasher, state);
+	d2tk_hasher_update(&hasher, rect, sizeof(d2tk_rect_t));
+	_d2tk_hasher_style(&hasher, style);
+	d2tk_hasher_update(&hasher, &rel, sizeof(float));
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -3079,11 +3189,14 @@ _d2tk_flowmatrix_connect(d2tk_base_t *base, d2tk_flowmatrix_t *flowmatrix,
 		d2tk_base_get_mouse_pos(base, &dst.x, &dst.y);
 	}
 
-	const uint64_t hash = d2tk_hash_foreach(flowmatrix, sizeof(d2tk_flowmatrix_t),
-		src_pos, sizeof(d2tk_pos_t),
-		dst_pos ? dst_pos : &dst, sizeof(d2tk_pos_t),
-		style, sizeof(d2tk_style_t),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, flowmatrix, sizeof(d2tk_flowmatrix_t));
+	d2tk_hasher_update(&hasher, src_pos, sizeof(d2tk_pos_t));
+	d2tk_hasher_update(&hasher, dst_pos ? dst_pos : &dst, sizeof(d2tk_pos_t));
+	_d2tk_hasher_style(&hasher, style);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	d2tk_core_t *core = base->core;
 	D2TK_CORE_WIDGET(core, hash, widget)
@@ -3322,11 +3435,14 @@ d2tk_flowmatrix_node_begin(d2tk_base_t *base, d2tk_flowmatrix_t *flowmatrix,
 
 	const d2tk_style_t *style = d2tk_base_get_style(base);
 
-	const uint64_t hash = d2tk_hash_foreach(flowmatrix, sizeof(d2tk_flowmatrix_t),
-		pos, sizeof(d2tk_pos_t),
-		node, sizeof(d2tk_flowmatrix_node_t),
-		style, sizeof(d2tk_style_t),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, flowmatrix, sizeof(d2tk_flowmatrix_t));
+	d2tk_hasher_update(&hasher, pos, sizeof(d2tk_pos_t));
+	d2tk_hasher_update(&hasher, node, sizeof(d2tk_flowmatrix_node_t));
+	_d2tk_hasher_style(&hasher, style);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	D2TK_CORE_WIDGET(core, hash, widget)
 	{
@@ -3475,15 +3591,18 @@ d2tk_flowmatrix_arc_begin(d2tk_base_t *base, d2tk_flowmatrix_t *flowmatrix,
 
 	const d2tk_style_t *style = d2tk_base_get_style(base);
 
-	const uint64_t hash = d2tk_hash_foreach(flowmatrix, sizeof(d2tk_flowmatrix_t),
-		&N, sizeof(unsigned),
-		&M, sizeof(unsigned),
-		src, sizeof(d2tk_pos_t),
-		dst, sizeof(d2tk_pos_t),
-		pos, sizeof(d2tk_pos_t),
-		arc, sizeof(d2tk_flowmatrix_arc_t),
-		style, sizeof(d2tk_style_t),
-		NULL);
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, flowmatrix, sizeof(d2tk_flowmatrix_t));
+	d2tk_hasher_update_u32(&hasher, N);
+	d2tk_hasher_update_u32(&hasher, M);
+	d2tk_hasher_update(&hasher, src, sizeof(d2tk_pos_t));
+	d2tk_hasher_update(&hasher, dst, sizeof(d2tk_pos_t));
+	d2tk_hasher_update(&hasher, pos, sizeof(d2tk_pos_t));
+	d2tk_hasher_update(&hasher, arc, sizeof(d2tk_flowmatrix_arc_t));
+	_d2tk_hasher_style(&hasher, style);
+	const uint64_t hash = d2tk_hasher_final(&hasher);
 
 	d2tk_core_t *core = base->core;
 	D2TK_CORE_WIDGET(core, hash, widget)
@@ -3793,6 +3912,12 @@ d2tk_base_set_ttls(d2tk_base_t *base, uint32_t sprites, uint32_t memcaches)
 	d2tk_core_set_ttls(base->core, sprites, memcaches);
 }
 
+D2TK_API void
+d2tk_base_set_budgets(d2tk_base_t *base, size_t sprites, size_t memcaches)
+{
+	d2tk_core_set_budgets(base->core, sprites, memcaches);
+}
+
 D2TK_API void
 d2tk_base_free(d2tk_base_t *base)
 {
@@ -3984,3 +4109,33 @@ d2tk_base_get_dimensions(d2tk_base_t *base, d2tk_coord_t *w, d2tk_coord_t *h)
 {
 	d2tk_core_get_dimensions(base->core, w, h);
 }
+
+D2TK_API bool
+d2tk_base_get_dirty_rect(d2tk_base_t *base, d2tk_rect_t *rect)
+{
+	return d2tk_core_get_dirty_rect(base->core, rect);
+}
+
+D2TK_API const d2tk_rect_t *
+d2tk_base_get_dirty_rects(d2tk_base_t *base, unsigned *nrects)
+{
+	return d2tk_core_get_dirty_rects(base->core, nrects);
+}
+
+D2TK_API void
+d2tk_base_get_stats(d2tk_base_t *base, d2tk_stats_t *frame, d2tk_stats_t *total)
+{
+	d2tk_core_get_stats(base->core, frame, total);
+}
+
+D2TK_API void
+d2tk_base_set_record(d2tk_base_t *base, FILE *fout)
+{
+	d2tk_core_set_record(base->core, fout);
+}
+
+D2TK_API int
+d2tk_base_replay(d2tk_base_t *base, FILE *fin)
+{
+	return d2tk_core_replay(base->core, fin);
+}
@@ -32,31 +32,63 @@
 
 #include "core_internal.h"
 #include <d2tk/hash.h>
+#include <d2tk/trace.h>
+
+#define _D2TK_TILE_SHIFT			4 // 16x16 pixels per tile
+#define _D2TK_TILE_WORD				64 // tiles per word
+
+#define _D2TK_MEM_SIZE_MIN		0x2000
+#define _D2TK_MEM_SHRINK_FRAMES	0x40 // frames below 1/4 usage until shrink
+
+#define _D2TK_CACHE_LOG2_MIN	4 // 16 slots
+#define _D2TK_CACHE_LOG2_MAX	24
 
-#define _D2TK_SPRITES_MAX			0x10000 //FIXME how big?
-#define _D2TK_SPRITES_MASK		(_D2TK_SPRITES_MAX - 1)
 #define _D2TK_SPRITES_TTL			0x100
+#define _D2TK_SPRITES_BUDGET	0x2000000 // 32 MiB
 
-#define _D2TK_MEMCACHES_MAX		0x10000 //FIXME how big?
-#define _D2TK_MEMCACHES_MASK	(_D2TK_MEMCACHES_MAX - 1)
 #define _D2TK_MEMCACHES_TTL		0x100
+#define _D2TK_MEMCACHES_BUDGET	0x400000 // 4 MiB
+
+#define _D2TK_ATOMS_TTL				0x400 // frames until unseen widget state is dropped
+
+#define _D2TK_LAYOUTS_TTL			0x100
+#define _D2TK_LAYOUTS_BUDGET	0x100000 // 1 MiB
+
+#define _D2TK_RECORD_MAGIC		0x4b543244 // 'D2TK'
+#define _D2TK_RECORD_VERSION	3
+#define _D2TK_RECORDED_TTL		0x100 // recorded frames until pixels are written again
+
+#define _D2TK_REPLAY_DIM_MAX		0x4000
+#define _D2TK_REPLAY_SIZE_MAX		0x10000000 // 256 MiB, of stream, bitmap or payloads
+#define _D2TK_REPLAY_DEPTH_MAX	0x100 // nesting of bboxes
 
 typedef struct _d2tk_mem_t d2tk_mem_t;
 typedef struct _d2tk_bitmap_t d2tk_bitmap_t;
-typedef struct _d2tk_sprite_t d2tk_sprite_t;
-typedef struct _d2tk_memcache_t d2tk_memcache_t;
+typedef struct _d2tk_cache_entry_t d2tk_cache_entry_t;
+typedef struct _d2tk_cache_slot_t d2tk_cache_slot_t;
+typedef struct _d2tk_cache_t d2tk_cache_t;
+typedef struct _d2tk_diff_slot_t d2tk_diff_slot_t;
 typedef struct _d2tk_widget_body_t d2tk_widget_body_t;
+typedef struct _d2tk_record_t d2tk_record_t;
 
 struct _d2tk_mem_t {
 	size_t size;
 	size_t offset;
+	size_t used; // bytes touched since reset, beyond is all zero
+	size_t peak; // max offset in current shrink window
+	unsigned frames; // frames in current shrink window
+	uint64_t grows; // reallocations since last frame
 	uint8_t *buf;
 };
 
+// coarse damage map with one bit per tile
 struct _d2tk_bitmap_t {
-	size_t size;
-	uint32_t *pixels;
-	uint32_t *template;
+	uint64_t *tiles;
+	size_t stride; // words per row of tiles
+	d2tk_coord_t rows;
+	d2tk_rect_t *rects; // dirty tiles merged to rectangles
+	unsigned nrects;
+	unsigned maxrects;
 	size_t nfills;
 	d2tk_coord_t x0;
 	d2tk_coord_t x1;
@@ -64,26 +96,72 @@ struct _d2tk_bitmap_t {
 	d2tk_coord_t y1;
 };
 
-struct _d2tk_sprite_t {
+typedef void (*d2tk_cache_release_t)(d2tk_core_t *core,
+	d2tk_cache_entry_t *entry);
+
+// entries are allocated separately, so pointers to body stay valid on rehash
+struct _d2tk_cache_entry_t {
+	d2tk_cache_entry_t *prev; // less recently used
+	d2tk_cache_entry_t *next; // more recently used
 	uint64_t hash;
 	uintptr_t body;
 	uint32_t type;
-	uint32_t ttl;
+	uint64_t frame; // last used in, list is sorted by it
+	size_t size; // accounted bytes
 };
 
-struct _d2tk_memcache_t {
-	uint64_t hash;
-	uintptr_t body;
+struct _d2tk_cache_slot_t {
+	uint64_t key;
+	d2tk_cache_entry_t *entry;
+};
+
+// open-addressing table with robin hood probing and backward-shift deletion
+struct _d2tk_cache_t {
+	d2tk_cache_slot_t *slots;
+	uint32_t nslots;
+	uint32_t shift;
+	uint32_t nentries;
 	uint32_t ttl;
+	const uint64_t *clock; // frame counter ttl is measured in
+	size_t bytes;
+	size_t budget;
+	d2tk_cache_entry_t *head; // least recently used
+	d2tk_cache_entry_t *tail; // most recently used
+	d2tk_cache_release_t release;
+	uint64_t hits; // since last frame
+	uint64_t misses;
+	uint64_t evictions;
+};
+
+struct _d2tk_diff_slot_t {
+	uint32_t first; // index + 1 of first bbox with this key, 0 when empty
+	uint32_t cursor; // index + 1 of next candidate bbox, 0 when exhausted
 };
 
 struct _d2tk_widget_body_t {
 	size_t size;
+	uint64_t bboxes; // pushed while recorded, counted again on each hit
 	uint8_t buf [];
 };
 
+// frame header in recordings, host byte order, followed by dirty rectangles,
+// the command stream and the payloads referenced by pointer from it
+struct _d2tk_record_t {
+	uint32_t magic;
+	uint32_t version;
+	d2tk_coord_t w;
+	d2tk_coord_t h;
+	uint32_t bg_color;
+	uint32_t full_refresh;
+	d2tk_clip_t aoi;
+	uint32_t nrects;
+	uint32_t reserved;
+	uint64_t size; // bytes of command stream
+};
+
 struct _d2tk_widget_t {
 	size_t ref;
+	uint64_t bboxes; // stats at begin
 	uintptr_t *body;
 };
 
@@ -102,19 +180,34 @@ struct _d2tk_core_t {
 	d2tk_mem_t mem [2];
 	bool curmem;
 
+	d2tk_mem_t scratch; // diff indices
+
 	bool full_refresh;
 
 	d2tk_bitmap_t bitmap;
 
 	uint32_t bg_color;
 
-	struct {
-		uint32_t sprites;
-		uint32_t memcaches;
-	} ttl;
+	uint64_t frame;
+
+	d2tk_cache_t sprites;
+	d2tk_cache_t memcaches;
+	d2tk_cache_t layouts; // backend text layouts, independent of surface
+	d2tk_cache_t atoms; // persistent widget state of base by id
+#ifdef D2TK_DEBUG
+	d2tk_cache_t verifies; // bbox hash -> hashed bytes
+#endif
 
-	d2tk_sprite_t sprites [_D2TK_SPRITES_MAX];
-	d2tk_memcache_t memcaches [_D2TK_MEMCACHES_MAX];
+	FILE *record;
+	bool record_owned;
+	uint64_t records; // frames written to or read from recording
+	d2tk_cache_t recorded; // bitmap hashes already in recording
+	d2tk_cache_t replayed; // bitmap hash -> replayed pixels
+	d2tk_mem_t replay; // replayed custom payloads of current frame
+
+	d2tk_stats_t stats; // being collected for current frame
+	d2tk_stats_t last; // of last frame
+	d2tk_stats_t total;
 
 	ssize_t parent;
 };
@@ -154,387 +247,854 @@ d2tk_rect_shrink(d2tk_rect_t *dst, const d2tk_rect_t *src,
 	dst->h = src->h - brd;
 }
 
-uintptr_t *
-d2tk_core_get_sprite(d2tk_core_t *core, uint64_t hash, uint8_t type)
+static inline uint64_t
+_d2tk_cache_key(uint64_t hash, uint32_t type)
 {
-	for(unsigned i = 0; i < _D2TK_SPRITES_MAX; i++)
-	{
-		const unsigned j = (hash + i*i) & _D2TK_SPRITES_MASK;
-		d2tk_sprite_t *sprite = &core->sprites[j];
+	return (hash ^ ((uint64_t)type << 56)) * UINT64_C(0x9E3779B97F4A7C15);
+}
 
-		if(sprite->body) // sprite is already taken
-		{
-			// is this the sprite we're looking for?
-			if( (sprite->hash == hash) && (sprite->type == type) )
-			{
-				sprite->ttl = core->ttl.sprites;
-				sprite->type = type;
-				return &sprite->body;
-			}
-			else // not our sprite
-			{
-				continue;
-			}
-		}
+static inline uint32_t
+_d2tk_cache_dist(const d2tk_cache_t *cache, uint32_t idx, uint64_t key)
+{
+	const uint32_t home = key >> cache->shift;
 
-		// empty sprite, ready to be taken
-		sprite->hash = hash;
-		sprite->ttl = core->ttl.sprites;
-		sprite->type = type;
-		return &sprite->body;
-	}
+	return (idx - home) & (cache->nslots - 1);
+}
+
+static void
+_d2tk_cache_init(d2tk_cache_t *cache, const uint64_t *clock, uint32_t ttl,
+	size_t budget, d2tk_cache_release_t release)
+{
+	memset(cache, 0x0, sizeof(d2tk_cache_t));
 
-	return NULL; // out of memory FIXME increase memory and remap existing sprites
+	cache->clock = clock;
+	cache->ttl = ttl;
+	cache->budget = budget;
+	cache->release = release;
 }
 
-static inline void
-_d2tk_sprites_free(d2tk_core_t *core)
+static void
+_d2tk_cache_slot_insert(d2tk_cache_t *cache, d2tk_cache_slot_t cur)
 {
-	for(unsigned i = 0; i < _D2TK_SPRITES_MAX; i++)
+	const uint32_t mask = cache->nslots - 1;
+	uint32_t dist = 0;
+
+	for(uint32_t i = cur.key >> cache->shift; ; i = (i + 1) & mask, dist++)
 	{
-		d2tk_sprite_t *sprite = &core->sprites[i];
+		d2tk_cache_slot_t *slot = &cache->slots[i];
 
-		if(!sprite->hash)
+		if(!slot->entry)
 		{
-			continue;
+			*slot = cur;
+			return;
 		}
 
-		if(sprite->body)
+		const uint32_t d = _d2tk_cache_dist(cache, i, slot->key);
+
+		if(d < dist) // rob the rich
 		{
-			core->driver->sprite_free(core->data, sprite->type, sprite->body);
-			sprite->type = 0;
-			sprite->body = 0;
-		}
+			const d2tk_cache_slot_t tmp = *slot;
 
-		sprite->hash = 0;
+			*slot = cur;
+			cur = tmp;
+			dist = d;
+		}
 	}
 }
 
-static inline void
-_d2tk_sprites_gc(d2tk_core_t *core)
+static bool
+_d2tk_cache_rehash(d2tk_cache_t *cache, uint32_t log2)
 {
-	for(unsigned i = 0; i < _D2TK_SPRITES_MAX; i++)
+	const uint32_t nslots = 1U << log2;
+	d2tk_cache_slot_t *slots = calloc(nslots, sizeof(d2tk_cache_slot_t));
+
+	if(!slots)
 	{
-		d2tk_sprite_t *sprite = &core->sprites[i];
+		return false;
+	}
 
-		if(!sprite->hash || (--sprite->ttl > 0) )
-		{
-			continue;
-		}
+	d2tk_cache_slot_t *old = cache->slots;
+	const uint32_t nold = cache->nslots;
 
-		if(sprite->body)
+	cache->slots = slots;
+	cache->nslots = nslots;
+	cache->shift = 64 - log2;
+
+	for(uint32_t i = 0; i < nold; i++)
+	{
+		if(old[i].entry)
 		{
-#ifdef D2TK_DEBUG
-			fprintf(stderr, "\tgc sprites (%08"PRIx64")\n", sprite->hash);
-#endif
-			core->driver->sprite_free(core->data, sprite->type, sprite->body);
-			sprite->type = 0;
-			sprite->body = 0;
+			_d2tk_cache_slot_insert(cache, old[i]);
 		}
-
-		sprite->hash = 0;
 	}
-}
 
-static inline void
-_d2tk_mem_init(d2tk_mem_t *mem, size_t size)
-{
-	mem->size = size;
-	mem->offset = 0;
-	mem->buf = malloc(mem->size);
-}
+	free(old);
 
-static inline void
-_d2tk_mem_deinit(d2tk_mem_t *mem)
-{
-	mem->size = 0;
-	mem->offset = 0;
-	free(mem->buf);
-	mem->buf = NULL;
+	return true;
 }
 
-static inline void
-_d2tk_mem_reset(d2tk_mem_t *mem)
+static inline uint32_t
+_d2tk_cache_log2(const d2tk_cache_t *cache)
 {
-	mem->offset = 0;
-	memset(mem->buf, 0x0, mem->size);
+	return 64 - cache->shift;
 }
 
-static uintptr_t *
-_d2tk_core_get_memcache(d2tk_core_t *core, uint64_t hash)
+static int64_t
+_d2tk_cache_lookup(const d2tk_cache_t *cache, uint64_t key, uint64_t hash,
+	uint32_t type)
 {
-	for(unsigned i = 0; i < _D2TK_MEMCACHES_MAX; i++)
+	if(!cache->nslots)
 	{
-		const unsigned j = (hash + i*i) & _D2TK_MEMCACHES_MASK;
-		d2tk_memcache_t *memcache = &core->memcaches[j];
-
-		if(memcache->body) // memcache is already taken
-		{
-			// is this the memcache we're looking for?
-			if(memcache->hash == hash)
-			{
-				memcache->ttl = core->ttl.memcaches;
-				return &memcache->body;
-			}
-			else // not our memcache
-			{
-				continue;
-			}
-		}
-
-		// empty memcache, ready to be taken
-		memcache->hash = hash;
-		memcache->ttl = core->ttl.memcaches;
-		return &memcache->body;
+		return -1;
 	}
 
-	return NULL; // out of memory FIXME increase memory and remap existing memcaches
-}
+	const uint32_t mask = cache->nslots - 1;
+	uint32_t dist = 0;
 
-static inline void
-_d2tk_memcaches_free(d2tk_core_t *core)
-{
-	for(unsigned i = 0; i < _D2TK_MEMCACHES_MAX; i++)
+	for(uint32_t i = key >> cache->shift; ; i = (i + 1) & mask, dist++)
 	{
-		d2tk_memcache_t *memcache = &core->memcaches[i];
+		const d2tk_cache_slot_t *slot = &cache->slots[i];
 
-		if(!memcache->hash)
+		if(!slot->entry || (_d2tk_cache_dist(cache, i, slot->key) < dist) )
 		{
-			continue;
+			return -1; // would have been placed here
 		}
 
-		if(memcache->body)
+		if( (slot->key == key) && (slot->entry->hash == hash)
+			&& (slot->entry->type == type) )
 		{
-			d2tk_widget_body_t *body = (d2tk_widget_body_t *)memcache->body;
-
-			free(body);
-			memcache->body = 0;
+			return i;
 		}
-
-		memcache->hash = 0;
 	}
 }
 
 static inline void
-_d2tk_memcaches_gc(d2tk_core_t *core)
+_d2tk_cache_unlink(d2tk_cache_t *cache, d2tk_cache_entry_t *entry)
 {
-	for(unsigned i = 0; i < _D2TK_MEMCACHES_MAX; i++)
+	if(entry->prev)
 	{
-		d2tk_memcache_t *memcache = &core->memcaches[i];
-
-		if(!memcache->hash || (--memcache->ttl > 0) )
-		{
-			continue;
-		}
-
-		if(memcache->body)
-		{
-#ifdef D2TK_DEBUG
-			fprintf(stderr, "\tgc memcaches (%08"PRIx64")\n", memcache->hash);
-#endif
-			d2tk_widget_body_t *body = (d2tk_widget_body_t *)memcache->body;
-
-			free(body);
-			memcache->body = 0;
-		}
-
-		memcache->hash = 0;
+		entry->prev->next = entry->next;
 	}
-}
-
-static inline void
-_d2tk_bitmap_template_refill(d2tk_core_t *core)
-{
-	d2tk_bitmap_t *bitmap = &core->bitmap;
-
-	for(d2tk_coord_t x = 0; x < core->w; x++)
+	else
 	{
-		bitmap->template[x] = core->bg_color;
+		cache->head = entry->next;
 	}
-}
-
-static inline void
-_d2tk_bitmap_resize(d2tk_core_t *core, d2tk_coord_t w, d2tk_coord_t h)
-{
-	d2tk_bitmap_t *bitmap = &core->bitmap;
 
-	const size_t stride = w*sizeof(uint32_t);
-	bitmap->size = h*stride;
-	bitmap->pixels = realloc(bitmap->pixels, bitmap->size);
-	bitmap->template = realloc(bitmap->template, stride);
-	_d2tk_bitmap_template_refill(core);
-}
+	if(entry->next)
+	{
+		entry->next->prev = entry->prev;
+	}
+	else
+	{
+		cache->tail = entry->prev;
+	}
 
-static inline void
-_d2tk_bitmap_deinit(d2tk_bitmap_t *bitmap)
-{
-	free(bitmap->pixels);
-	bitmap->pixels = NULL;
-	free(bitmap->template);
-	bitmap->template = NULL;
-	bitmap->size = 0;
-	bitmap->nfills = 0;
+	entry->prev = NULL;
+	entry->next = NULL;
 }
 
 static inline void
-_d2tk_bitmap_reset(d2tk_core_t *core)
+_d2tk_cache_append(d2tk_cache_t *cache, d2tk_cache_entry_t *entry)
 {
-	d2tk_bitmap_t *bitmap = &core->bitmap;
-
-	// x1/y1 may be wrong after window shrink
-	const d2tk_coord_t x1 = bitmap->x1 < core->w
-		? bitmap->x1
-		: core->w;
-	const d2tk_coord_t y1 = bitmap->y1 < core->h
-		? bitmap->y1
-		: core->h;
-
-	const size_t stride = (x1 - bitmap->x0)*sizeof(uint32_t);
+	entry->prev = cache->tail;
+	entry->next = NULL;
 
-	for(d2tk_coord_t y = bitmap->y0, Y = y*core->w; y < y1; y++, Y+=core->w)
+	if(cache->tail)
+	{
+		cache->tail->next = entry;
+	}
+	else
 	{
-		memset(&bitmap->pixels[Y + bitmap->x0], 0x0, stride);
+		cache->head = entry;
 	}
 
-	bitmap->nfills = 0;
-	bitmap->x0 = INT_MAX;
-	bitmap->x1 = INT_MIN;
-	bitmap->y0 = INT_MAX;
-	bitmap->y1 = INT_MIN;
+	cache->tail = entry;
 }
 
-static inline void
-_d2tk_clip_clip(d2tk_core_t *core, d2tk_clip_t *dst, const d2tk_clip_t *src)
+static uintptr_t *
+_d2tk_cache_get(d2tk_cache_t *cache, uint64_t hash, uint32_t type)
 {
-	*dst = *src;
+	const uint64_t key = _d2tk_cache_key(hash, type);
+	const int64_t idx = _d2tk_cache_lookup(cache, key, hash, type);
 
-	if(dst->x0 < 0)
-	{
-		dst->x0 = 0;
-	}
-	if(dst->x1 < 0)
+	if(idx >= 0) // hit, mark as most recently used
 	{
-		dst->x1 = 0;
-	}
+		d2tk_cache_entry_t *entry = cache->slots[idx].entry;
 
-	if(dst->y0 < 0)
-	{
-		dst->y0 = 0;
-	}
-	if(dst->y1 < 0)
-	{
-		dst->y1 = 0;
-	}
+		entry->frame = *cache->clock;
+		cache->hits++;
 
-	if(dst->x0 >= core->w)
-	{
-		dst->x0 = core->w - 1;
-	}
-	if(dst->x1 >= core->w)
-	{
-		dst->x1 = core->w - 1;
+		if(entry != cache->tail)
+		{
+			_d2tk_cache_unlink(cache, entry);
+			_d2tk_cache_append(cache, entry);
+		}
+
+		return &entry->body;
 	}
 
-	if(dst->y0 >= core->h)
+	// grow above load factor of 7/8
+	if( (cache->nentries + 1) * 8 > cache->nslots * 7)
 	{
-		dst->y0 = core->h - 1;
+		const uint32_t log2 = cache->nslots
+			? _d2tk_cache_log2(cache) + 1
+			: _D2TK_CACHE_LOG2_MIN;
+
+		if( (log2 > _D2TK_CACHE_LOG2_MAX) || !_d2tk_cache_rehash(cache, log2) )
+		{
+			if(cache->nentries == cache->nslots)
+			{
+				return NULL; // out of memory
+			}
+		}
 	}
-	if(dst->y1 >= core->h)
+
+	d2tk_cache_entry_t *entry = calloc(1, sizeof(d2tk_cache_entry_t));
+	if(!entry)
 	{
-		dst->y1 = core->h - 1;
+		return NULL; // out of memory
 	}
+
+	entry->hash = hash;
+	entry->type = type;
+	entry->frame = *cache->clock;
+	entry->size = sizeof(d2tk_cache_entry_t);
+	cache->misses++;
+
+	_d2tk_cache_slot_insert(cache, (d2tk_cache_slot_t){
+		.key = key,
+		.entry = entry
+	});
+	_d2tk_cache_append(cache, entry);
+
+	cache->nentries++;
+	cache->bytes += entry->size;
+
+	return &entry->body;
+}
+
+static inline d2tk_cache_entry_t *
+_d2tk_cache_entry_from_body(uintptr_t *body)
+{
+	return (d2tk_cache_entry_t *)((uint8_t *)body
+		- offsetof(d2tk_cache_entry_t, body));
 }
 
 static inline void
-_d2tk_bitmap_fill(d2tk_core_t *core, const d2tk_clip_t *clip)
+_d2tk_cache_account(d2tk_cache_t *cache, uintptr_t *body, size_t size)
 {
-	d2tk_bitmap_t *bitmap = &core->bitmap;
+	d2tk_cache_entry_t *entry = _d2tk_cache_entry_from_body(body);
 
-	d2tk_clip_t dst;
-	_d2tk_clip_clip(core, &dst, clip);
+	cache->bytes -= entry->size;
+	entry->size = sizeof(d2tk_cache_entry_t) + size;
+	cache->bytes += entry->size;
+}
 
-	const size_t stride = (dst.x1 - dst.x0)*sizeof(uint32_t);
+static void
+_d2tk_cache_remove(d2tk_core_t *core, d2tk_cache_t *cache,
+	d2tk_cache_entry_t *entry)
+{
+	const uint32_t mask = cache->nslots - 1;
+	int64_t idx = _d2tk_cache_lookup(cache,
+		_d2tk_cache_key(entry->hash, entry->type), entry->hash, entry->type);
+	assert(idx >= 0);
 
-	for(d2tk_coord_t y = dst.y0, Y = y*core->w; y < dst.y1; y++, Y+=core->w)
+	// shift following displaced slots back by one, no tombstones needed
+	for(uint32_t i = idx, j = (idx + 1) & mask; ; i = j, j = (j + 1) & mask)
 	{
-		memcpy(&bitmap->pixels[Y + dst.x0], bitmap->template, stride);
-	}
+		d2tk_cache_slot_t *slot = &cache->slots[j];
 
-	// update area of interest
-	if(dst.x0 < bitmap->x0)
-	{
-		bitmap->x0 = dst.x0;
-	}
+		if(!slot->entry || (_d2tk_cache_dist(cache, j, slot->key) == 0) )
+		{
+			cache->slots[i].key = 0;
+			cache->slots[i].entry = NULL;
+			break;
+		}
 
-	if(dst.x1 > bitmap->x1)
-	{
-		bitmap->x1 = dst.x1;
+		cache->slots[i] = *slot;
 	}
 
-	if(dst.y0 < bitmap->y0)
-	{
-		bitmap->y0 = dst.y0;
-	}
+	_d2tk_cache_unlink(cache, entry);
 
-	if(dst.y1 > bitmap->y1)
+	cache->nentries--;
+	cache->bytes -= entry->size;
+
+	if(entry->body)
 	{
-		bitmap->y1 = dst.y1;
+		cache->release(core, entry);
 	}
 
-	bitmap->nfills++;
+	free(entry);
 }
 
 static void
-_d2tk_bbox_mask(d2tk_core_t *core, d2tk_com_t *com)
+_d2tk_cache_free(d2tk_core_t *core, d2tk_cache_t *cache)
 {
-	d2tk_body_bbox_t *body = &com->body->bbox;
-
-	if(body->container)
+	for(d2tk_cache_entry_t *entry = cache->head, *next; entry; entry = next)
 	{
-		D2TK_COM_FOREACH(com, bbox)
+		next = entry->next;
+
+		if(entry->body)
 		{
-			_d2tk_bbox_mask(core, bbox);
+			cache->release(core, entry);
 		}
-	}
-	else
-	{
-		_d2tk_bitmap_fill(core, &body->clip);
+
+		free(entry);
 	}
 
-	body->dirty = true;
+	free(cache->slots);
+
+	cache->slots = NULL;
+	cache->nslots = 0;
+	cache->shift = 0;
+	cache->nentries = 0;
+	cache->bytes = 0;
+	cache->head = NULL;
+	cache->tail = NULL;
 }
 
-uint32_t *
-d2tk_core_get_pixels(d2tk_core_t *core, d2tk_rect_t *rect)
+static void
+_d2tk_cache_gc(d2tk_core_t *core, d2tk_cache_t *cache)
 {
-	if(rect)
+	// expire by time to live, the list is ordered by last use, thus only
+	// expired entries are visited
+	while(cache->head && (*cache->clock + 1 - cache->head->frame >= cache->ttl) )
 	{
-		rect->x = core->bitmap.x0;
-		rect->y = core->bitmap.y0;
-		rect->w = core->bitmap.x1 - core->bitmap.x0;
-		rect->h = core->bitmap.y1 - core->bitmap.y0;
+#ifdef D2TK_DEBUG
+		fprintf(stderr, "\tgc cache (%016"PRIx64")\n", cache->head->hash);
+#endif
+		_d2tk_cache_remove(core, cache, cache->head);
+		cache->evictions++;
 	}
 
-	return core->bitmap.pixels;
-}
-
-static bool
-_d2tk_bitmap_query(d2tk_core_t *core, d2tk_body_bbox_t *body)
-{
-	const d2tk_clip_t *clip = &body->clip;
-
-	d2tk_clip_t dst;
-	_d2tk_clip_clip(core, &dst, clip);
+	// evict least recently used above budget, but never what this frame uses
+	while( (cache->bytes > cache->budget) && cache->head
+		&& (cache->head->frame != *cache->clock) )
+	{
+#ifdef D2TK_DEBUG
+		fprintf(stderr, "\tevict cache (%016"PRIx64")\n", cache->head->hash);
+#endif
+		_d2tk_cache_remove(core, cache, cache->head);
+		cache->evictions++;
+	}
 
-	for(d2tk_coord_t y = dst.y0, Y = y*core->w; y < dst.y1; y++, Y+=core->w)
+	// shrink below load factor of 1/4
+	if(cache->nslots > (1U << _D2TK_CACHE_LOG2_MIN) )
 	{
-		for(d2tk_coord_t x = dst.x0; x < dst.x1; x++)
+		if(!cache->nentries)
 		{
-			if(core->bitmap.pixels[Y + x])
-			{
-				body->dirty = true;
-				return true;
-			}
+			free(cache->slots);
+
+			cache->slots = NULL;
+			cache->nslots = 0;
+			cache->shift = 0;
+		}
+		else if(cache->nentries * 4 < cache->nslots)
+		{
+			_d2tk_cache_rehash(cache, _d2tk_cache_log2(cache) - 1);
+		}
+	}
+}
+
+static void
+_d2tk_sprite_release(d2tk_core_t *core, d2tk_cache_entry_t *entry)
+{
+	core->driver->sprite_free(core->data, entry->type, entry->body);
+}
+
+static void
+_d2tk_memcache_release(d2tk_core_t *core __attribute__((unused)),
+	d2tk_cache_entry_t *entry)
+{
+	d2tk_widget_body_t *body = (d2tk_widget_body_t *)entry->body;
+
+	free(body);
+}
+
+static void
+_d2tk_atom_release(d2tk_core_t *core __attribute__((unused)),
+	d2tk_cache_entry_t *entry)
+{
+	void *body = (void *)entry->body;
+
+	free(body);
+}
+
+#ifdef D2TK_DEBUG
+static void
+_d2tk_verify_release(d2tk_core_t *core __attribute__((unused)),
+	d2tk_cache_entry_t *entry)
+{
+	d2tk_widget_body_t *body = (d2tk_widget_body_t *)entry->body;
+
+	free(body);
+}
+
+// make sure equal bbox hashes never stand for different instructions
+static void
+_d2tk_core_verify(d2tk_core_t *core, uint64_t hash, const uint8_t *buf,
+	size_t len)
+{
+	uintptr_t *verify = _d2tk_cache_get(&core->verifies, hash, 0);
+	assert(verify);
+
+	if(*verify)
+	{
+		const d2tk_widget_body_t *body = (const d2tk_widget_body_t *)*verify;
+
+		if( (body->size != len) || memcmp(body->buf, buf, len) )
+		{
+			fprintf(stderr, "\thash collision (%016"PRIx64")\n", hash);
+			assert(false);
+		}
+
+		return;
+	}
+
+	d2tk_widget_body_t *body = malloc(sizeof(d2tk_widget_body_t) + len);
+	if(body)
+	{
+		body->size = len;
+		memcpy(body->buf, buf, len);
+
+		*verify = (uintptr_t)body;
+		_d2tk_cache_account(&core->verifies, verify,
+			sizeof(d2tk_widget_body_t) + len);
+	}
+}
+#endif
+
+// static names, e.g. for trace events
+const char *
+d2tk_instr_name(uint32_t instr)
+{
+	static const char *names [] = {
+		[D2TK_INSTR_LINE_TO] = "line_to",
+		[D2TK_INSTR_MOVE_TO] = "move_to",
+		[D2TK_INSTR_RECT] = "rect",
+		[D2TK_INSTR_ROUNDED_RECT] = "rounded_rect",
+		[D2TK_INSTR_ARC] = "arc",
+		[D2TK_INSTR_CURVE_TO] = "curve_to",
+		[D2TK_INSTR_COLOR] = "color",
+		[D2TK_INSTR_LINEAR_GRADIENT] = "linear_gradient",
+		[D2TK_INSTR_ROTATE] = "rotate",
+		[D2TK_INSTR_STROKE] = "stroke",
+		[D2TK_INSTR_FILL] = "fill",
+		[D2TK_INSTR_SAVE] = "save",
+		[D2TK_INSTR_RESTORE] = "restore",
+		[D2TK_INSTR_BBOX] = "bbox",
+		[D2TK_INSTR_BEGIN_PATH] = "begin_path",
+		[D2TK_INSTR_CLOSE_PATH] = "close_path",
+		[D2TK_INSTR_SCISSOR] = "scissor",
+		[D2TK_INSTR_RESET_SCISSOR] = "reset_scissor",
+		[D2TK_INSTR_FONT_SIZE] = "font_size",
+		[D2TK_INSTR_FONT_FACE] = "font_face",
+		[D2TK_INSTR_TEXT] = "text",
+		[D2TK_INSTR_IMAGE] = "image",
+		[D2TK_INSTR_BITMAP] = "bitmap",
+		[D2TK_INSTR_CUSTOM] = "custom",
+		[D2TK_INSTR_STROKE_WIDTH] = "stroke_width"
+	};
+
+	if( (instr >= sizeof(names)/sizeof(names[0])) || !names[instr])
+	{
+		return "unknown";
+	}
+
+	return names[instr];
+}
+
+uintptr_t *
+d2tk_core_get_sprite(d2tk_core_t *core, uint64_t hash, uint8_t type)
+{
+	return _d2tk_cache_get(&core->sprites, hash, type);
+}
+
+void
+d2tk_core_set_sprite_size(d2tk_core_t *core, uintptr_t *sprite, size_t size)
+{
+	_d2tk_cache_account(&core->sprites, sprite, size);
+}
+
+uintptr_t *
+d2tk_core_get_layout(d2tk_core_t *core, uint64_t hash, uint8_t type)
+{
+	return _d2tk_cache_get(&core->layouts, hash, type);
+}
+
+void
+d2tk_core_set_layout_size(d2tk_core_t *core, uintptr_t *layout, size_t size)
+{
+	_d2tk_cache_account(&core->layouts, layout, size);
+}
+
+void *
+d2tk_core_get_atom(d2tk_core_t *core, uint64_t id, uint8_t type, size_t size)
+{
+	uintptr_t *atom = _d2tk_cache_get(&core->atoms, id, type);
+
+	if(!atom)
+	{
+		return NULL;
+	}
+
+	if(!*atom)
+	{
+		void *body = calloc(1, size);
+
+		if(!body)
+		{
+			return NULL;
+		}
+
+		*atom = (uintptr_t)body;
+		_d2tk_cache_account(&core->atoms, atom, size);
+	}
+
+	return (void *)*atom;
+}
+
+size_t
+d2tk_core_get_sprite_budget(d2tk_core_t *core, size_t *used)
+{
+	if(used)
+	{
+		*used = core->sprites.bytes;
+	}
+
+	return core->sprites.budget;
+}
+
+static inline void
+_d2tk_mem_init(d2tk_mem_t *mem, size_t size)
+{
+	mem->size = size;
+	mem->offset = 0;
+	mem->used = size; // not zeroed, yet
+	mem->peak = 0;
+	mem->frames = 0;
+	mem->grows = 0;
+	mem->buf = malloc(mem->size);
+}
+
+static inline void
+_d2tk_mem_deinit(d2tk_mem_t *mem)
+{
+	mem->size = 0;
+	mem->offset = 0;
+	mem->used = 0;
+	mem->peak = 0;
+	mem->frames = 0;
+	mem->grows = 0;
+	free(mem->buf);
+	mem->buf = NULL;
+}
+
+static inline void
+_d2tk_mem_reset(d2tk_mem_t *mem)
+{
+	// only clear what the last frame has touched
+	memset(mem->buf, 0x0, mem->used);
+	mem->offset = 0;
+	mem->used = 0;
+}
+
+static inline uintptr_t *
+_d2tk_core_get_memcache(d2tk_core_t *core, uint64_t hash)
+{
+	return _d2tk_cache_get(&core->memcaches, hash, 0);
+}
+
+static inline void
+_d2tk_bitmap_resize(d2tk_core_t *core, d2tk_coord_t w, d2tk_coord_t h)
+{
+	d2tk_bitmap_t *bitmap = &core->bitmap;
+
+	const d2tk_coord_t cols = (w + (1 << _D2TK_TILE_SHIFT) - 1) >> _D2TK_TILE_SHIFT;
+
+	bitmap->stride = (cols + _D2TK_TILE_WORD - 1) / _D2TK_TILE_WORD;
+	bitmap->rows = (h + (1 << _D2TK_TILE_SHIFT) - 1) >> _D2TK_TILE_SHIFT;
+	bitmap->tiles = realloc(bitmap->tiles,
+		bitmap->rows*bitmap->stride*sizeof(uint64_t));
+	memset(bitmap->tiles, 0x0, bitmap->rows*bitmap->stride*sizeof(uint64_t));
+}
+
+static inline void
+_d2tk_bitmap_deinit(d2tk_bitmap_t *bitmap)
+{
+	free(bitmap->tiles);
+	bitmap->tiles = NULL;
+	free(bitmap->rects);
+	bitmap->rects = NULL;
+	bitmap->stride = 0;
+	bitmap->rows = 0;
+	bitmap->nrects = 0;
+	bitmap->maxrects = 0;
+	bitmap->nfills = 0;
+}
+
+static inline void
+_d2tk_bitmap_reset(d2tk_core_t *core)
+{
+	d2tk_bitmap_t *bitmap = &core->bitmap;
+
+	if(bitmap->nfills)
+	{
+		memset(bitmap->tiles, 0x0, bitmap->rows*bitmap->stride*sizeof(uint64_t));
+	}
+
+	bitmap->nrects = 0;
+	bitmap->nfills = 0;
+	bitmap->x0 = INT_MAX;
+	bitmap->x1 = INT_MIN;
+	bitmap->y0 = INT_MAX;
+	bitmap->y1 = INT_MIN;
+}
+
+static inline void
+_d2tk_clip_clip(d2tk_core_t *core, d2tk_clip_t *dst, const d2tk_clip_t *src)
+{
+	*dst = *src;
+
+	if(dst->x0 < 0)
+	{
+		dst->x0 = 0;
+	}
+	if(dst->x1 < 0)
+	{
+		dst->x1 = 0;
+	}
+
+	if(dst->y0 < 0)
+	{
+		dst->y0 = 0;
+	}
+	if(dst->y1 < 0)
+	{
+		dst->y1 = 0;
+	}
+
+	if(dst->x0 >= core->w)
+	{
+		dst->x0 = core->w - 1;
+	}
+	if(dst->x1 > core->w) // exclusive
+	{
+		dst->x1 = core->w;
+	}
+
+	if(dst->y0 >= core->h)
+	{
+		dst->y0 = core->h - 1;
+	}
+	if(dst->y1 > core->h) // exclusive
+	{
+		dst->y1 = core->h;
+	}
+}
+
+// bits of tile columns tx0..tx1 (inclusive) falling into word i
+static inline uint64_t
+_d2tk_bitmap_mask(d2tk_coord_t tx0, d2tk_coord_t tx1, d2tk_coord_t i)
+{
+	const d2tk_coord_t lo = i*_D2TK_TILE_WORD;
+	const d2tk_coord_t hi = lo + _D2TK_TILE_WORD - 1;
+
+	if( (tx1 < lo) || (tx0 > hi) )
+	{
+		return 0;
+	}
+
+	const unsigned b0 = tx0 > lo ? tx0 - lo : 0;
+	const unsigned b1 = tx1 < hi ? tx1 - lo : _D2TK_TILE_WORD - 1;
+
+	return (UINT64_MAX >> (_D2TK_TILE_WORD - 1 - b1 + b0)) << b0;
+}
+
+static inline void
+_d2tk_bitmap_fill(d2tk_core_t *core, const d2tk_clip_t *clip)
+{
+	d2tk_bitmap_t *bitmap = &core->bitmap;
+
+	d2tk_clip_t dst;
+	_d2tk_clip_clip(core, &dst, clip);
+
+	if( (dst.x1 > dst.x0) && (dst.y1 > dst.y0) )
+	{
+		const d2tk_coord_t tx0 = dst.x0 >> _D2TK_TILE_SHIFT;
+		const d2tk_coord_t tx1 = (dst.x1 - 1) >> _D2TK_TILE_SHIFT;
+		const d2tk_coord_t ty0 = dst.y0 >> _D2TK_TILE_SHIFT;
+		const d2tk_coord_t ty1 = (dst.y1 - 1) >> _D2TK_TILE_SHIFT;
+
+		for(d2tk_coord_t i = tx0 / _D2TK_TILE_WORD; i <= tx1 / _D2TK_TILE_WORD; i++)
+		{
+			const uint64_t mask = _d2tk_bitmap_mask(tx0, tx1, i);
+
+			for(d2tk_coord_t ty = ty0; ty <= ty1; ty++)
+			{
+				bitmap->tiles[ty*bitmap->stride + i] |= mask;
+			}
+		}
+	}
+
+	// update area of interest
+	if(dst.x0 < bitmap->x0)
+	{
+		bitmap->x0 = dst.x0;
+	}
+
+	if(dst.x1 > bitmap->x1)
+	{
+		bitmap->x1 = dst.x1;
+	}
+
+	if(dst.y0 < bitmap->y0)
+	{
+		bitmap->y0 = dst.y0;
+	}
+
+	if(dst.y1 > bitmap->y1)
+	{
+		bitmap->y1 = dst.y1;
+	}
+
+	bitmap->nfills++;
+}
+
+static inline void
+_d2tk_bitmap_rects_append(d2tk_bitmap_t *bitmap, const d2tk_rect_t *rect)
+{
+	if(bitmap->nrects == bitmap->maxrects)
+	{
+		const unsigned maxrects = bitmap->maxrects ? bitmap->maxrects << 1 : 16;
+		d2tk_rect_t *rects = realloc(bitmap->rects, maxrects*sizeof(d2tk_rect_t));
+		assert(rects);
+
+		bitmap->rects = rects;
+		bitmap->maxrects = maxrects;
+	}
+
+	bitmap->rects[bitmap->nrects++] = *rect;
+}
+
+// merge runs of dirty tiles to rectangles clipped to area of interest
+static void
+_d2tk_bitmap_rects(d2tk_core_t *core, const d2tk_clip_t *aoi)
+{
+	d2tk_bitmap_t *bitmap = &core->bitmap;
+	const d2tk_coord_t tile = 1 << _D2TK_TILE_SHIFT;
+	const d2tk_coord_t cols = bitmap->stride * _D2TK_TILE_WORD;
+
+	bitmap->nrects = 0;
+
+	for(d2tk_coord_t ty = aoi->y0 / tile; ty * tile < aoi->y1; ty++)
+	{
+		const uint64_t *row = &bitmap->tiles[ty*bitmap->stride];
+
+		const d2tk_coord_t y0 = ty*tile < aoi->y0 ? aoi->y0 : ty*tile;
+		const d2tk_coord_t y1 = (ty + 1)*tile > aoi->y1 ? aoi->y1 : (ty + 1)*tile;
+
+		for(d2tk_coord_t tx = aoi->x0 / tile; (tx < cols) && (tx * tile < aoi->x1); )
+		{
+			if(!(row[tx / _D2TK_TILE_WORD] & (UINT64_C(1) << (tx % _D2TK_TILE_WORD))))
+			{
+				tx++;
+				continue;
+			}
+
+			d2tk_coord_t tx1 = tx + 1;
+
+			while( (tx1 < cols) && (tx1 * tile < aoi->x1)
+				&& (row[tx1 / _D2TK_TILE_WORD] & (UINT64_C(1) << (tx1 % _D2TK_TILE_WORD))) )
+			{
+				tx1++;
+			}
+
+			const d2tk_coord_t x0 = tx*tile < aoi->x0 ? aoi->x0 : tx*tile;
+			const d2tk_coord_t x1 = tx1*tile > aoi->x1 ? aoi->x1 : tx1*tile;
+			bool merged = false;
+
+			// extend identical run of previous row of tiles
+			for(unsigned i = 0; i < bitmap->nrects; i++)
+			{
+				d2tk_rect_t *rect = &bitmap->rects[i];
+
+				if( (rect->x == x0) && (rect->w == x1 - x0) && (rect->y + rect->h == y0) )
+				{
+					rect->h += y1 - y0;
+					merged = true;
+					break;
+				}
+			}
+
+			if(!merged)
+			{
+				_d2tk_bitmap_rects_append(bitmap, &D2TK_RECT(x0, y0, x1 - x0, y1 - y0));
+			}
+
+			tx = tx1;
+		}
+	}
+}
+
+static void
+_d2tk_bbox_mask(d2tk_core_t *core, d2tk_com_t *com)
+{
+	d2tk_body_bbox_t *body = &com->body->bbox;
+
+	if(body->container)
+	{
+		D2TK_COM_FOREACH(com, bbox)
+		{
+			_d2tk_bbox_mask(core, bbox);
+		}
+	}
+	else
+	{
+		_d2tk_bitmap_fill(core, &body->clip);
+	}
+
+	body->dirty = true;
+}
+
+D2TK_API const d2tk_rect_t *
+d2tk_core_get_dirty_rects(d2tk_core_t *core, unsigned *nrects)
+{
+	*nrects = core->bitmap.nrects;
+
+	return core->bitmap.rects;
+}
+
+static bool
+_d2tk_bitmap_query(d2tk_core_t *core, d2tk_body_bbox_t *body)
+{
+	const d2tk_bitmap_t *bitmap = &core->bitmap;
+	const d2tk_clip_t *clip = &body->clip;
+
+	d2tk_clip_t dst;
+	_d2tk_clip_clip(core, &dst, clip);
+
+	if( (dst.x1 <= dst.x0) || (dst.y1 <= dst.y0) )
+	{
+		return false;
+	}
+
+	const d2tk_coord_t tx0 = dst.x0 >> _D2TK_TILE_SHIFT;
+	const d2tk_coord_t tx1 = (dst.x1 - 1) >> _D2TK_TILE_SHIFT;
+	const d2tk_coord_t ty0 = dst.y0 >> _D2TK_TILE_SHIFT;
+	const d2tk_coord_t ty1 = (dst.y1 - 1) >> _D2TK_TILE_SHIFT;
+
+	for(d2tk_coord_t i = tx0 / _D2TK_TILE_WORD; i <= tx1 / _D2TK_TILE_WORD; i++)
+	{
+		const uint64_t mask = _d2tk_bitmap_mask(tx0, tx1, i);
+
+		for(d2tk_coord_t ty = ty0; ty <= ty1; ty++)
+		{
+			if(bitmap->tiles[ty*bitmap->stride + i] & mask)
+			{
+				body->dirty = true;
+				return true;
+			}
 		}
 	}
 
@@ -544,14 +1104,25 @@ _d2tk_bitmap_query(d2tk_core_t *core, d2tk_body_bbox_t *body)
 static inline void
 _d2tk_mem_compact(d2tk_mem_t *mem)
 {
-	if(mem->offset == 0)
+	if(mem->offset > mem->peak)
+	{
+		mem->peak = mem->offset;
+	}
+
+	// shrink with hysteresis, only after a whole window of small frames
+	if(++mem->frames < _D2TK_MEM_SHRINK_FRAMES)
 	{
 		return;
 	}
 
-	for(size_t nsize = (mem->size >> 1);
-		mem->offset <= nsize;
-		nsize >>= 1)
+	size_t nsize = mem->size;
+
+	while( (nsize > _D2TK_MEM_SIZE_MIN) && (mem->peak <= (nsize >> 2)) )
+	{
+		nsize >>= 1;
+	}
+
+	if(nsize != mem->size)
 	{
 		uint8_t *nbuf = realloc(mem->buf, nsize);
 		assert(nbuf);
@@ -559,6 +1130,9 @@ _d2tk_mem_compact(d2tk_mem_t *mem)
 		mem->buf = nbuf;
 		mem->size = nsize;
 	}
+
+	mem->peak = 0;
+	mem->frames = 0;
 }
 
 static d2tk_com_t *
@@ -571,18 +1145,33 @@ static inline uint8_t *
 _d2tk_mem_append_request(d2tk_mem_t *mem, size_t len)
 {
 	const size_t padlen = D2TK_PAD_SIZE(len);
+	const size_t msize = mem->offset + padlen;
 
-	for(size_t msize = mem->offset + padlen, nsize = (mem->size << 1);
-		mem->size < msize;
-		nsize <<= 1)
+	if(mem->size < msize)
 	{
+		size_t nsize = mem->size << 1;
+
+		while(nsize < msize)
+		{
+			nsize <<= 1;
+		}
+
 		uint8_t *nbuf = realloc(mem->buf, nsize);
-		assert(nbuf);
+		if(!nbuf)
+		{
+			return NULL; // out of memory, buffer stays as is
+		}
 
-		memset(&nbuf[mem->size], 0x0, mem->size);
+		memset(&nbuf[mem->size], 0x0, nsize - mem->size);
 
 		mem->buf = nbuf;
 		mem->size = nsize;
+		mem->grows++;
+	}
+
+	if(msize > mem->used)
+	{
+		mem->used = msize;
 	}
 
 	return &mem->buf[mem->offset];
@@ -772,7 +1361,6 @@ void
 d2tk_core_set_bg_color(d2tk_core_t *core, uint32_t rgba)
 {
 	core->bg_color = htonl(rgba);
-	_d2tk_bitmap_template_refill(core);
 }
 
 uint32_t
@@ -874,6 +1462,7 @@ d2tk_core_widget_begin(d2tk_core_t *core, uint64_t hash, d2tk_widget_t *widget)
 		{
 			memcpy(dst, body->buf, body->size);
 			_d2tk_mem_append_advance(mem, body->size);
+			core->stats.bboxes += body->bboxes;
 		}
 
 		widget->ref = 0;
@@ -886,6 +1475,7 @@ d2tk_core_widget_begin(d2tk_core_t *core, uint64_t hash, d2tk_widget_t *widget)
 	const size_t ref = mem->offset;
 
 	widget->ref = ref;
+	widget->bboxes = core->stats.bboxes;
 
 	return widget;
 }
@@ -911,10 +1501,12 @@ d2tk_core_widget_next(d2tk_core_t *core, d2tk_widget_t *widget)
 	if(body)
 	{
 		body->size = buf_sz;
+		body->bboxes = core->stats.bboxes - widget->bboxes;
 		memcpy(body->buf, &mem->buf[widget->ref], buf_sz);
 
 		// actually store in cache
 		*widget->body = (uintptr_t)body;
+		_d2tk_cache_account(&core->memcaches, widget->body, body_sz);
 	}
 
 	return NULL;
@@ -931,6 +1523,8 @@ _d2tk_core_bbox_push(d2tk_core_t *core, bool cached, bool container,
 
 	if(body)
 	{
+		core->stats.bboxes++;
+
 		body->bbox.hash = 0;
 		body->bbox.cached = cached;
 		body->bbox.container = container;
@@ -974,8 +1568,12 @@ d2tk_core_bbox_pop(d2tk_core_t *core, ssize_t ref)
 
 	com->size = len - sizeof(d2tk_com_t);
 	// hash over instructions exclusive position
-	com->body->bbox.hash = d2tk_hash(&com->body->bbox.clip.w,
-		len - offsetof(d2tk_clip_t, w));
+	const uint8_t *start = (const uint8_t *)&com->body->bbox.clip.w;
+	const size_t hash_len = (const uint8_t *)com + len - start;
+	com->body->bbox.hash = d2tk_hash(start, hash_len);
+#ifdef D2TK_DEBUG
+	_d2tk_core_verify(core, com->body->bbox.hash, start, hash_len);
+#endif
 
 	core->ref.x = 0;
 	core->ref.y = 0;
@@ -1124,9 +1722,27 @@ d2tk_core_bitmap(d2tk_core_t *core, const d2tk_rect_t *rect, uint32_t w,
 	}
 }
 
+static inline uint64_t
+_d2tk_custom_hash(uint32_t size, const void *data, uint64_t rev)
+{
+	if(!rev)
+	{
+		return d2tk_hash(data, size);
+	}
+
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, &data, sizeof(data));
+	d2tk_hasher_update_u32(&hasher, size);
+	d2tk_hasher_update_u64(&hasher, rev);
+
+	return d2tk_hasher_final(&hasher);
+}
+
 D2TK_API void
 d2tk_core_custom(d2tk_core_t *core, const d2tk_rect_t *rect, uint32_t size,
-	const void *data, d2tk_core_custom_t custom)
+	const void *data, uint64_t rev, d2tk_core_custom_t custom)
 {
 	const size_t len = sizeof(d2tk_body_custom_t);
 	d2tk_body_t *body = _d2tk_append_request(core, len, D2TK_INSTR_CUSTOM);
@@ -1139,6 +1755,7 @@ d2tk_core_custom(d2tk_core_t *core, const d2tk_rect_t *rect, uint32_t size,
 		body->custom.h = rect->h;
 		body->custom.size = size;
 		body->custom.data = data;
+		body->custom.hash = _d2tk_custom_hash(size, data, rev);
 		body->custom.custom = custom;
 
 		body->custom.x -= core->ref.x;
@@ -1248,11 +1865,202 @@ _d2tk_com_equal(const d2tk_com_t *curcom, const d2tk_com_t *oldcom,
 	return false;
 }
 
+static inline bool
+_d2tk_com_equal_container(const d2tk_com_t *curcom, const d2tk_com_t *oldcom)
+{
+	const d2tk_body_bbox_t *curbbox = &curcom->body->bbox;
+	const d2tk_body_bbox_t *oldbbox = &oldcom->body->bbox;
+
+	return (curcom->instr == oldcom->instr)
+		&& (curbbox->clip.x0 == oldbbox->clip.x0)
+		&& (curbbox->clip.y0 == oldbbox->clip.y0)
+		&& curbbox->container && oldbbox->container;
+}
+
+static inline uint64_t
+_d2tk_diff_key(const d2tk_com_t *com, bool container)
+{
+	const d2tk_body_bbox_t *bbox = &com->body->bbox;
+	uint64_t key = ( (uint64_t)(uint32_t)bbox->clip.x0 << 32)
+		| (uint32_t)bbox->clip.y0;
+
+	key ^= com->instr * UINT64_C(0xff51afd7ed558ccd);
+
+	if(!container)
+	{
+		key ^= bbox->hash ^ (com->size * UINT64_C(0xc4ceb9fe1a85ec53) );
+	}
+
+	return key * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+static inline bool
+_d2tk_diff_key_equal(const d2tk_com_t *curcom, const d2tk_com_t *oldcom,
+	bool container)
+{
+	return container
+		? _d2tk_com_equal_container(curcom, oldcom)
+		: _d2tk_com_equal(curcom, oldcom, false);
+}
+
+static inline void *
+_d2tk_diff_alloc(d2tk_mem_t *scratch, size_t len)
+{
+	void *ptr = &scratch->buf[scratch->offset];
+
+	scratch->offset += D2TK_PAD_SIZE(len);
+	assert(scratch->offset <= scratch->size);
+
+	return ptr;
+}
+
+// chain bboxes with equal keys in ascending order
+static void
+_d2tk_diff_index(d2tk_com_t **coms, uint32_t n, uint32_t *next,
+	d2tk_diff_slot_t *slots, uint32_t mask, bool container)
+{
+	for(uint32_t i = n; i-- > 0; )
+	{
+		const d2tk_com_t *com = coms[i];
+
+		if(container && !com->body->bbox.container)
+		{
+			continue;
+		}
+
+		for(uint32_t j = _d2tk_diff_key(com, container) & mask; ; j = (j + 1) & mask)
+		{
+			d2tk_diff_slot_t *slot = &slots[j];
+
+			if(!slot->first)
+			{
+				next[i] = 0;
+				slot->first = slot->cursor = i + 1;
+				break;
+			}
+
+			if(_d2tk_diff_key_equal(coms[slot->first - 1], com, container))
+			{
+				next[i] = slot->first;
+				slot->first = slot->cursor = i + 1;
+				break;
+			}
+		}
+	}
+}
+
+// find first matching bbox at or after index from
+static uint32_t
+_d2tk_diff_find(d2tk_com_t **coms, const uint32_t *next,
+	d2tk_diff_slot_t *slots, uint32_t mask, const d2tk_com_t *oldcom,
+	bool container, uint32_t from)
+{
+	for(uint32_t j = _d2tk_diff_key(oldcom, container) & mask; ; j = (j + 1) & mask)
+	{
+		d2tk_diff_slot_t *slot = &slots[j];
+
+		if(!slot->first)
+		{
+			return 0;
+		}
+
+		if(_d2tk_diff_key_equal(coms[slot->first - 1], oldcom, container))
+		{
+			// cursors only ever move forward, as from does
+			while(slot->cursor && (slot->cursor - 1 < from) )
+			{
+				slot->cursor = next[slot->cursor - 1];
+			}
+
+			return slot->cursor;
+		}
+	}
+}
+
+static inline void
+_d2tk_diff_appeared(d2tk_core_t *core, d2tk_com_t *curcom2)
+{
+#ifdef D2TK_DEBUG
+	d2tk_body_bbox_t *curbbox2 = &curcom2->body->bbox;
+
+	fprintf(stderr,
+		"\t   appeared (%i %i %i %i %i %i 0x%016"PRIx64")\n",
+		curbbox2->clip.x0, curbbox2->clip.y0,
+		curbbox2->clip.x1, curbbox2->clip.y1,
+		curcom2->size, curcom2->instr,
+		curbbox2->hash);
+#endif
+
+	core->stats.appeared++;
+	_d2tk_bbox_mask(core, curcom2);
+}
+
+// upper bound of scratch memory needed to diff a frame of given size
+static inline size_t
+_d2tk_diff_scratch_size(size_t offset)
+{
+	const size_t nbboxes = offset
+		/ (sizeof(d2tk_com_t) + D2TK_PAD_SIZE(sizeof(d2tk_body_bbox_t))) + 1;
+	const size_t per_bbox = sizeof(d2tk_com_t *) + 2*sizeof(uint32_t)
+		+ 2*4*sizeof(d2tk_diff_slot_t);
+	const size_t per_level = 2*2*sizeof(d2tk_diff_slot_t) + 5*8;
+
+	return nbboxes * (per_bbox + per_level);
+}
+
+/*
+ * old bboxes are matched in order against the first equal new bbox after the
+ * previous match, new bboxes skipped over have appeared, unmatched old bboxes
+ * have disappeared. new bboxes are indexed by key, so this is linear in the
+ * number of bboxes.
+ */
 static void
 _d2tk_diff(d2tk_core_t *core, d2tk_com_t *curcom_ref, d2tk_com_t *oldcom_ref)
 {
+	d2tk_mem_t *scratch = &core->scratch;
+	const size_t offset = scratch->offset;
+
+	uint32_t n = 0;
+	D2TK_COM_FOREACH(curcom_ref, curcom)
+	{
+		if(curcom->instr == D2TK_INSTR_BBOX)
+		{
+			n++;
+		}
+	}
+
+	uint32_t nslots = 2;
+	while(nslots < 2*n)
+	{
+		nslots <<= 1;
+	}
+	const uint32_t mask = nslots - 1;
+
+	d2tk_com_t **coms = _d2tk_diff_alloc(scratch, n*sizeof(d2tk_com_t *));
+	uint32_t *next = _d2tk_diff_alloc(scratch, n*sizeof(uint32_t));
+	uint32_t *cnext = _d2tk_diff_alloc(scratch, n*sizeof(uint32_t));
+	d2tk_diff_slot_t *slots = _d2tk_diff_alloc(scratch,
+		nslots*sizeof(d2tk_diff_slot_t));
+	d2tk_diff_slot_t *cslots = _d2tk_diff_alloc(scratch,
+		nslots*sizeof(d2tk_diff_slot_t));
+
+	memset(slots, 0x0, nslots*sizeof(d2tk_diff_slot_t));
+	memset(cslots, 0x0, nslots*sizeof(d2tk_diff_slot_t));
+
+	n = 0;
+	D2TK_COM_FOREACH(curcom_ref, curcom)
+	{
+		if(curcom->instr == D2TK_INSTR_BBOX)
+		{
+			coms[n++] = curcom;
+		}
+	}
+
+	_d2tk_diff_index(coms, n, next, slots, mask, false);
+	_d2tk_diff_index(coms, n, cnext, cslots, mask, true);
+
 	// look for (dis)appeared instructions
-	d2tk_com_t *tmpcom = d2tk_com_begin(curcom_ref);
+	uint32_t tmp = 0;
 
 	D2TK_COM_FOREACH(oldcom_ref, oldcom)
 	{
@@ -1261,93 +2069,370 @@ _d2tk_diff(d2tk_core_t *core, d2tk_com_t *curcom_ref, d2tk_com_t *oldcom_ref)
 			continue;
 		}
 
-		bool match = false;
+		// check for matching size, instruction, hash and position
+		uint32_t match = _d2tk_diff_find(coms, next, slots, mask, oldcom, false,
+			tmp);
 
-		D2TK_COM_FOREACH_FROM(curcom_ref, tmpcom, curcom)
+		if(oldcom->body->bbox.container)
 		{
-			if(curcom->instr != D2TK_INSTR_BBOX)
+			const uint32_t cmatch = _d2tk_diff_find(coms, cnext, cslots, mask,
+				oldcom, true, tmp);
+
+			if(cmatch && (!match || (cmatch < match) ) )
 			{
-				continue;
+				match = cmatch;
+			}
+		}
+
+		if(match)
+		{
+			d2tk_com_t *curcom = coms[match - 1];
+
+			for(uint32_t i = tmp; i < match - 1; i++)
+			{
+				_d2tk_diff_appeared(core, coms[i]);
+			}
+
+			if(curcom->body->bbox.container && oldcom->body->bbox.container)
+			{
+#ifdef D2TK_DEBUG
+				fprintf(stderr, "\t   comparing nested containers\n");
+#endif
+				_d2tk_diff(core, curcom, oldcom);
 			}
 
-			// check for matching size, instruction, hash and position
-			if(_d2tk_com_equal(curcom, oldcom, true))
+			tmp = match;
+		}
+		else
+		{
+#ifdef D2TK_DEBUG
+			d2tk_body_bbox_t *oldbbox = &oldcom->body->bbox;
+
+			fprintf(stderr,
+				"\tdisappeared (%i %i %i %i %i %i 0x%016"PRIx64")\n",
+				oldbbox->clip.x0, oldbbox->clip.y0,
+				oldbbox->clip.x1, oldbbox->clip.y1,
+				oldcom->size, oldcom->instr,
+				oldbbox->hash);
+#endif
+
+			core->stats.disappeared++;
+			_d2tk_bbox_mask(core, oldcom);
+		}
+	}
+
+	for(uint32_t i = tmp; i < n; i++)
+	{
+		_d2tk_diff_appeared(core, coms[i]);
+	}
+
+	scratch->offset = offset;
+}
+
+// feed the damaged parts of the command stream through the driver
+static void
+_d2tk_core_render(d2tk_core_t *core, d2tk_com_t *curcom, const d2tk_clip_t *aoi)
+{
+	static const char *pass_names [2] = { "pass 0", "pass 1" };
+
+	for(unsigned pass = 0; pass < 2; pass++)
+	{
+		const uint64_t t_pass = d2tk_trace_begin();
+		const uint64_t t0 = d2tk_trace_now();
+
+		core->driver->pre(core->data, core, core->w, core->h, pass);
+
+		D2TK_COM_FOREACH(curcom, com)
+		{
+			d2tk_body_bbox_t *body = &com->body->bbox;
+
+			if(pass == 0)
 			{
-				for(d2tk_com_t *curcom2 = tmpcom;
-					curcom2 != curcom;
-					curcom2 = d2tk_com_next(curcom2))
+				if(aoi && !body->dirty)
 				{
-					if(curcom2->instr != D2TK_INSTR_BBOX)
+					if(  ( (body->clip.x0 >= aoi->x1) || (aoi->x0 >= body->clip.x1) )
+						|| ( (body->clip.y0 >= aoi->y1) || (aoi->y0 >= body->clip.y1) ) )
+					{
+						continue; // not in area-of-interest
+					}
+
+					if(!_d2tk_bitmap_query(core, body))
 					{
 						continue;
 					}
+				}
+			}
+			else if(pass == 1)
+			{
+				if(aoi && !body->dirty)
+				{
+					continue; // not in area-of-interest
+				}
+			}
+
+			const d2tk_clip_t *clip = NULL;
+
+			if(aoi)
+			{
+				static d2tk_clip_t tmp;
+
+				// derive minimal intersecting rectangle
+				tmp.x0 = aoi->x0 < body->clip.x0
+					? body->clip.x0
+					: aoi->x0;
+				tmp.x1 = aoi->x1 > body->clip.x1
+					? body->clip.x1
+					: aoi->x1;
+				tmp.y0 = aoi->y0 < body->clip.y0
+					? body->clip.y0
+					: aoi->y0;
+				tmp.y1 = aoi->y1 > body->clip.y1
+					? body->clip.y1
+					: aoi->y1;
+				tmp.w = tmp.x1 - tmp.x0;
+				tmp.h = tmp.y1 - tmp.y0;
+
+#if 0 // seems not to be needed
+				if(pass == 0)
+				{
+					_d2tk_bitmap_fill(core, &tmp);
+				}
+#endif
+
+				clip = &tmp;
+			}
+
+			/*
+			fprintf(stderr, "=%li:%p= %i %i %i %i\n", i, (void *)body,
+				body->clip.x0, body->clip.y0, body->clip.w, body->clip.h);
+			if(clip)
+			{
+				fprintf(stderr, ":%li:%p: %i %i %i %i\n", i, (void *)body,
+					clip->x0, clip->y0, clip->x1 - clip->x0, clip->y1 - clip->y0);
+			}
+			*/
+
+			core->driver->process(core->data, core, com, body->clip.x0,
+				body->clip.y0, clip, pass);
+		}
+
+		const uint64_t t_drv = d2tk_trace_begin();
+		const bool again = core->driver->post(core->data, core, core->w, core->h,
+			pass);
+		d2tk_trace_end("d2tk", "driver post", t_drv);
+		d2tk_trace_end("d2tk", pass_names[pass], t_pass);
+
+		core->stats.passes++;
+		core->stats.pass_ns[pass] += d2tk_trace_now() - t0;
+
+		if(!again)
+		{
+			break; // does NOT need 2nd pass
+		}
+	}
+}
+
+static void
+_d2tk_recorded_release(d2tk_core_t *core __attribute__((unused)),
+	d2tk_cache_entry_t *entry __attribute__((unused)))
+{
+	// nothing to release, only the hash is of interest
+}
+
+static void
+_d2tk_replayed_release(d2tk_core_t *core __attribute__((unused)),
+	d2tk_cache_entry_t *entry)
+{
+	free((void *)entry->body);
+}
+
+// write what the command stream only references by pointer
+static bool
+_d2tk_record_payloads(d2tk_core_t *core, const d2tk_com_t *com, FILE *fout)
+{
+	D2TK_COM_FOREACH_CONST(com, sub)
+	{
+		switch(sub->instr)
+		{
+			case D2TK_INSTR_BBOX:
+			{
+				if(!_d2tk_record_payloads(core, sub, fout))
+				{
+					return false;
+				}
+			} break;
+			case D2TK_INSTR_BITMAP:
+			{
+				const d2tk_body_bitmap_surf_t *surf = &sub->body->bitmap.surf;
+				const uint64_t hash = d2tk_hash(surf, sizeof(d2tk_body_bitmap_surf_t));
+				uintptr_t *recorded = _d2tk_cache_get(&core->recorded, hash, 0);
 
-#ifdef D2TK_DEBUG
-					d2tk_body_bbox_t *curbbox2 = &curcom2->body->bbox;
-
-					fprintf(stderr,
-						"\t   appeared (%i %i %i %i %i %i 0x%08"PRIx32")\n",
-						curbbox2->clip.x0, curbbox2->clip.y0,
-						curbbox2->clip.x1, curbbox2->clip.y1,
-						curcom2->size, curcom2->instr,
-						curbbox2->hash);
-#endif
+				if(!recorded)
+				{
+					return false;
+				}
 
-					_d2tk_bbox_mask(core, curcom2);
+				if(*recorded) // pixels already in recording
+				{
+					break;
 				}
 
-				if(curcom->body->bbox.container && oldcom->body->bbox.container)
+				if(fwrite(surf->argb, surf->stride, surf->h, fout) != surf->h)
 				{
-#ifdef D2TK_DEBUG
-					fprintf(stderr, "\t   comparing nested containers\n");
-#endif
-					_d2tk_diff(core, curcom, oldcom);
+					return false;
 				}
 
-				match = true;
-				tmpcom = d2tk_com_next(curcom);
+				*recorded = 1;
+			} break;
+			case D2TK_INSTR_CUSTOM:
+			{
+				const d2tk_body_custom_t *body = &sub->body->custom;
+				static const uint8_t pad [8];
+				const size_t padlen = D2TK_PAD_SIZE(body->size) - body->size;
+
+				if(body->size && (fwrite(body->data, body->size, 1, fout) != 1) )
+				{
+					return false;
+				}
 
-				break;
-			}
+				if(padlen && (fwrite(pad, padlen, 1, fout) != 1) )
+				{
+					return false;
+				}
+			} break;
 		}
+	}
 
-		if(!match)
-		{
-#ifdef D2TK_DEBUG
-			d2tk_body_bbox_t *oldbbox = &oldcom->body->bbox;
+	return true;
+}
 
-			fprintf(stderr,
-				"\tdisappeared (%i %i %i %i %i %i 0x%08"PRIx32")\n",
-				oldbbox->clip.x0, oldbbox->clip.y0,
-				oldbbox->clip.x1, oldbbox->clip.y1,
-				oldcom->size, oldcom->instr,
-				oldbbox->hash);
-#endif
+static void
+_d2tk_core_record(d2tk_core_t *core, d2tk_mem_t *curmem, const d2tk_clip_t *aoi)
+{
+	const d2tk_bitmap_t *bitmap = &core->bitmap;
+	const uint64_t t_record = d2tk_trace_begin();
+	const d2tk_record_t rec = {
+		.magic = _D2TK_RECORD_MAGIC,
+		.version = _D2TK_RECORD_VERSION,
+		.w = core->w,
+		.h = core->h,
+		.bg_color = core->bg_color,
+		.full_refresh = core->full_refresh,
+		.aoi = aoi ? *aoi : (d2tk_clip_t){ .x0 = 0 },
+		.nrects = bitmap->nrects,
+		.size = curmem->offset
+	};
+
+	if(core->full_refresh) // complete frames carry all their pixels
+	{
+		_d2tk_cache_free(core, &core->recorded);
+	}
 
-			_d2tk_bbox_mask(core, oldcom);
-		}
+	if( (fwrite(&rec, sizeof(d2tk_record_t), 1, core->record) != 1)
+		|| (fwrite(bitmap->rects, sizeof(d2tk_rect_t), bitmap->nrects,
+				core->record) != bitmap->nrects)
+		|| (fwrite(curmem->buf, curmem->offset, 1, core->record) != 1)
+		|| !_d2tk_record_payloads(core, _d2tk_mem_get_com(curmem), core->record) )
+	{
+		fprintf(stderr, "[%s] recording failed, stopping it\n", __func__);
+		d2tk_core_set_record(core, NULL);
 	}
+	else
+	{
+		// the replayer drops expired pixels, thus write them again
+		_d2tk_cache_gc(core, &core->recorded);
+		core->records++;
+	}
+
+	d2tk_trace_end("d2tk", "record", t_record);
+}
+
+static void
+_d2tk_stats_add(d2tk_stats_t *dst, const d2tk_stats_t *src)
+{
+	dst->frames += src->frames;
+	dst->bytes += src->bytes;
+	dst->bboxes += src->bboxes;
+	dst->appeared += src->appeared;
+	dst->disappeared += src->disappeared;
+	dst->fills += src->fills;
+	dst->area += src->area;
+	dst->sprite_hits += src->sprite_hits;
+	dst->sprite_misses += src->sprite_misses;
+	dst->sprite_evictions += src->sprite_evictions;
+	dst->memcache_hits += src->memcache_hits;
+	dst->memcache_misses += src->memcache_misses;
+	dst->memcache_evictions += src->memcache_evictions;
+	dst->layout_hits += src->layout_hits;
+	dst->layout_misses += src->layout_misses;
+	dst->layout_evictions += src->layout_evictions;
+	dst->mem_grows += src->mem_grows;
+	dst->passes += src->passes;
+	dst->diff_ns += src->diff_ns;
+	dst->pass_ns[0] += src->pass_ns[0];
+	dst->pass_ns[1] += src->pass_ns[1];
+}
+
+// complete counters of current frame and start over
+static void
+_d2tk_core_stats(d2tk_core_t *core)
+{
+	d2tk_stats_t *stats = &core->stats;
+	const d2tk_bitmap_t *bitmap = &core->bitmap;
+
+	stats->frames = 1;
+	stats->bytes = core->mem[core->curmem].offset;
+	stats->fills = bitmap->nfills;
 
-	D2TK_COM_FOREACH_FROM(curcom_ref, tmpcom, curcom2)
+	for(unsigned i = 0; i < bitmap->nrects; i++)
 	{
-		if(curcom2->instr != D2TK_INSTR_BBOX)
-		{
-			continue;
-		}
+		const d2tk_rect_t *rect = &bitmap->rects[i];
 
-#ifdef D2TK_DEBUG
-		d2tk_body_bbox_t *curbbox2 = &curcom2->body->bbox;
+		stats->area += (uint64_t)rect->w * rect->h;
+	}
 
-		fprintf(stderr,
-			"\t   appeared (%i %i %i %i %i %i 0x%08"PRIx32")\n",
-			curbbox2->clip.x0, curbbox2->clip.y0,
-			curbbox2->clip.x1, curbbox2->clip.y1,
-			curcom2->size, curcom2->instr,
-			curbbox2->hash);
+	stats->sprite_hits = core->sprites.hits;
+	stats->sprite_misses = core->sprites.misses;
+	stats->sprite_evictions = core->sprites.evictions;
+	stats->memcache_hits = core->memcaches.hits;
+	stats->memcache_misses = core->memcaches.misses;
+	stats->memcache_evictions = core->memcaches.evictions;
+	stats->layout_hits = core->layouts.hits;
+	stats->layout_misses = core->layouts.misses;
+	stats->layout_evictions = core->layouts.evictions;
+	stats->mem_grows = core->mem[0].grows + core->mem[1].grows;
+
+	core->sprites.hits = core->sprites.misses = core->sprites.evictions = 0;
+	core->memcaches.hits = core->memcaches.misses = core->memcaches.evictions = 0;
+	core->layouts.hits = core->layouts.misses = core->layouts.evictions = 0;
+	core->mem[0].grows = core->mem[1].grows = 0;
+
+	core->last = *stats;
+	_d2tk_stats_add(&core->total, stats);
+	memset(stats, 0x0, sizeof(d2tk_stats_t));
+}
+
+// collect garbage and flip command streams at the end of a frame
+static void
+_d2tk_core_advance(d2tk_core_t *core)
+{
+	const uint64_t t_gc = d2tk_trace_begin();
+
+	_d2tk_cache_gc(core, &core->sprites);
+	_d2tk_cache_gc(core, &core->memcaches);
+	_d2tk_cache_gc(core, &core->layouts);
+	_d2tk_cache_gc(core, &core->atoms);
+#ifdef D2TK_DEBUG
+	_d2tk_cache_gc(core, &core->verifies);
 #endif
 
-		_d2tk_bbox_mask(core, curcom2);
-	}
+	d2tk_trace_end("d2tk", "gc", t_gc);
+
+	_d2tk_core_stats(core);
+
+	core->full_refresh = false;
+	core->curmem = !core->curmem;
+	core->frame++;
 }
 
 D2TK_API void
@@ -1356,6 +2441,7 @@ d2tk_core_post(d2tk_core_t *core)
 	d2tk_mem_t *oldmem = &core->mem[!core->curmem];
 	d2tk_mem_t *curmem = &core->mem[core->curmem];
 	d2tk_bitmap_t *bitmap = &core->bitmap;
+	const uint64_t t_post = d2tk_trace_begin();
 
 	d2tk_core_bbox_pop(core, core->parent);
 
@@ -1375,12 +2461,29 @@ d2tk_core_post(d2tk_core_t *core)
 			0, 0, core->w, core->h);
 #endif
 
-		_d2tk_sprites_free(core);
-		_d2tk_memcaches_free(core);
+		_d2tk_cache_free(core, &core->sprites);
+		_d2tk_cache_free(core, &core->memcaches);
+#ifdef D2TK_DEBUG
+		_d2tk_cache_free(core, &core->verifies);
+#endif
 	}
 	else if(!_d2tk_com_equal(curcom, oldcom, false))
 	{
+		const uint64_t t_diff = d2tk_trace_begin();
+		const uint64_t t0 = d2tk_trace_now();
+		const size_t scratch_sz = _d2tk_diff_scratch_size(curmem->offset);
+
+		if(core->scratch.size < scratch_sz)
+		{
+			_d2tk_mem_deinit(&core->scratch);
+			_d2tk_mem_init(&core->scratch, scratch_sz);
+			assert(core->scratch.buf);
+		}
+
 		_d2tk_diff(core, curcom, oldcom);
+
+		core->stats.diff_ns += d2tk_trace_now() - t0;
+		d2tk_trace_end("d2tk", "diff", t_diff);
 	}
 
 	if(bitmap->nfills || core->full_refresh)
@@ -1399,6 +2502,7 @@ d2tk_core_post(d2tk_core_t *core)
 			tmp.h = core->h;
 
 			_d2tk_bitmap_fill(core, &tmp);
+			_d2tk_bitmap_rects(core, &tmp);
 		}
 		else
 		{
@@ -1412,103 +2516,352 @@ d2tk_core_post(d2tk_core_t *core)
 			tmp.h = bitmap->y1 - bitmap->y0;
 
 			aoi = &tmp;
+			_d2tk_bitmap_rects(core, aoi);
 		}
 
 #ifdef D2TK_DEBUG
 		fprintf(stderr, "\tnfills: %zu\n", bitmap->nfills);
 #endif
-		for(unsigned pass = 0; pass < 2; pass++)
+		if(core->record)
+		{
+			_d2tk_core_record(core, curmem, aoi);
+		}
+
+		_d2tk_core_render(core, curcom, aoi);
+	}
+
+	_d2tk_core_advance(core);
+
+	d2tk_trace_end("d2tk", "d2tk_core_post", t_post);
+}
+
+static void
+_d2tk_replay_custom(void *ctx __attribute__((unused)),
+	uint32_t size __attribute__((unused)),
+	const void *data __attribute__((unused)))
+{
+	// recorded callbacks cannot be called back
+}
+
+// smallest body of each instruction, strings need a zero-terminator on top
+static const size_t _d2tk_replay_body_min [D2TK_INSTR_STROKE_WIDTH + 1] = {
+	[D2TK_INSTR_LINE_TO] = sizeof(d2tk_body_line_to_t),
+	[D2TK_INSTR_MOVE_TO] = sizeof(d2tk_body_move_to_t),
+	[D2TK_INSTR_RECT] = sizeof(d2tk_body_rect_t),
+	[D2TK_INSTR_ROUNDED_RECT] = sizeof(d2tk_body_rounded_rect_t),
+	[D2TK_INSTR_ARC] = sizeof(d2tk_body_arc_t),
+	[D2TK_INSTR_CURVE_TO] = sizeof(d2tk_body_curve_to_t),
+	[D2TK_INSTR_COLOR] = sizeof(d2tk_body_color_t),
+	[D2TK_INSTR_LINEAR_GRADIENT] = sizeof(d2tk_body_linear_gradient_t),
+	[D2TK_INSTR_ROTATE] = sizeof(d2tk_body_rotate_t),
+	[D2TK_INSTR_BBOX] = sizeof(d2tk_body_bbox_t),
+	[D2TK_INSTR_SCISSOR] = sizeof(d2tk_body_scissor_t),
+	[D2TK_INSTR_FONT_SIZE] = sizeof(d2tk_body_font_size_t),
+	[D2TK_INSTR_FONT_FACE] = offsetof(d2tk_body_font_face_t, face),
+	[D2TK_INSTR_TEXT] = offsetof(d2tk_body_text_t, text),
+	[D2TK_INSTR_IMAGE] = offsetof(d2tk_body_image_t, path),
+	[D2TK_INSTR_BITMAP] = sizeof(d2tk_body_bitmap_t),
+	[D2TK_INSTR_CUSTOM] = sizeof(d2tk_body_custom_t),
+	[D2TK_INSTR_STROKE_WIDTH] = sizeof(d2tk_body_stroke_width_t)
+};
+
+// recordings are untrusted, check nested sizes before anything walks them
+static bool
+_d2tk_replay_validate(const d2tk_com_t *com, unsigned depth, size_t *custom_sz)
+{
+	const uint8_t *end = (const uint8_t *)com + sizeof(d2tk_com_t) + com->size;
+	const uint8_t *bbox = (const uint8_t *)&com->body->bbox; // bools as bytes
+
+	if( (depth > _D2TK_REPLAY_DEPTH_MAX)
+		|| (com->size < D2TK_PAD_SIZE(sizeof(d2tk_body_bbox_t)))
+		|| (bbox[offsetof(d2tk_body_bbox_t, dirty)] > 1)
+		|| (bbox[offsetof(d2tk_body_bbox_t, cached)] > 1)
+		|| (bbox[offsetof(d2tk_body_bbox_t, container)] > 1) )
+	{
+		return false;
+	}
+
+	for(const uint8_t *ptr = (const uint8_t *)d2tk_com_begin_const(com);
+		ptr < end;
+		ptr += sizeof(d2tk_com_t) + D2TK_PAD_SIZE(((const d2tk_com_t *)ptr)->size))
+	{
+		const d2tk_com_t *sub = (const d2tk_com_t *)ptr;
+		const size_t avail = end - ptr;
+
+		if( (avail < sizeof(d2tk_com_t))
+			|| (sub->size > avail - sizeof(d2tk_com_t))
+			|| (sub->instr > D2TK_INSTR_STROKE_WIDTH)
+			|| (sub->size < _d2tk_replay_body_min[sub->instr]) )
 		{
-			core->driver->pre(core->data, core, core->w, core->h, pass);
+			return false;
+		}
 
-			d2tk_com_t *curcom = _d2tk_mem_get_com(curmem);
+		const size_t min = _d2tk_replay_body_min[sub->instr];
+		const char *str = (const char *)sub->body + min;
 
-			D2TK_COM_FOREACH(curcom, com)
+		switch(sub->instr)
+		{
+			case D2TK_INSTR_BBOX:
+			{
+				if(!_d2tk_replay_validate(sub, depth + 1, custom_sz))
+				{
+					return false;
+				}
+			} break;
+			case D2TK_INSTR_ARC:
 			{
-				d2tk_body_bbox_t *body = &com->body->bbox;
+				const uint8_t *arc = (const uint8_t *)&sub->body->arc;
 
-				if(pass == 0)
+				if(arc[offsetof(d2tk_body_arc_t, cw)] > 1)
 				{
-					if(aoi && !body->dirty)
-					{
-						if(  ( (body->clip.x0 >= aoi->x1) || (aoi->x0 >= body->clip.x1) )
-							|| ( (body->clip.y0 >= aoi->y1) || (aoi->y0 >= body->clip.y1) ) )
-						{
-							continue; // not in area-of-interest
-						}
-
-						if(!_d2tk_bitmap_query(core, body))
-						{
-							continue;
-						}
-					}
+					return false;
+				}
+			} break;
+			case D2TK_INSTR_FONT_FACE:
+				// fall-through
+			case D2TK_INSTR_TEXT:
+				// fall-through
+			case D2TK_INSTR_IMAGE:
+			{
+				if(!memchr(str, '\0', sub->size - min))
+				{
+					return false;
 				}
-				else if(pass == 1)
+			} break;
+			case D2TK_INSTR_BITMAP:
+			{
+				const d2tk_body_bitmap_surf_t *surf = &sub->body->bitmap.surf;
+
+				if( ((uint64_t)surf->w * sizeof(uint32_t) > surf->stride)
+					|| ((uint64_t)surf->stride * surf->h > _D2TK_REPLAY_SIZE_MAX) )
 				{
-					if(aoi && !body->dirty)
-					{
-						continue; // not in area-of-interest
-					}
+					return false;
+				}
+			} break;
+			case D2TK_INSTR_CUSTOM:
+			{
+				const uint32_t size = sub->body->custom.size;
+
+				if( (size > _D2TK_REPLAY_SIZE_MAX)
+					|| (*custom_sz + D2TK_PAD_SIZE(size) > _D2TK_REPLAY_SIZE_MAX) )
+				{
+					return false;
+				}
+
+				*custom_sz += D2TK_PAD_SIZE(size);
+			} break;
+		}
+	}
+
+	return true;
+}
+
+// read payloads back and point the command stream at them
+static bool
+_d2tk_replay_payloads(d2tk_core_t *core, d2tk_com_t *com, FILE *fin)
+{
+	D2TK_COM_FOREACH(com, sub)
+	{
+		switch(sub->instr)
+		{
+			case D2TK_INSTR_BBOX:
+			{
+				if(!_d2tk_replay_payloads(core, sub, fin))
+				{
+					return false;
 				}
+			} break;
+			case D2TK_INSTR_BITMAP:
+			{
+				d2tk_body_bitmap_surf_t *surf = &sub->body->bitmap.surf;
+				const uint64_t hash = d2tk_hash(surf, sizeof(d2tk_body_bitmap_surf_t));
+				uintptr_t *replayed = _d2tk_cache_get(&core->replayed, hash, 0);
 
-				const d2tk_clip_t *clip = NULL;
+				if(!replayed)
+				{
+					return false;
+				}
 
-				if(aoi)
+				if(!*replayed) // pixels not yet seen or expired
 				{
-					static d2tk_clip_t tmp;
-
-					// derive minimal intersecting rectangle
-					tmp.x0 = aoi->x0 < body->clip.x0
-						? body->clip.x0
-						: aoi->x0;
-					tmp.x1 = aoi->x1 > body->clip.x1
-						? body->clip.x1
-						: aoi->x1;
-					tmp.y0 = aoi->y0 < body->clip.y0
-						? body->clip.y0
-						: aoi->y0;
-					tmp.y1 = aoi->y1 > body->clip.y1
-						? body->clip.y1
-						: aoi->y1;
-					tmp.w = tmp.x1 - tmp.x0;
-					tmp.h = tmp.y1 - tmp.y0;
+					const size_t len = (size_t)surf->stride * surf->h;
+					void *argb = malloc(len ? len : 1);
 
-#if 0 // seems not to be needed
-					if(pass == 0)
+					if(!argb || (len && (fread(argb, len, 1, fin) != 1) ) )
 					{
-						_d2tk_bitmap_fill(core, &tmp);
+						free(argb);
+						return false;
 					}
-#endif
 
-					clip = &tmp;
+					*replayed = (uintptr_t)argb;
 				}
 
-				/*
-				fprintf(stderr, "=%li:%p= %i %i %i %i\n", i, (void *)body,
-					body->clip.x0, body->clip.y0, body->clip.w, body->clip.h);
-				if(clip)
+				surf->argb = (const uint32_t *)*replayed;
+			} break;
+			case D2TK_INSTR_CUSTOM:
+			{
+				d2tk_body_custom_t *body = &sub->body->custom;
+				const size_t padlen = D2TK_PAD_SIZE(body->size);
+				uint8_t *data = _d2tk_mem_append_request(&core->replay, padlen);
+
+				if(!data || (padlen && (fread(data, padlen, 1, fin) != 1) ) )
 				{
-					fprintf(stderr, ":%li:%p: %i %i %i %i\n", i, (void *)body,
-						clip->x0, clip->y0, clip->x1 - clip->x0, clip->y1 - clip->y0);
+					return false;
 				}
-				*/
 
-				core->driver->process(core->data, core, com, body->clip.x0,
-					body->clip.y0, clip, pass);
-			}
+				_d2tk_mem_append_advance(&core->replay, padlen);
 
-			if(!core->driver->post(core->data, core, core->w, core->h, pass))
-			{
-				break; // does NOT need 2nd pass
-			}
+				body->data = data;
+				body->custom = _d2tk_replay_custom;
+			} break;
 		}
 	}
 
-	_d2tk_sprites_gc(core);
-	_d2tk_memcaches_gc(core);
+	return true;
+}
 
-	core->full_refresh = false;
-	core->curmem = !core->curmem;
+D2TK_API int
+d2tk_core_replay(d2tk_core_t *core, FILE *fin)
+{
+	d2tk_mem_t *curmem = &core->mem[core->curmem];
+	d2tk_bitmap_t *bitmap = &core->bitmap;
+	d2tk_record_t rec;
+
+	if(fread(&rec, sizeof(d2tk_record_t), 1, fin) != 1)
+	{
+		return feof(fin) ? 1 : -1;
+	}
+
+	if( (rec.magic != _D2TK_RECORD_MAGIC) || (rec.version != _D2TK_RECORD_VERSION)
+		|| (rec.size < sizeof(d2tk_com_t)) || (rec.size > _D2TK_REPLAY_SIZE_MAX)
+		|| (rec.w < 0) || (rec.w > _D2TK_REPLAY_DIM_MAX)
+		|| (rec.h < 0) || (rec.h > _D2TK_REPLAY_DIM_MAX)
+		|| (rec.aoi.x0 < 0) || (rec.aoi.x0 > rec.aoi.x1) || (rec.aoi.x1 > rec.w)
+		|| (rec.aoi.y0 < 0) || (rec.aoi.y0 > rec.aoi.y1) || (rec.aoi.y1 > rec.h) )
+	{
+		return -1;
+	}
+
+	if( (rec.w != core->w) || (rec.h != core->h) )
+	{
+		d2tk_core_set_dimensions(core, rec.w, rec.h);
+	}
+
+	core->bg_color = rec.bg_color;
+	core->full_refresh = rec.full_refresh;
+
+	_d2tk_bitmap_reset(core);
+
+	for(uint32_t i = 0; i < rec.nrects; i++)
+	{
+		d2tk_rect_t rect;
+
+		if( (fread(&rect, sizeof(d2tk_rect_t), 1, fin) != 1)
+			|| (rect.x < 0) || (rect.w < 0) || (rect.w > rec.w - rect.x)
+			|| (rect.y < 0) || (rect.h < 0) || (rect.h > rec.h - rect.y) )
+		{
+			return -1;
+		}
+
+		const d2tk_clip_t clip = {
+			.x0 = rect.x,
+			.y0 = rect.y,
+			.x1 = rect.x + rect.w,
+			.y1 = rect.y + rect.h,
+			.w = rect.w,
+			.h = rect.h
+		};
+
+		_d2tk_bitmap_fill(core, &clip);
+	}
+
+	_d2tk_mem_reset(curmem);
+	uint8_t *buf = _d2tk_mem_append_request(curmem, rec.size);
+
+	if(!buf || (fread(buf, rec.size, 1, fin) != 1) )
+	{
+		return -1;
+	}
+
+	_d2tk_mem_append_advance(curmem, rec.size);
+
+	d2tk_com_t *curcom = _d2tk_mem_get_com(curmem);
+	size_t custom_sz = 0;
+
+	if( (curcom->instr != D2TK_INSTR_BBOX)
+		|| (sizeof(d2tk_com_t) + curcom->size > rec.size)
+		|| !_d2tk_replay_validate(curcom, 0, &custom_sz) )
+	{
+		return -1;
+	}
+
+	// custom payloads must not move while appended, thus reserve upfront
+	if(core->replay.size < custom_sz)
+	{
+		_d2tk_mem_deinit(&core->replay);
+		_d2tk_mem_init(&core->replay, custom_sz);
+
+		if(!core->replay.buf)
+		{
+			_d2tk_mem_deinit(&core->replay);
+			return -1;
+		}
+	}
+
+	core->replay.offset = 0; // payloads are read over, no need to zero
+
+	if(rec.full_refresh) // complete frames carry all their pixels
+	{
+		_d2tk_cache_free(core, &core->replayed);
+	}
+
+	if(!_d2tk_replay_payloads(core, curcom, fin))
+	{
+		return -1;
+	}
+
+	// same expiry as in recorder, which has written expired pixels again
+	_d2tk_cache_gc(core, &core->replayed);
+	core->records++;
+
+	const d2tk_clip_t *aoi = NULL;
+
+	if(core->full_refresh)
+	{
+		const d2tk_clip_t tmp = {
+			.x0 = 0,
+			.y0 = 0,
+			.x1 = core->w,
+			.y1 = core->h,
+			.w = core->w,
+			.h = core->h
+		};
+
+		_d2tk_cache_free(core, &core->sprites);
+		_d2tk_cache_free(core, &core->memcaches);
+
+		_d2tk_bitmap_fill(core, &tmp);
+		_d2tk_bitmap_rects(core, &tmp);
+	}
+	else
+	{
+		static d2tk_clip_t tmp;
+
+		tmp = rec.aoi;
+		tmp.w = tmp.x1 - tmp.x0;
+		tmp.h = tmp.y1 - tmp.y0;
+		aoi = &tmp;
+		_d2tk_bitmap_rects(core, aoi);
+	}
+
+	if(bitmap->nfills)
+	{
+		_d2tk_core_render(core, curcom, aoi);
+	}
+
+	_d2tk_core_advance(core);
+
+	return 0;
 }
 
 D2TK_API d2tk_core_t *
@@ -1523,8 +2876,26 @@ d2tk_core_new(const d2tk_core_driver_t *driver, void *data)
 	core->driver = driver;
 	core->data = data;
 
-	_d2tk_mem_init(&core->mem[0], 8192);
-	_d2tk_mem_init(&core->mem[1], 8192);
+	_d2tk_cache_init(&core->sprites, &core->frame, _D2TK_SPRITES_TTL,
+		_D2TK_SPRITES_BUDGET, _d2tk_sprite_release);
+	_d2tk_cache_init(&core->memcaches, &core->frame, _D2TK_MEMCACHES_TTL,
+		_D2TK_MEMCACHES_BUDGET, _d2tk_memcache_release);
+	_d2tk_cache_init(&core->layouts, &core->frame, _D2TK_LAYOUTS_TTL,
+		_D2TK_LAYOUTS_BUDGET, _d2tk_sprite_release);
+	_d2tk_cache_init(&core->atoms, &core->frame, _D2TK_ATOMS_TTL, SIZE_MAX,
+		_d2tk_atom_release);
+#ifdef D2TK_DEBUG
+	_d2tk_cache_init(&core->verifies, &core->frame, _D2TK_SPRITES_TTL, SIZE_MAX,
+		_d2tk_verify_release);
+#endif
+	// not all posted frames are recorded, thus both sides count recorded ones
+	_d2tk_cache_init(&core->recorded, &core->records, _D2TK_RECORDED_TTL,
+		SIZE_MAX, _d2tk_recorded_release);
+	_d2tk_cache_init(&core->replayed, &core->records, _D2TK_RECORDED_TTL,
+		SIZE_MAX, _d2tk_replayed_release);
+
+	_d2tk_mem_init(&core->mem[0], _D2TK_MEM_SIZE_MIN);
+	_d2tk_mem_init(&core->mem[1], _D2TK_MEM_SIZE_MIN);
 
 	{
 		core->curmem = 0;
@@ -1546,8 +2917,21 @@ d2tk_core_new(const d2tk_core_driver_t *driver, void *data)
 
 	core->curmem = 0;
 
-	core->ttl.sprites = _D2TK_SPRITES_TTL;
-	core->ttl.memcaches = _D2TK_MEMCACHES_TTL;
+	const char *record = getenv("D2TK_RECORD");
+	if(record)
+	{
+		FILE *fout = fopen(record, "wb");
+
+		if(fout)
+		{
+			d2tk_core_set_record(core, fout);
+			core->record_owned = true;
+		}
+		else
+		{
+			fprintf(stderr, "[%s] cannot open recording '%s'\n", __func__, record);
+		}
+	}
 
 	return core;
 }
@@ -1555,8 +2939,19 @@ d2tk_core_new(const d2tk_core_driver_t *driver, void *data)
 D2TK_API void
 d2tk_core_set_ttls(d2tk_core_t *core, uint32_t sprites, uint32_t memcaches)
 {
-	core->ttl.sprites  = sprites;
-	core->ttl.memcaches = memcaches;
+	core->sprites.ttl = sprites;
+	core->memcaches.ttl = memcaches;
+	core->layouts.ttl = sprites;
+#ifdef D2TK_DEBUG
+	core->verifies.ttl = sprites;
+#endif
+}
+
+D2TK_API void
+d2tk_core_set_budgets(d2tk_core_t *core, size_t sprites, size_t memcaches)
+{
+	core->sprites.budget = sprites;
+	core->memcaches.budget = memcaches;
 }
 
 D2TK_API void
@@ -1564,13 +2959,56 @@ d2tk_core_free(d2tk_core_t *core)
 {
 	_d2tk_mem_deinit(&core->mem[0]);
 	_d2tk_mem_deinit(&core->mem[1]);
+	_d2tk_mem_deinit(&core->scratch);
+	_d2tk_mem_deinit(&core->replay);
 	_d2tk_bitmap_deinit(&core->bitmap);
-	_d2tk_sprites_free(core);
-	_d2tk_memcaches_free(core);
+	_d2tk_cache_free(core, &core->sprites);
+	_d2tk_cache_free(core, &core->memcaches);
+	_d2tk_cache_free(core, &core->layouts);
+	_d2tk_cache_free(core, &core->atoms);
+#ifdef D2TK_DEBUG
+	_d2tk_cache_free(core, &core->verifies);
+#endif
+	d2tk_core_set_record(core, NULL);
+	_d2tk_cache_free(core, &core->replayed);
 
 	free(core);
 }
 
+D2TK_API void
+d2tk_core_get_stats(d2tk_core_t *core, d2tk_stats_t *frame, d2tk_stats_t *total)
+{
+	if(frame)
+	{
+		*frame = core->last;
+	}
+
+	if(total)
+	{
+		*total = core->total;
+	}
+}
+
+D2TK_API void
+d2tk_core_set_record(d2tk_core_t *core, FILE *fout)
+{
+	if(core->record)
+	{
+		fflush(core->record);
+
+		if(core->record_owned)
+		{
+			fclose(core->record);
+		}
+	}
+
+	_d2tk_cache_free(core, &core->recorded);
+
+	core->record = fout;
+	core->record_owned = false;
+	core->full_refresh = true; // recording must start with a complete frame
+}
+
 D2TK_API void
 d2tk_core_set_dimensions(d2tk_core_t *core, d2tk_coord_t w, d2tk_coord_t h)
 {
@@ -1593,3 +3031,42 @@ d2tk_core_get_dimensions(d2tk_core_t *core, d2tk_coord_t *w, d2tk_coord_t *h)
 		*h = core->h;
 	}
 }
+
+D2TK_API bool
+d2tk_core_get_dirty_rect(d2tk_core_t *core, d2tk_rect_t *rect)
+{
+	const d2tk_bitmap_t *bitmap = &core->bitmap;
+
+	if(!bitmap->nfills)
+	{
+		return false; // nothing has been redrawn in last frame
+	}
+
+	const d2tk_coord_t x0 = bitmap->x0 > 0
+		? bitmap->x0
+		: 0;
+	const d2tk_coord_t y0 = bitmap->y0 > 0
+		? bitmap->y0
+		: 0;
+	const d2tk_coord_t x1 = bitmap->x1 < core->w
+		? bitmap->x1
+		: core->w;
+	const d2tk_coord_t y1 = bitmap->y1 < core->h
+		? bitmap->y1
+		: core->h;
+
+	if( (x1 <= x0) || (y1 <= y0) )
+	{
+		return false;
+	}
+
+	if(rect)
+	{
+		rect->x = x0;
+		rect->y = y0;
+		rect->w = x1 - x0;
+		rect->h = y1 - y0;
+	}
+
+	return true;
+}
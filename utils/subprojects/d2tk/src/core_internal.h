@@ -192,6 +192,7 @@ struct _d2tk_body_custom_t {
 	d2tk_coord_t h;
 	uint32_t size;
 	const void *data;
+	uint64_t hash; // of content
 	d2tk_core_custom_t custom;
 };
 
@@ -203,7 +204,7 @@ struct _d2tk_body_bbox_t {
 	bool dirty;
 	bool cached;
 	bool container;
-	uint32_t hash;
+	uint64_t hash;
 	d2tk_clip_t clip;
 };
 
@@ -262,9 +263,27 @@ struct _d2tk_com_t {
 	d2tk_body_t body [] __attribute__((aligned(8)));
 };
 
+const char *
+d2tk_instr_name(uint32_t instr);
+
 uintptr_t *
 d2tk_core_get_sprite(d2tk_core_t *core, uint64_t hash, uint8_t type);
 
+uintptr_t *
+d2tk_core_get_layout(d2tk_core_t *core, uint64_t hash, uint8_t type);
+
+void
+d2tk_core_set_layout_size(d2tk_core_t *core, uintptr_t *layout, size_t size);
+
+void *
+d2tk_core_get_atom(d2tk_core_t *core, uint64_t id, uint8_t type, size_t size);
+
+size_t
+d2tk_core_get_sprite_budget(d2tk_core_t *core, size_t *used);
+
+void
+d2tk_core_set_sprite_size(d2tk_core_t *core, uintptr_t *sprite, size_t size);
+
 const d2tk_com_t *
 d2tk_com_begin_const(const d2tk_com_t *com);
 
@@ -298,9 +317,6 @@ d2tk_com_next(d2tk_com_t *bbox);
 		d2tk_com_not_end((COM), (BBOX)); \
 		(BBOX) = d2tk_com_next((BBOX)))
 
-uint32_t *
-d2tk_core_get_pixels(d2tk_core_t *core, d2tk_rect_t *rect);
-
 void
 d2tk_core_set_bg_color(d2tk_core_t *core, uint32_t rgba);
 
@@ -0,0 +1,510 @@
+// generated by d2tk.bake_font from Roboto-Bold.ttf, do not edit
+
+#define _D2TK_MONO_FONT_SIZE 32 // em size in pixels
+#define _D2TK_MONO_FONT_ASCENT 34
+#define _D2TK_MONO_FONT_DESCENT 9
+#define _D2TK_MONO_FONT_FIRST 0x20
+#define _D2TK_MONO_FONT_LAST 0x7e
+
+static const d2tk_mono_glyph_t _d2tk_mono_glyphs [] = {
+	{     0,  0,  0,   0,   0,  510 }, // ' '
+	{     0,  5, 23,   2, -23,  557 }, // '!'
+	{    23, 10,  9,   0, -25,  656 }, // '"'
+	{    41, 19, 23,   0, -23, 1219 }, // '#'
+	{   110, 16, 31,   1, -27, 1175 }, // '$'
+	{   172, 22, 25,   1, -24, 1513 }, // '%'
+	{   247, 21, 25,   0, -24, 1346 }, // '&'
+	{   322,  5, 10,   0, -25,  330 }, // '''
+	{   332, 10, 34,   1, -26,  711 }, // '('
+	{   400, 10, 34,   0, -26,  713 }, // ')'
+	{   468, 14, 14,   0, -23,  908 }, // '*'
+	{   496, 17, 17,   0, -19, 1117 }, // '+'
+	{   547,  7,  9,   0,  -4,  528 }, // ','
+	{   556, 10,  5,   1, -12,  801 }, // '-'
+	{   566,  5,  4,   2,  -4,  596 }, // '.'
+	{   570, 14, 25,  -1, -23,  825 }, // '/'
+	{   620, 16, 25,   1, -24, 1175 }, // '0'
+	{   670, 10, 23,   2, -23, 1175 }, // '1'
+	{   716, 17, 24,   1, -24, 1175 }, // '2'
+	{   788, 16, 25,   1, -24, 1175 }, // '3'
+	{   838, 18, 23,   0, -23, 1175 }, // '4'
+	{   907, 16, 24,   1, -23, 1175 }, // '5'
+	{   955, 17, 25,   1, -24, 1175 }, // '6'
+	{  1030, 18, 23,   0, -23, 1175 }, // '7'
+	{  1099, 16, 25,   1, -24, 1175 }, // '8'
+	{  1149, 16, 25,   1, -24, 1175 }, // '9'
+	{  1199,  5, 18,   2, -18,  582 }, // ':'
+	{  1217,  7, 23,   1, -18,  562 }, // ';'
+	{  1240, 15, 16,   0, -17, 1043 }, // '<'
+	{  1272, 15, 11,   2, -16, 1181 }, // '='
+	{  1294, 15, 16,   1, -17, 1058 }, // '>'
+	{  1326, 16, 24,   0, -24, 1021 }, // '?'
+	{  1374, 28, 31,   0, -23, 1817 }, // '@'
+	{  1498, 21, 23,   0, -23, 1311 }, // 'A'
+	{  1567, 18, 23,   2, -23, 1314 }, // 'B'
+	{  1636, 19, 25,   1, -24, 1309 }, // 'C'
+	{  1711, 18, 23,   2, -23, 1342 }, // 'D'
+	{  1780, 16, 23,   2, -23, 1176 }, // 'E'
+	{  1826, 16, 23,   2, -23, 1182 }, // 'F'
+	{  1872, 19, 25,   1, -24, 1369 }, // 'G'
+	{  1947, 19, 23,   2, -23, 1450 }, // 'H'
+	{  2016,  5, 23,   2, -23,  601 }, // 'I'
+	{  2039, 17, 24,   0, -23, 1169 }, // 'J'
+	{  2111, 19, 23,   2, -23, 1323 }, // 'K'
+	{  2180, 15, 23,   2, -23, 1108 }, // 'L'
+	{  2226, 24, 23,   2, -23, 1787 }, // 'M'
+	{  2295, 19, 23,   2, -23, 1450 }, // 'N'
+	{  2364, 20, 25,   1, -24, 1399 }, // 'O'
+	{  2439, 18, 23,   2, -23, 1334 }, // 'P'
+	{  2508, 21, 28,   1, -24, 1433 }, // 'Q'
+	{  2592, 19, 23,   2, -23, 1354 }, // 'R'
+	{  2661, 18, 25,   1, -24, 1299 }, // 'S'
+	{  2736, 18, 23,   0, -23, 1169 }, // 'T'
+	{  2805, 20, 24,   1, -23, 1407 }, // 'U'
+	{  2877, 21, 23,   0, -23, 1303 }, // 'V'
+	{  2946, 28, 23,   0, -23, 1815 }, // 'W'
+	{  3038, 21, 23,   0, -23, 1303 }, // 'X'
+	{  3107, 21, 23,   0, -23, 1292 }, // 'Y'
+	{  3176, 17, 23,   1, -23, 1206 }, // 'Z'
+	{  3245,  8, 33,   1, -27,  570 }, // '['
+	{  3278, 15, 25,   0, -23,  863 }, // '\'
+	{  3328,  7, 33,   0, -27,  570 }, // ']'
+	{  3361, 14, 12,   0, -23,  896 }, // '^'
+	{  3385, 15,  4,   0,   0,  914 }, // '_'
+	{  3393,  9,  6,   1, -24,  678 }, // '`'
+	{  3405, 17, 19,   0, -18, 1100 }, // 'a'
+	{  3462, 16, 26,   1, -25, 1156 }, // 'b'
+	{  3514, 16, 19,   0, -18, 1060 }, // 'c'
+	{  3552, 16, 26,   1, -25, 1156 }, // 'd'
+	{  3604, 16, 19,   1, -18, 1084 }, // 'e'
+	{  3642, 12, 25,   0, -25,  732 }, // 'f'
+	{  3692, 16, 25,   1, -18, 1156 }, // 'g'
+	{  3742, 16, 25,   1, -25, 1156 }, // 'h'
+	{  3792,  6, 25,   1, -25,  547 }, // 'i'
+	{  3817,  9, 32,  -2, -25,  543 }, // 'j'
+	{  3881, 17, 25,   1, -25, 1097 }, // 'k'
+	{  3956,  6, 25,   1, -25,  547 }, // 'l'
+	{  3981, 25, 18,   1, -18, 1772 }, // 'm'
+	{  4053, 16, 18,   1, -18, 1156 }, // 'n'
+	{  4089, 16, 19,   1, -18, 1156 }, // 'o'
+	{  4127, 16, 25,   1, -18, 1156 }, // 'p'
+	{  4177, 16, 25,   1, -18, 1156 }, // 'q'
+	{  4227, 11, 18,   1, -18,  717 }, // 'r'
+	{  4263, 16, 19,   0, -18, 1056 }, // 's'
+	{  4301, 11, 23,   0, -22,  715 }, // 't'
+	{  4347, 16, 18,   1, -17, 1156 }, // 'u'
+	{  4383, 17, 17,   0, -17, 1046 }, // 'v'
+	{  4434, 24, 17,   0, -17, 1507 }, // 'w'
+	{  4485, 17, 17,   0, -17, 1046 }, // 'x'
+	{  4536, 17, 24,   0, -17, 1046 }, // 'y'
+	{  4608, 15, 17,   1, -17, 1046 }, // 'z'
+	{  4642, 11, 31,   0, -25,  676 }, // '{'
+	{  4704,  4, 28,   2, -23,  519 }, // '|'
+	{  4732, 10, 31,   0, -25,  676 }, // '}'
+	{  4794, 19,  8,   1, -13, 1327 }, // '~'
+};
+
+static const uint8_t _d2tk_mono_atlas [4818] = {
+	0xf0, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8,
+	0xf8, 0xf8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xf8, 0xf8, 0xf8, 0x00,
+	0x00, 0x73, 0x80, 0x73, 0x80, 0x73, 0x80, 0x73, 0x80, 0x73, 0x80, 0x73,
+	0x80, 0x63, 0x00, 0x63, 0x00, 0x01, 0xc7, 0x00, 0x01, 0xc7, 0x00, 0x01,
+	0xc6, 0x00, 0x01, 0x8e, 0x00, 0x03, 0x8e, 0x00, 0x03, 0x8e, 0x00, 0x03,
+	0x8e, 0x00, 0x3f, 0xff, 0xc0, 0x3f, 0xff, 0xc0, 0x07, 0x9e, 0x00, 0x07,
+	0x1c, 0x00, 0x07, 0x1c, 0x00, 0x07, 0x1c, 0x00, 0x07, 0x1c, 0x00, 0x7f,
+	0xff, 0x80, 0x7f, 0xff, 0x80, 0x7f, 0xff, 0x80, 0x0e, 0x38, 0x00, 0x0e,
+	0x38, 0x00, 0x0e, 0x38, 0x00, 0x0c, 0x70, 0x00, 0x1c, 0x70, 0x00, 0x1c,
+	0x70, 0x00, 0x00, 0x00, 0x01, 0xc0, 0x01, 0xc0, 0x01, 0xc0, 0x07, 0xe0,
+	0x0f, 0xf8, 0x1f, 0xfc, 0x3f, 0xfe, 0x3c, 0x3e, 0x7c, 0x1f, 0x7c, 0x1f,
+	0x7c, 0x00, 0x3e, 0x00, 0x3f, 0x80, 0x1f, 0xe0, 0x0f, 0xf8, 0x03, 0xfc,
+	0x00, 0xfe, 0x00, 0x3e, 0x00, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x7c, 0x1f,
+	0x7f, 0x7e, 0x3f, 0xfe, 0x1f, 0xfc, 0x0f, 0xf0, 0x01, 0xc0, 0x01, 0xc0,
+	0x01, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x3f, 0x80,
+	0x00, 0x7f, 0xc0, 0x00, 0x71, 0xc3, 0x80, 0x71, 0xc3, 0x80, 0xf1, 0xc7,
+	0x00, 0x71, 0xce, 0x00, 0x73, 0xce, 0x00, 0x7f, 0xdc, 0x00, 0x3f, 0x9c,
+	0x00, 0x00, 0x38, 0x00, 0x00, 0x70, 0x00, 0x00, 0x70, 0x00, 0x00, 0xe3,
+	0xe0, 0x01, 0xcf, 0xf0, 0x01, 0xcf, 0x78, 0x03, 0x8e, 0x38, 0x03, 0x9c,
+	0x38, 0x07, 0x1c, 0x38, 0x0e, 0x0e, 0x38, 0x06, 0x0f, 0x78, 0x00, 0x0f,
+	0xf0, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xf0,
+	0x00, 0x07, 0xf8, 0x00, 0x0f, 0xfc, 0x00, 0x1f, 0xfc, 0x00, 0x1e, 0x1e,
+	0x00, 0x1e, 0x1e, 0x00, 0x1e, 0x1c, 0x00, 0x1f, 0x3c, 0x00, 0x0f, 0x78,
+	0x00, 0x0f, 0xf8, 0x00, 0x07, 0xe0, 0x00, 0x0f, 0xe0, 0x00, 0x1f, 0xf0,
+	0xe0, 0x3f, 0xf0, 0xe0, 0x3c, 0xf8, 0xe0, 0x7c, 0x7d, 0xe0, 0x7c, 0x3f,
+	0xe0, 0x7c, 0x1f, 0xc0, 0x7c, 0x1f, 0x80, 0x3f, 0x1f, 0xc0, 0x3f, 0xff,
+	0xc0, 0x1f, 0xff, 0xe0, 0x07, 0xf1, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x70,
+	0x70, 0x70, 0x70, 0x70, 0x70, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x80,
+	0x03, 0x80, 0x07, 0x80, 0x07, 0x00, 0x0f, 0x00, 0x1e, 0x00, 0x1c, 0x00,
+	0x1c, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00,
+	0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00,
+	0x78, 0x00, 0x78, 0x00, 0x38, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x1c, 0x00,
+	0x1e, 0x00, 0x1e, 0x00, 0x0f, 0x00, 0x07, 0x00, 0x07, 0x80, 0x01, 0x80,
+	0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x70, 0x00, 0x78, 0x00,
+	0x3c, 0x00, 0x1c, 0x00, 0x1e, 0x00, 0x0e, 0x00, 0x0f, 0x00, 0x0f, 0x00,
+	0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80,
+	0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80,
+	0x07, 0x80, 0x07, 0x00, 0x0f, 0x00, 0x0f, 0x00, 0x0e, 0x00, 0x1e, 0x00,
+	0x3c, 0x00, 0x38, 0x00, 0x78, 0x00, 0x70, 0x00, 0x40, 0x00, 0x00, 0x00,
+	0x03, 0x00, 0x03, 0x80, 0x03, 0x00, 0x03, 0x00, 0x63, 0x18, 0x7f, 0xf8,
+	0x7f, 0xfc, 0x0f, 0xe0, 0x07, 0x80, 0x0f, 0xc0, 0x1c, 0xe0, 0x3c, 0xf0,
+	0x38, 0x70, 0x00, 0x40, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0,
+	0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x7f, 0xff,
+	0x00, 0x7f, 0xff, 0x00, 0x7f, 0xff, 0x00, 0x7f, 0xff, 0x00, 0x03, 0xe0,
+	0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0,
+	0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x3c, 0x3e, 0x3e, 0x3e, 0x3c,
+	0x3c, 0x78, 0x78, 0x70, 0x00, 0x00, 0x7f, 0xc0, 0x7f, 0xc0, 0x7f, 0xc0,
+	0x00, 0x00, 0xf8, 0xf8, 0xf8, 0xf8, 0x00, 0x78, 0x00, 0x78, 0x00, 0xf8,
+	0x00, 0xf0, 0x00, 0xf0, 0x01, 0xf0, 0x01, 0xe0, 0x01, 0xe0, 0x03, 0xe0,
+	0x03, 0xc0, 0x03, 0xc0, 0x07, 0xc0, 0x07, 0x80, 0x07, 0x80, 0x0f, 0x80,
+	0x0f, 0x00, 0x0f, 0x00, 0x1f, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x3e, 0x00,
+	0x3c, 0x00, 0x3c, 0x00, 0x7c, 0x00, 0x78, 0x00, 0x00, 0x00, 0x07, 0xe0,
+	0x0f, 0xf8, 0x3f, 0xfc, 0x3f, 0xfc, 0x7c, 0x3e, 0x7c, 0x1e, 0x78, 0x1f,
+	0x78, 0x1f, 0x78, 0x1f, 0xf8, 0x1f, 0xf8, 0x1f, 0xf8, 0x1f, 0xf8, 0x1f,
+	0xf8, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x78, 0x1e, 0x7c, 0x3e,
+	0x3e, 0x7e, 0x3f, 0xfc, 0x1f, 0xf8, 0x07, 0xf0, 0x00, 0x00, 0x01, 0xc0,
+	0x7f, 0xc0, 0x7f, 0xc0, 0x7f, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0,
+	0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0,
+	0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0,
+	0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x07,
+	0xe0, 0x00, 0x1f, 0xf8, 0x00, 0x3f, 0xfc, 0x00, 0x7f, 0xfe, 0x00, 0x7c,
+	0x3e, 0x00, 0xf8, 0x3e, 0x00, 0xf8, 0x1e, 0x00, 0x00, 0x1e, 0x00, 0x00,
+	0x3e, 0x00, 0x00, 0x3e, 0x00, 0x00, 0x7c, 0x00, 0x00, 0xf8, 0x00, 0x00,
+	0xf8, 0x00, 0x01, 0xf0, 0x00, 0x03, 0xe0, 0x00, 0x07, 0xc0, 0x00, 0x0f,
+	0x80, 0x00, 0x1f, 0x00, 0x00, 0x3e, 0x00, 0x00, 0x7f, 0xff, 0x00, 0x7f,
+	0xff, 0x00, 0x7f, 0xff, 0x00, 0x7f, 0xff, 0x00, 0x00, 0x00, 0x07, 0xe0,
+	0x1f, 0xf8, 0x3f, 0xfc, 0x7f, 0xfe, 0x7c, 0x3e, 0xf8, 0x1e, 0x00, 0x1e,
+	0x00, 0x1e, 0x00, 0x3e, 0x00, 0xfc, 0x07, 0xf8, 0x07, 0xf0, 0x07, 0xfc,
+	0x00, 0x7e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1f, 0xf8, 0x1f, 0xf8, 0x1e,
+	0x7e, 0x7e, 0x7f, 0xfc, 0x3f, 0xf8, 0x0f, 0xf0, 0x00, 0x00, 0x00, 0x3e,
+	0x00, 0x00, 0x3e, 0x00, 0x00, 0x7e, 0x00, 0x00, 0xfe, 0x00, 0x00, 0xfe,
+	0x00, 0x01, 0xfe, 0x00, 0x03, 0xfe, 0x00, 0x03, 0xfe, 0x00, 0x07, 0xbe,
+	0x00, 0x07, 0x3e, 0x00, 0x0f, 0x3e, 0x00, 0x1e, 0x3e, 0x00, 0x1c, 0x3e,
+	0x00, 0x3c, 0x3e, 0x00, 0x7c, 0x3e, 0x00, 0x7f, 0xff, 0xc0, 0x7f, 0xff,
+	0xc0, 0x7f, 0xff, 0xc0, 0x00, 0x3e, 0x00, 0x00, 0x3e, 0x00, 0x00, 0x3e,
+	0x00, 0x00, 0x3e, 0x00, 0x00, 0x3e, 0x00, 0x1f, 0xfe, 0x3f, 0xfe, 0x3f,
+	0xfe, 0x3f, 0xfe, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3d,
+	0xf0, 0x7f, 0xf8, 0x7f, 0xfc, 0x7f, 0x7e, 0x7c, 0x3e, 0x00, 0x1f, 0x00,
+	0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x78, 0x1f, 0x7c, 0x1e, 0x7e, 0x3e, 0x3f,
+	0xfc, 0x1f, 0xf8, 0x07, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xf8,
+	0x00, 0x07, 0xfc, 0x00, 0x1f, 0xfc, 0x00, 0x1f, 0xfc, 0x00, 0x3e, 0x00,
+	0x00, 0x7c, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x78, 0x00, 0x00, 0x79, 0xf8,
+	0x00, 0x7f, 0xfc, 0x00, 0x7f, 0xfe, 0x00, 0x7e, 0x7e, 0x00, 0x78, 0x1f,
+	0x00, 0x78, 0x1f, 0x00, 0x78, 0x0f, 0x00, 0x78, 0x0f, 0x00, 0x78, 0x0f,
+	0x00, 0x7c, 0x1f, 0x00, 0x7c, 0x1f, 0x00, 0x3e, 0x7e, 0x00, 0x1f, 0xfe,
+	0x00, 0x0f, 0xfc, 0x00, 0x07, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xff,
+	0x80, 0x7f, 0xff, 0x80, 0x7f, 0xff, 0x80, 0x7f, 0xff, 0x80, 0x00, 0x0f,
+	0x00, 0x00, 0x1f, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x7c,
+	0x00, 0x00, 0x78, 0x00, 0x00, 0xf8, 0x00, 0x00, 0xf0, 0x00, 0x01, 0xf0,
+	0x00, 0x01, 0xf0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x03, 0xe0,
+	0x00, 0x03, 0xe0, 0x00, 0x03, 0xc0, 0x00, 0x03, 0xc0, 0x00, 0x03, 0xc0,
+	0x00, 0x07, 0xc0, 0x00, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x07, 0xe0, 0x1f,
+	0xf8, 0x3f, 0xfc, 0x3f, 0xfe, 0x7c, 0x3e, 0x7c, 0x1e, 0x7c, 0x1e, 0x7c,
+	0x1e, 0x3c, 0x3e, 0x3f, 0xfc, 0x1f, 0xf8, 0x0f, 0xf0, 0x1f, 0xfc, 0x3e,
+	0x7e, 0x7c, 0x1e, 0x78, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x7c, 0x1f, 0x7e,
+	0x7e, 0x3f, 0xfe, 0x1f, 0xfc, 0x0f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x07,
+	0xe0, 0x1f, 0xf0, 0x3f, 0xfc, 0x3f, 0xfc, 0x7c, 0x3e, 0x78, 0x1e, 0x78,
+	0x1e, 0xf8, 0x1f, 0xf8, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x7e, 0x3f, 0x3f,
+	0xff, 0x3f, 0xff, 0x0f, 0xdf, 0x00, 0x1f, 0x00, 0x1e, 0x00, 0x1e, 0x00,
+	0x3e, 0x10, 0x7c, 0x1f, 0xfc, 0x3f, 0xf0, 0x1f, 0xe0, 0x00, 0x00, 0xf8,
+	0xf8, 0xf8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xf8, 0xf8, 0xf8, 0xf8, 0x7c, 0x7c, 0x7c, 0x7c, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x3c, 0x3c, 0x3c, 0x3c,
+	0x78, 0x78, 0x70, 0x70, 0x00, 0x00, 0x00, 0x04, 0x00, 0x1c, 0x00, 0xfc,
+	0x03, 0xfc, 0x0f, 0xf8, 0x7f, 0xe0, 0x7f, 0x00, 0x7c, 0x00, 0x7f, 0x00,
+	0x3f, 0xe0, 0x0f, 0xfc, 0x03, 0xfc, 0x00, 0x7c, 0x00, 0x1c, 0x00, 0x04,
+	0x7f, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xff, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0x00, 0x00,
+	0x40, 0x00, 0x78, 0x00, 0x7e, 0x00, 0x7f, 0x80, 0x3f, 0xf0, 0x07, 0xfc,
+	0x00, 0xfc, 0x00, 0x7c, 0x01, 0xfc, 0x0f, 0xfc, 0x7f, 0xe0, 0x7f, 0x80,
+	0x7e, 0x00, 0x70, 0x00, 0x40, 0x00, 0x00, 0x00, 0x0f, 0xe0, 0x1f, 0xf8,
+	0x3f, 0xfc, 0x7f, 0xfe, 0x7c, 0x3e, 0x78, 0x3e, 0x00, 0x1e, 0x00, 0x3e,
+	0x00, 0x3e, 0x00, 0x7c, 0x00, 0x7c, 0x00, 0xf8, 0x01, 0xf0, 0x03, 0xe0,
+	0x07, 0xc0, 0x07, 0xc0, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x07, 0xc0,
+	0x07, 0xc0, 0x07, 0xc0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f,
+	0xc0, 0x00, 0x00, 0xff, 0xf8, 0x00, 0x01, 0xfc, 0xfc, 0x00, 0x03, 0xc0,
+	0x0f, 0x00, 0x07, 0x80, 0x07, 0x80, 0x0e, 0x00, 0x03, 0x80, 0x1e, 0x00,
+	0x01, 0xc0, 0x1c, 0x0f, 0xc1, 0xc0, 0x3c, 0x1f, 0xf0, 0xc0, 0x38, 0x3e,
+	0xf0, 0xe0, 0x38, 0x78, 0xf0, 0xe0, 0x38, 0x70, 0xf0, 0xe0, 0x70, 0xf0,
+	0xe0, 0xe0, 0x70, 0xf0, 0xe0, 0xe0, 0x70, 0xe0, 0xe0, 0xe0, 0x70, 0xe0,
+	0xe0, 0xe0, 0x70, 0xe0, 0xe0, 0xe0, 0x70, 0xe0, 0xe1, 0xc0, 0x70, 0xf1,
+	0xe1, 0xc0, 0x38, 0xff, 0xe3, 0x80, 0x38, 0x7e, 0x7f, 0x00, 0x3c, 0x3c,
+	0x7e, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x0f, 0x00,
+	0x00, 0x00, 0x07, 0x80, 0x00, 0x00, 0x03, 0xff, 0xe0, 0x00, 0x01, 0xff,
+	0xe0, 0x00, 0x00, 0x3f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8,
+	0x00, 0x00, 0xf8, 0x00, 0x01, 0xf8, 0x00, 0x01, 0xfc, 0x00, 0x01, 0xfc,
+	0x00, 0x03, 0xfc, 0x00, 0x03, 0xde, 0x00, 0x03, 0xde, 0x00, 0x07, 0x9f,
+	0x00, 0x07, 0x8f, 0x00, 0x0f, 0x8f, 0x00, 0x0f, 0x0f, 0x80, 0x0f, 0x07,
+	0x80, 0x1f, 0x07, 0x80, 0x1f, 0x07, 0xc0, 0x1f, 0xff, 0xc0, 0x3f, 0xff,
+	0xc0, 0x3f, 0xff, 0xe0, 0x3c, 0x03, 0xe0, 0x7c, 0x01, 0xe0, 0x7c, 0x01,
+	0xf0, 0x78, 0x01, 0xf0, 0xf8, 0x00, 0xf0, 0xff, 0xc0, 0x00, 0xff, 0xf8,
+	0x00, 0xff, 0xfe, 0x00, 0xff, 0xff, 0x00, 0xf8, 0x3f, 0x00, 0xf8, 0x1f,
+	0x00, 0xf8, 0x0f, 0x00, 0xf8, 0x1f, 0x00, 0xf8, 0x1f, 0x00, 0xf8, 0x7e,
+	0x00, 0xff, 0xfc, 0x00, 0xff, 0xfc, 0x00, 0xff, 0xff, 0x00, 0xf8, 0x1f,
+	0x00, 0xf8, 0x0f, 0x80, 0xf8, 0x0f, 0x80, 0xf8, 0x07, 0x80, 0xf8, 0x0f,
+	0x80, 0xf8, 0x0f, 0x80, 0xff, 0xff, 0x00, 0xff, 0xff, 0x00, 0xff, 0xfe,
+	0x00, 0xff, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x03, 0xf8, 0x00, 0x07, 0xfe,
+	0x00, 0x1f, 0xff, 0x00, 0x3f, 0xbf, 0x80, 0x3e, 0x07, 0xc0, 0x7c, 0x07,
+	0xc0, 0x7c, 0x03, 0xc0, 0x78, 0x03, 0xc0, 0x78, 0x00, 0x00, 0xf8, 0x00,
+	0x00, 0xf8, 0x00, 0x00, 0xf8, 0x00, 0x00, 0xf8, 0x00, 0x00, 0xf8, 0x00,
+	0x00, 0x78, 0x00, 0x00, 0x78, 0x03, 0xc0, 0x78, 0x03, 0xc0, 0x7c, 0x07,
+	0xc0, 0x3e, 0x07, 0xc0, 0x3f, 0x1f, 0x80, 0x1f, 0xff, 0x80, 0x0f, 0xff,
+	0x00, 0x03, 0xfc, 0x00, 0x00, 0x00, 0x00, 0xff, 0x80, 0x00, 0xff, 0xf8,
+	0x00, 0xff, 0xfc, 0x00, 0xff, 0xfe, 0x00, 0xf8, 0x3f, 0x00, 0xf8, 0x0f,
+	0x80, 0xf8, 0x0f, 0x80, 0xf8, 0x07, 0x80, 0xf8, 0x07, 0x80, 0xf8, 0x07,
+	0x80, 0xf8, 0x07, 0xc0, 0xf8, 0x07, 0xc0, 0xf8, 0x07, 0xc0, 0xf8, 0x07,
+	0x80, 0xf8, 0x07, 0x80, 0xf8, 0x07, 0x80, 0xf8, 0x0f, 0x80, 0xf8, 0x0f,
+	0x80, 0xf8, 0x1f, 0x00, 0xff, 0xfe, 0x00, 0xff, 0xfe, 0x00, 0xff, 0xf8,
+	0x00, 0xff, 0xe0, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xff, 0xfc,
+	0xff, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00,
+	0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x00,
+	0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xff, 0xfc,
+	0xff, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00,
+	0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00,
+	0x00, 0x00, 0x00, 0x03, 0xf8, 0x00, 0x07, 0xfe, 0x00, 0x1f, 0xff, 0x00,
+	0x3f, 0xff, 0x80, 0x3e, 0x07, 0xc0, 0x7c, 0x07, 0xc0, 0x7c, 0x03, 0xc0,
+	0x78, 0x00, 0x00, 0x78, 0x00, 0x00, 0x78, 0x00, 0x00, 0x78, 0x00, 0x00,
+	0x78, 0x3f, 0xc0, 0x78, 0x3f, 0xe0, 0x78, 0x3f, 0xe0, 0x78, 0x03, 0xe0,
+	0x78, 0x03, 0xe0, 0x7c, 0x03, 0xe0, 0x7c, 0x03, 0xe0, 0x3e, 0x03, 0xe0,
+	0x3f, 0x0f, 0xe0, 0x1f, 0xff, 0xc0, 0x0f, 0xff, 0x00, 0x03, 0xfe, 0x00,
+	0x00, 0x00, 0x00, 0xf8, 0x03, 0xc0, 0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0,
+	0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0,
+	0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0, 0xff, 0xff, 0xe0,
+	0xff, 0xff, 0xe0, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xe0, 0xf8, 0x03, 0xe0,
+	0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0,
+	0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0, 0xf8, 0x03, 0xe0,
+	0x78, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8,
+	0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0x00,
+	0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00,
+	0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00,
+	0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00,
+	0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x0f, 0x00, 0x78,
+	0x0f, 0x00, 0x7c, 0x1f, 0x00, 0x7c, 0x1f, 0x00, 0x3f, 0x7e, 0x00, 0x3f,
+	0xfe, 0x00, 0x1f, 0xfc, 0x00, 0x07, 0xf0, 0x00, 0x00, 0x00, 0x00, 0xf8,
+	0x07, 0xc0, 0xf8, 0x0f, 0x80, 0xf8, 0x1f, 0x80, 0xf8, 0x1f, 0x00, 0xf8,
+	0x3e, 0x00, 0xf8, 0x7c, 0x00, 0xf8, 0x7c, 0x00, 0xf8, 0xf8, 0x00, 0xf9,
+	0xf0, 0x00, 0xfb, 0xf0, 0x00, 0xff, 0xe0, 0x00, 0xff, 0xe0, 0x00, 0xff,
+	0xf0, 0x00, 0xff, 0xf0, 0x00, 0xf8, 0xf8, 0x00, 0xf8, 0x7c, 0x00, 0xf8,
+	0x7c, 0x00, 0xf8, 0x3e, 0x00, 0xf8, 0x3f, 0x00, 0xf8, 0x1f, 0x80, 0xf8,
+	0x0f, 0x80, 0xf8, 0x0f, 0xc0, 0xf8, 0x07, 0xe0, 0xf8, 0x00, 0xf8, 0x00,
+	0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00,
+	0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00,
+	0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xff, 0xfc,
+	0xff, 0xfe, 0xff, 0xfe, 0xff, 0xfe, 0xfc, 0x00, 0x3f, 0xfe, 0x00, 0x7f,
+	0xfe, 0x00, 0x7f, 0xfe, 0x00, 0x7f, 0xff, 0x00, 0xff, 0xff, 0x00, 0xff,
+	0xff, 0x00, 0xff, 0xf7, 0x81, 0xef, 0xf7, 0x81, 0xef, 0xf3, 0x81, 0xcf,
+	0xf3, 0xc3, 0xdf, 0xf3, 0xc3, 0xdf, 0xf9, 0xc3, 0x9f, 0xf9, 0xe7, 0x9f,
+	0xf9, 0xe7, 0x9f, 0xf8, 0xef, 0x1f, 0xf8, 0xff, 0x1f, 0xf8, 0xfe, 0x1f,
+	0xf8, 0x7e, 0x1f, 0xf8, 0x7e, 0x1f, 0xf8, 0x3c, 0x1f, 0xf8, 0x3c, 0x1f,
+	0xf8, 0x3c, 0x1f, 0xf8, 0x03, 0xc0, 0xf8, 0x03, 0xe0, 0xfc, 0x03, 0xe0,
+	0xfe, 0x03, 0xe0, 0xfe, 0x03, 0xe0, 0xff, 0x03, 0xe0, 0xff, 0x03, 0xe0,
+	0xff, 0x83, 0xe0, 0xff, 0xc3, 0xe0, 0xfb, 0xc3, 0xe0, 0xf9, 0xe3, 0xe0,
+	0xf9, 0xe3, 0xe0, 0xf8, 0xf3, 0xe0, 0xf8, 0xfb, 0xe0, 0xf8, 0x7b, 0xe0,
+	0xf8, 0x3f, 0xe0, 0xf8, 0x3f, 0xe0, 0xf8, 0x1f, 0xe0, 0xf8, 0x1f, 0xe0,
+	0xf8, 0x0f, 0xe0, 0xf8, 0x0f, 0xe0, 0xf8, 0x07, 0xe0, 0xf8, 0x03, 0xe0,
+	0x00, 0x00, 0x00, 0x01, 0xf8, 0x00, 0x07, 0xfe, 0x00, 0x1f, 0xff, 0x00,
+	0x1f, 0xff, 0x80, 0x3e, 0x07, 0xc0, 0x7c, 0x03, 0xe0, 0x7c, 0x03, 0xe0,
+	0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0xf8, 0x01, 0xe0, 0xf8, 0x01, 0xe0,
+	0xf8, 0x01, 0xe0, 0xf8, 0x01, 0xe0, 0xf8, 0x01, 0xe0, 0x78, 0x01, 0xe0,
+	0x78, 0x01, 0xe0, 0x78, 0x03, 0xe0, 0x7c, 0x03, 0xe0, 0x3e, 0x07, 0xc0,
+	0x3f, 0x9f, 0x80, 0x1f, 0xff, 0x80, 0x0f, 0xfe, 0x00, 0x03, 0xfc, 0x00,
+	0x00, 0x00, 0x00, 0xff, 0xe0, 0x00, 0xff, 0xfc, 0x00, 0xff, 0xff, 0x00,
+	0xff, 0xff, 0x00, 0xf8, 0x0f, 0x80, 0xf8, 0x0f, 0x80, 0xf8, 0x07, 0x80,
+	0xf8, 0x07, 0xc0, 0xf8, 0x07, 0x80, 0xf8, 0x0f, 0x80, 0xf8, 0x1f, 0x80,
+	0xff, 0xff, 0x00, 0xff, 0xff, 0x00, 0xff, 0xfc, 0x00, 0xff, 0xe0, 0x00,
+	0xf8, 0x00, 0x00, 0xf8, 0x00, 0x00, 0xf8, 0x00, 0x00, 0xf8, 0x00, 0x00,
+	0xf8, 0x00, 0x00, 0xf8, 0x00, 0x00, 0xf8, 0x00, 0x00, 0xf8, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x01, 0xf8, 0x00, 0x07, 0xfe, 0x00, 0x1f, 0xff, 0x00,
+	0x1f, 0xff, 0x80, 0x3e, 0x07, 0xc0, 0x7c, 0x03, 0xe0, 0x7c, 0x03, 0xe0,
+	0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0xf8, 0x01, 0xe0, 0xf8, 0x01, 0xe0,
+	0xf8, 0x01, 0xe0, 0xf8, 0x01, 0xe0, 0xf8, 0x01, 0xe0, 0x78, 0x01, 0xe0,
+	0x78, 0x01, 0xe0, 0x78, 0x03, 0xe0, 0x7c, 0x03, 0xe0, 0x3e, 0x07, 0xc0,
+	0x3f, 0x9f, 0x80, 0x1f, 0xff, 0x80, 0x0f, 0xff, 0xc0, 0x03, 0xff, 0xe0,
+	0x00, 0x03, 0xf0, 0x00, 0x01, 0xf0, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00,
+	0xff, 0xe0, 0x00, 0xff, 0xfc, 0x00, 0xff, 0xfe, 0x00, 0xff, 0xff, 0x00,
+	0xf8, 0x1f, 0x00, 0xf8, 0x0f, 0x80, 0xf8, 0x0f, 0x80, 0xf8, 0x0f, 0x80,
+	0xf8, 0x0f, 0x80, 0xf8, 0x1f, 0x00, 0xff, 0xfe, 0x00, 0xff, 0xfc, 0x00,
+	0xff, 0xfc, 0x00, 0xff, 0xfe, 0x00, 0xf8, 0x1f, 0x00, 0xf8, 0x0f, 0x80,
+	0xf8, 0x0f, 0x80, 0xf8, 0x07, 0x80, 0xf8, 0x07, 0x80, 0xf8, 0x07, 0x80,
+	0xf8, 0x07, 0x80, 0xf8, 0x07, 0xc0, 0xf8, 0x07, 0xc0, 0x00, 0x00, 0x00,
+	0x03, 0xf8, 0x00, 0x0f, 0xfe, 0x00, 0x1f, 0xff, 0x00, 0x3f, 0xbf, 0x80,
+	0x7c, 0x0f, 0x80, 0x7c, 0x07, 0xc0, 0x7c, 0x07, 0xc0, 0x7c, 0x00, 0x00,
+	0x7e, 0x00, 0x00, 0x3f, 0xc0, 0x00, 0x1f, 0xf0, 0x00, 0x0f, 0xfc, 0x00,
+	0x01, 0xff, 0x00, 0x00, 0x7f, 0x80, 0x00, 0x0f, 0x80, 0x00, 0x07, 0xc0,
+	0x78, 0x07, 0xc0, 0x78, 0x07, 0xc0, 0x7c, 0x07, 0xc0, 0x7f, 0x1f, 0x80,
+	0x3f, 0xff, 0x80, 0x1f, 0xff, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x00, 0x00,
+	0x7f, 0xff, 0xc0, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xc0, 0x7f, 0xff, 0xc0,
+	0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00,
+	0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00,
+	0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00,
+	0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00,
+	0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x01, 0xe0, 0x00, 0x78, 0x01, 0xe0,
+	0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0,
+	0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0,
+	0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0,
+	0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0x78, 0x01, 0xe0, 0x7c, 0x03, 0xe0,
+	0x7c, 0x03, 0xe0, 0x7e, 0x07, 0xe0, 0x3f, 0x0f, 0xc0, 0x1f, 0xff, 0x80,
+	0x0f, 0xff, 0x00, 0x03, 0xfc, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x01, 0xf0,
+	0x78, 0x01, 0xf0, 0x7c, 0x01, 0xe0, 0x7c, 0x03, 0xe0, 0x3c, 0x03, 0xe0,
+	0x3c, 0x03, 0xc0, 0x3e, 0x03, 0xc0, 0x1e, 0x07, 0xc0, 0x1e, 0x07, 0x80,
+	0x1f, 0x07, 0x80, 0x0f, 0x0f, 0x80, 0x0f, 0x0f, 0x00, 0x0f, 0x8f, 0x00,
+	0x07, 0x8f, 0x00, 0x07, 0x9e, 0x00, 0x07, 0x9e, 0x00, 0x03, 0xde, 0x00,
+	0x03, 0xfc, 0x00, 0x03, 0xfc, 0x00, 0x01, 0xfc, 0x00, 0x01, 0xf8, 0x00,
+	0x01, 0xf8, 0x00, 0x00, 0xf8, 0x00, 0x78, 0x07, 0x00, 0xf0, 0x78, 0x0f,
+	0x01, 0xf0, 0x78, 0x0f, 0x01, 0xe0, 0x7c, 0x0f, 0x81, 0xe0, 0x7c, 0x1f,
+	0x81, 0xe0, 0x3c, 0x1f, 0x83, 0xe0, 0x3c, 0x1f, 0xc3, 0xc0, 0x3c, 0x3f,
+	0xc3, 0xc0, 0x3e, 0x3f, 0xc3, 0xc0, 0x1e, 0x3d, 0xc3, 0xc0, 0x1e, 0x39,
+	0xe7, 0xc0, 0x1e, 0x79, 0xe7, 0x80, 0x1e, 0x79, 0xe7, 0x80, 0x1f, 0x78,
+	0xe7, 0x80, 0x0f, 0x70, 0xff, 0x80, 0x0f, 0xf0, 0xff, 0x00, 0x0f, 0xf0,
+	0x7f, 0x00, 0x0f, 0xe0, 0x7f, 0x00, 0x07, 0xe0, 0x7f, 0x00, 0x07, 0xe0,
+	0x7e, 0x00, 0x07, 0xe0, 0x3e, 0x00, 0x07, 0xc0, 0x3e, 0x00, 0x03, 0xc0,
+	0x3e, 0x00, 0x7c, 0x03, 0xe0, 0x7e, 0x03, 0xe0, 0x3e, 0x07, 0xc0, 0x1f,
+	0x07, 0xc0, 0x1f, 0x0f, 0x80, 0x0f, 0x8f, 0x80, 0x0f, 0x9f, 0x00, 0x07,
+	0xde, 0x00, 0x03, 0xfe, 0x00, 0x03, 0xfc, 0x00, 0x01, 0xfc, 0x00, 0x01,
+	0xf8, 0x00, 0x01, 0xfc, 0x00, 0x03, 0xfc, 0x00, 0x03, 0xfe, 0x00, 0x07,
+	0xde, 0x00, 0x0f, 0x9f, 0x00, 0x0f, 0x8f, 0x80, 0x1f, 0x0f, 0x80, 0x1f,
+	0x07, 0xc0, 0x3e, 0x07, 0xe0, 0x7e, 0x03, 0xe0, 0x7c, 0x03, 0xf0, 0xf8,
+	0x01, 0xf0, 0x7c, 0x01, 0xe0, 0x7c, 0x03, 0xe0, 0x3e, 0x03, 0xc0, 0x3e,
+	0x07, 0xc0, 0x1f, 0x07, 0x80, 0x1f, 0x0f, 0x80, 0x0f, 0x8f, 0x00, 0x0f,
+	0x9f, 0x00, 0x07, 0x9e, 0x00, 0x07, 0xfe, 0x00, 0x03, 0xfc, 0x00, 0x01,
+	0xfc, 0x00, 0x01, 0xf8, 0x00, 0x00, 0xf8, 0x00, 0x00, 0xf0, 0x00, 0x00,
+	0xf0, 0x00, 0x00, 0xf0, 0x00, 0x00, 0xf0, 0x00, 0x00, 0xf0, 0x00, 0x00,
+	0xf0, 0x00, 0x00, 0xf0, 0x00, 0x00, 0xf0, 0x00, 0xff, 0xff, 0x00, 0xff,
+	0xff, 0x80, 0xff, 0xff, 0x80, 0xff, 0xff, 0x00, 0x00, 0x1e, 0x00, 0x00,
+	0x3e, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x78, 0x00, 0x00, 0xf8, 0x00, 0x01,
+	0xf0, 0x00, 0x01, 0xe0, 0x00, 0x03, 0xe0, 0x00, 0x07, 0xc0, 0x00, 0x07,
+	0xc0, 0x00, 0x0f, 0x80, 0x00, 0x1f, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x3e,
+	0x00, 0x00, 0x3c, 0x00, 0x00, 0x7f, 0xff, 0x00, 0xff, 0xff, 0x80, 0xff,
+	0xff, 0x80, 0xff, 0xff, 0x80, 0x00, 0x7f, 0x7f, 0x7f, 0x78, 0x78, 0x78,
+	0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78,
+	0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x7c, 0x7f, 0x7f,
+	0x7f, 0x00, 0xf8, 0x00, 0x78, 0x00, 0x78, 0x00, 0x7c, 0x00, 0x3c, 0x00,
+	0x3e, 0x00, 0x3e, 0x00, 0x1e, 0x00, 0x1f, 0x00, 0x0f, 0x00, 0x0f, 0x00,
+	0x0f, 0x80, 0x07, 0x80, 0x07, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xe0,
+	0x01, 0xe0, 0x01, 0xf0, 0x01, 0xf0, 0x00, 0xf0, 0x00, 0xf8, 0x00, 0x78,
+	0x00, 0x78, 0x00, 0x7c, 0x00, 0xfe, 0xfe, 0xfe, 0x3e, 0x3e, 0x3e, 0x3e,
+	0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e,
+	0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0xfe, 0xfe, 0xfe,
+	0x00, 0x07, 0x80, 0x07, 0x80, 0x0f, 0xc0, 0x0f, 0xc0, 0x0f, 0xc0, 0x1f,
+	0xe0, 0x1c, 0xe0, 0x3c, 0xf0, 0x3c, 0xf0, 0x38, 0x70, 0x78, 0x78, 0x70,
+	0x38, 0xff, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x7c,
+	0x00, 0x3c, 0x00, 0x1e, 0x00, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x07, 0xf0, 0x00, 0x1f, 0xfc, 0x00, 0x1f, 0xfc, 0x00, 0x3e, 0x7e, 0x00,
+	0x3c, 0x1e, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x1e, 0x00, 0x07, 0xfe, 0x00,
+	0x1f, 0xfe, 0x00, 0x3f, 0xfe, 0x00, 0x7c, 0x1e, 0x00, 0x7c, 0x1e, 0x00,
+	0x7c, 0x3e, 0x00, 0x7c, 0x7f, 0x00, 0x7f, 0xff, 0x00, 0x3f, 0xdf, 0x00,
+	0x1f, 0x9f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x78, 0x00,
+	0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x79, 0xf0,
+	0x7f, 0xf8, 0x7f, 0xfc, 0x7f, 0x7e, 0x7c, 0x3e, 0x78, 0x1f, 0x78, 0x1f,
+	0x78, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x7c, 0x1f,
+	0x7e, 0x3e, 0x7f, 0xfe, 0x7b, 0xfc, 0x79, 0xf8, 0x00, 0x00, 0x00, 0x00,
+	0x07, 0xf0, 0x0f, 0xfc, 0x1f, 0xfe, 0x3f, 0x7e, 0x3c, 0x1e, 0x7c, 0x1f,
+	0x7c, 0x00, 0x7c, 0x00, 0x7c, 0x00, 0x7c, 0x00, 0x7c, 0x00, 0x7c, 0x0f,
+	0x3c, 0x1e, 0x3f, 0x3e, 0x1f, 0xfe, 0x0f, 0xfc, 0x07, 0xf0, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e,
+	0x00, 0x1e, 0x00, 0x1e, 0x0f, 0x9e, 0x1f, 0xfe, 0x3f, 0xfe, 0x7e, 0xfe,
+	0x7c, 0x3e, 0xf8, 0x1e, 0xf8, 0x1e, 0xf8, 0x1e, 0xf8, 0x1e, 0xf8, 0x1e,
+	0xf8, 0x1e, 0xf8, 0x1e, 0x78, 0x3e, 0x7e, 0x7e, 0x7f, 0xfe, 0x3f, 0xde,
+	0x0f, 0x9e, 0x00, 0x00, 0x00, 0x00, 0x07, 0xe0, 0x1f, 0xf8, 0x3f, 0xfc,
+	0x3e, 0xfc, 0x7c, 0x3e, 0x78, 0x3e, 0xf8, 0x3e, 0xff, 0xfe, 0xff, 0xfe,
+	0xff, 0xfe, 0xf8, 0x00, 0x7c, 0x00, 0x7c, 0x00, 0x7f, 0x1c, 0x3f, 0xfc,
+	0x1f, 0xfc, 0x07, 0xf0, 0x00, 0x00, 0x00, 0xe0, 0x07, 0xf0, 0x0f, 0xe0,
+	0x0f, 0xe0, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0xff, 0xe0,
+	0xff, 0xe0, 0xff, 0xe0, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00,
+	0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00,
+	0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x0f, 0x9e,
+	0x1f, 0xde, 0x3f, 0xfe, 0x7e, 0x7e, 0x7c, 0x3e, 0xf8, 0x1e, 0xf8, 0x1e,
+	0xf8, 0x1e, 0xf8, 0x1e, 0xf8, 0x1e, 0xf8, 0x1e, 0xf8, 0x1e, 0x78, 0x3e,
+	0x7e, 0x7e, 0x3f, 0xfe, 0x3f, 0xfe, 0x0f, 0x9e, 0x00, 0x1e, 0x00, 0x3e,
+	0x10, 0x7e, 0x3f, 0xfc, 0x3f, 0xfc, 0x3f, 0xf0, 0x07, 0xc0, 0x00, 0x00,
+	0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00,
+	0x78, 0x00, 0x79, 0xf0, 0x7b, 0xfc, 0x7f, 0xfc, 0x7e, 0xfe, 0x78, 0x3e,
+	0x78, 0x3e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e,
+	0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e,
+	0x00, 0x7c, 0x7c, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x78, 0x7c, 0x7c, 0x7c,
+	0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c,
+	0x7c, 0x00, 0x00, 0x0f, 0x80, 0x0f, 0x80, 0x0f, 0x80, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f,
+	0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f,
+	0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f,
+	0x80, 0x0f, 0x80, 0x0f, 0x80, 0x0f, 0x80, 0x1f, 0x00, 0x7f, 0x00, 0x7f,
+	0x00, 0x7e, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x78,
+	0x00, 0x00, 0x78, 0x00, 0x00, 0x78, 0x00, 0x00, 0x78, 0x00, 0x00, 0x78,
+	0x00, 0x00, 0x78, 0x00, 0x00, 0x78, 0x3e, 0x00, 0x78, 0x7e, 0x00, 0x78,
+	0x7c, 0x00, 0x78, 0xf8, 0x00, 0x78, 0xf8, 0x00, 0x79, 0xf0, 0x00, 0x7f,
+	0xe0, 0x00, 0x7f, 0xc0, 0x00, 0x7f, 0xe0, 0x00, 0x7f, 0xe0, 0x00, 0x79,
+	0xf0, 0x00, 0x78, 0xf8, 0x00, 0x78, 0xf8, 0x00, 0x78, 0x7c, 0x00, 0x78,
+	0x3e, 0x00, 0x78, 0x3e, 0x00, 0x78, 0x1f, 0x00, 0x00, 0x7c, 0x7c, 0x7c,
+	0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c,
+	0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x00, 0x00, 0x00,
+	0x00, 0x79, 0xf8, 0x7c, 0x00, 0x7b, 0xfc, 0xfe, 0x00, 0x7f, 0xff, 0xff,
+	0x00, 0x7e, 0xff, 0xbf, 0x00, 0x7c, 0x3f, 0x0f, 0x80, 0x78, 0x3e, 0x0f,
+	0x80, 0x78, 0x3e, 0x0f, 0x80, 0x78, 0x1e, 0x0f, 0x80, 0x78, 0x1e, 0x0f,
+	0x80, 0x78, 0x1e, 0x0f, 0x80, 0x78, 0x1e, 0x0f, 0x80, 0x78, 0x1e, 0x0f,
+	0x80, 0x78, 0x1e, 0x0f, 0x80, 0x78, 0x1e, 0x0f, 0x80, 0x78, 0x1e, 0x0f,
+	0x80, 0x78, 0x1e, 0x0f, 0x80, 0x78, 0x1e, 0x0f, 0x80, 0x00, 0x00, 0x79,
+	0xf8, 0x7b, 0xfc, 0x7f, 0xfe, 0x7e, 0x7e, 0x7c, 0x3e, 0x78, 0x1e, 0x78,
+	0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78,
+	0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x00, 0x00, 0x07,
+	0xe0, 0x1f, 0xf8, 0x3f, 0xfc, 0x7e, 0x7e, 0x7c, 0x3e, 0xf8, 0x1f, 0xf8,
+	0x1f, 0xf8, 0x1f, 0xf8, 0x1f, 0xf8, 0x1f, 0xf8, 0x1f, 0xf8, 0x1f, 0x7c,
+	0x3e, 0x7e, 0x7e, 0x3f, 0xfc, 0x1f, 0xf8, 0x0f, 0xf0, 0x00, 0x00, 0x00,
+	0x00, 0x79, 0xf0, 0x7b, 0xf8, 0x7f, 0xfc, 0x7e, 0x7e, 0x7c, 0x3e, 0x78,
+	0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x78, 0x1f, 0x78,
+	0x1f, 0x7c, 0x1e, 0x7e, 0x3e, 0x7f, 0xfe, 0x7f, 0xfc, 0x79, 0xf0, 0x78,
+	0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78,
+	0x00, 0x00, 0x00, 0x0f, 0x9e, 0x1f, 0xde, 0x3f, 0xfe, 0x7e, 0x7e, 0x7c,
+	0x3e, 0xf8, 0x1e, 0xf8, 0x1e, 0xf8, 0x1e, 0xf8, 0x1e, 0xf8, 0x1e, 0xf8,
+	0x1e, 0xf8, 0x1e, 0x78, 0x3e, 0x7c, 0x7e, 0x7f, 0xfe, 0x3f, 0xfe, 0x0f,
+	0x9e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00,
+	0x1e, 0x00, 0x1e, 0x00, 0x00, 0x79, 0xc0, 0x7b, 0xc0, 0x7f, 0xc0, 0x7f,
+	0xc0, 0x7c, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78,
+	0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78,
+	0x00, 0x78, 0x00, 0x00, 0x00, 0x07, 0xf0, 0x1f, 0xf8, 0x3f, 0xfc, 0x3e,
+	0x3e, 0x3c, 0x3e, 0x3c, 0x00, 0x3f, 0x00, 0x3f, 0xe0, 0x1f, 0xf8, 0x07,
+	0xfc, 0x00, 0x7e, 0x00, 0x3e, 0x7c, 0x1e, 0x7c, 0x3e, 0x3f, 0xfe, 0x1f,
+	0xfc, 0x0f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e,
+	0x00, 0x1e, 0x00, 0xff, 0xc0, 0xff, 0xc0, 0xff, 0xc0, 0x3e, 0x00, 0x1e,
+	0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e,
+	0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1f, 0x00, 0x1f, 0xc0, 0x0f, 0xc0, 0x07,
+	0xc0, 0x00, 0x00, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78,
+	0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78,
+	0x1e, 0x78, 0x1e, 0x7c, 0x1e, 0x7e, 0x7e, 0x3f, 0xfe, 0x3f, 0xde, 0x1f,
+	0x9e, 0x00, 0x00, 0xf8, 0x1f, 0x00, 0x78, 0x1f, 0x00, 0x7c, 0x1e, 0x00,
+	0x7c, 0x3e, 0x00, 0x3c, 0x3e, 0x00, 0x3c, 0x3c, 0x00, 0x3e, 0x3c, 0x00,
+	0x1e, 0x7c, 0x00, 0x1e, 0x78, 0x00, 0x1f, 0x78, 0x00, 0x0f, 0x78, 0x00,
+	0x0f, 0xf0, 0x00, 0x0f, 0xf0, 0x00, 0x07, 0xf0, 0x00, 0x07, 0xe0, 0x00,
+	0x07, 0xe0, 0x00, 0x03, 0xe0, 0x00, 0x78, 0x38, 0x1e, 0x78, 0x3c, 0x3e,
+	0x78, 0x3c, 0x3c, 0x78, 0x7c, 0x3c, 0x3c, 0x7e, 0x3c, 0x3c, 0x7e, 0x3c,
+	0x3c, 0xfe, 0x78, 0x3c, 0xfe, 0x78, 0x1c, 0xef, 0x78, 0x1f, 0xe7, 0x78,
+	0x1f, 0xe7, 0xf0, 0x1f, 0xc7, 0xf0, 0x0f, 0xc3, 0xf0, 0x0f, 0xc3, 0xf0,
+	0x0f, 0x83, 0xe0, 0x0f, 0x83, 0xe0, 0x07, 0x81, 0xe0, 0x7c, 0x1f, 0x00,
+	0x7c, 0x3e, 0x00, 0x3e, 0x3c, 0x00, 0x1e, 0x7c, 0x00, 0x1f, 0x78, 0x00,
+	0x0f, 0xf8, 0x00, 0x0f, 0xf0, 0x00, 0x07, 0xe0, 0x00, 0x07, 0xe0, 0x00,
+	0x07, 0xf0, 0x00, 0x0f, 0xf0, 0x00, 0x0f, 0xf8, 0x00, 0x1f, 0x78, 0x00,
+	0x3e, 0x7c, 0x00, 0x3e, 0x3e, 0x00, 0x7c, 0x3e, 0x00, 0x7c, 0x1f, 0x00,
+	0xf8, 0x1f, 0x00, 0x78, 0x1f, 0x00, 0x7c, 0x1e, 0x00, 0x7c, 0x3e, 0x00,
+	0x3c, 0x3e, 0x00, 0x3e, 0x3c, 0x00, 0x3e, 0x7c, 0x00, 0x1e, 0x7c, 0x00,
+	0x1e, 0x78, 0x00, 0x1f, 0x78, 0x00, 0x0f, 0xf8, 0x00, 0x0f, 0xf0, 0x00,
+	0x0f, 0xf0, 0x00, 0x07, 0xf0, 0x00, 0x07, 0xe0, 0x00, 0x03, 0xe0, 0x00,
+	0x03, 0xc0, 0x00, 0x03, 0xc0, 0x00, 0x07, 0xc0, 0x00, 0x07, 0x80, 0x00,
+	0x3f, 0x80, 0x00, 0x3f, 0x00, 0x00, 0x3e, 0x00, 0x00, 0x3c, 0x00, 0x00,
+	0xff, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0x7f, 0xf8, 0x00, 0xf8, 0x01, 0xf0,
+	0x03, 0xe0, 0x07, 0xc0, 0x07, 0xc0, 0x0f, 0x80, 0x1f, 0x00, 0x3e, 0x00,
+	0x3e, 0x00, 0x7f, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0xff, 0xfc, 0x00, 0x80,
+	0x03, 0xc0, 0x07, 0xc0, 0x0f, 0x80, 0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00,
+	0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00, 0x1f, 0x00, 0x1e, 0x00, 0x1e, 0x00,
+	0x7e, 0x00, 0x7c, 0x00, 0x78, 0x00, 0x7c, 0x00, 0x3e, 0x00, 0x1e, 0x00,
+	0x1e, 0x00, 0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00,
+	0x0f, 0x00, 0x0f, 0x00, 0x07, 0x80, 0x07, 0xc0, 0x01, 0xc0, 0x00, 0x00,
+	0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+	0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+	0x60, 0x60, 0x60, 0x00, 0x40, 0x00, 0x70, 0x00, 0x78, 0x00, 0x3c, 0x00,
+	0x3e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00,
+	0x1e, 0x00, 0x1e, 0x00, 0x1f, 0x00, 0x0f, 0x80, 0x07, 0xc0, 0x03, 0xc0,
+	0x07, 0xc0, 0x0f, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00,
+	0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x3c, 0x00, 0x7c, 0x00,
+	0x78, 0x00, 0x70, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x3f, 0x81, 0xc0,
+	0x3f, 0xe3, 0xc0, 0x7f, 0xff, 0xc0, 0x78, 0xff, 0x80, 0x70, 0x7f, 0x00,
+	0x00, 0x1e, 0x00, 0x00, 0x00, 0x00,
+};
@@ -18,8 +18,13 @@
 #include <fcntl.h>
 #include <linux/fb.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
 #include <time.h>
 #include <errno.h>
 #include <inttypes.h>
@@ -35,18 +40,43 @@
 
 #include <d2tk/backend.h>
 
+#define _D2TK_FBDEV_Y1_THRESHOLD 0x80
+#define _D2TK_FBDEV_FRAME_NS (1000000000 / 24) // minimal frame period
+#define _D2TK_FBDEV_STATS_W 320
+#define _D2TK_FBDEV_STATS_H 140
+
+typedef void (*d2tk_fbdev_conv_t)(uint8_t *dst, const uint32_t *src,
+	d2tk_coord_t w, uint8_t invert);
+
 struct _d2tk_fbdev_t {
 	const d2tk_fbdev_config_t *config;
 	bool done;
+	bool is_file;
+	bool dirty;
+	bool frame_armed;
+	uint64_t last_expose;
 	struct udev *udev;
 	struct libinput *li;
 	struct {
 		int fb;
+		int epoll;
+		int frame; // one-shot, deferred expose
+		int timer; // optional periodic wake-up
+		int wake; // external wake-up
 	} fd;
 	uint8_t *data;
 	size_t screensize;
 	struct fb_var_screeninfo vinfo;
 	struct fb_fix_screeninfo finfo;
+	struct {
+		d2tk_fbdev_format_t format;
+		d2tk_fbdev_conv_t conv;
+		uint8_t invert;
+		uint32_t *data;
+		size_t stride; // in pixels
+		cairo_surface_t *surf;
+		cairo_t *ctx;
+	} shadow;
 	struct {
 		int32_t x;
 		int32_t y;
@@ -84,6 +114,11 @@ _d2tk_fbdev_sync(d2tk_fbdev_t *fbdev)
 {
 	int dummy = 0;
 
+	if(fbdev->is_file)
+	{
+		return 0;
+	}
+
 	if(ioctl(fbdev->fd.fb, FBIO_WAITFORVSYNC, &dummy))
 	{
 		fprintf(stderr, "Error waiting for VSYNC\n");
@@ -93,6 +128,234 @@ _d2tk_fbdev_sync(d2tk_fbdev_t *fbdev)
 	return 0;
 }
 
+/*
+ * row converters from the XRGB8888 shadow surface to the native format,
+ * written as plain branch-free loops for the compiler to vectorize
+ */
+
+static inline uint32_t
+_d2tk_fbdev_luma(uint32_t p)
+{
+	return ( ( (p >> 16) & 0xff)*77 + ( (p >> 8) & 0xff)*150 + (p & 0xff)*29) >> 8;
+}
+
+static void
+_d2tk_fbdev_conv_xrgb8888(uint8_t *dst, const uint32_t *src, d2tk_coord_t w,
+	uint8_t invert __attribute__((unused)))
+{
+	memcpy(dst, src, w*sizeof(uint32_t));
+}
+
+static void
+_d2tk_fbdev_conv_rgb565(uint8_t *dst, const uint32_t *restrict src,
+	d2tk_coord_t w, uint8_t invert __attribute__((unused)))
+{
+	uint16_t *restrict d = (uint16_t *)dst;
+
+	for(d2tk_coord_t i = 0; i < w; i++)
+	{
+		const uint32_t p = src[i];
+
+		d[i] = ( (p >> 8) & 0xf800) | ( (p >> 5) & 0x07e0) | ( (p >> 3) & 0x001f);
+	}
+}
+
+static void
+_d2tk_fbdev_conv_y8(uint8_t *restrict dst, const uint32_t *restrict src,
+	d2tk_coord_t w, uint8_t invert __attribute__((unused)))
+{
+	for(d2tk_coord_t i = 0; i < w; i++)
+	{
+		dst[i] = _d2tk_fbdev_luma(src[i]);
+	}
+}
+
+static void
+_d2tk_fbdev_conv_y1(uint8_t *restrict dst, const uint32_t *restrict src,
+	d2tk_coord_t w, uint8_t invert)
+{
+	// w is a multiple of 8
+	for(d2tk_coord_t i = 0; i < w/8; i++)
+	{
+		const uint32_t *restrict s = &src[i*8];
+		uint8_t b = 0;
+
+		for(unsigned j = 0; j < 8; j++)
+		{
+			b |= (_d2tk_fbdev_luma(s[j]) >= _D2TK_FBDEV_Y1_THRESHOLD) << (7 - j);
+		}
+
+		dst[i] = b ^ invert;
+	}
+}
+
+static int
+_d2tk_fbdev_format_query(d2tk_fbdev_t *fbdev)
+{
+	switch(fbdev->vinfo.bits_per_pixel)
+	{
+		case 32:
+		{
+			fbdev->shadow.format = D2TK_FBDEV_FORMAT_XRGB8888;
+		} return 0;
+		case 16:
+		{
+			fbdev->shadow.format = D2TK_FBDEV_FORMAT_RGB565;
+		} return 0;
+		case 8:
+		{
+			fbdev->shadow.format = D2TK_FBDEV_FORMAT_Y8;
+		} return 0;
+		case 1:
+		{
+			fbdev->shadow.format = D2TK_FBDEV_FORMAT_Y1;
+			fbdev->shadow.invert = (fbdev->finfo.visual == FB_VISUAL_MONO01)
+				? 0xff // 1 is black
+				: 0x0;
+		} return 0;
+	}
+
+	return -1;
+}
+
+static int
+_d2tk_fbdev_format_fake(d2tk_fbdev_t *fbdev, const d2tk_fbdev_config_t *config)
+{
+	if( (config->w <= 0) || (config->h <= 0) )
+	{
+		return -1;
+	}
+
+	fbdev->shadow.format = config->format;
+	fbdev->vinfo.xres = fbdev->vinfo.xres_virtual = config->w;
+	fbdev->vinfo.yres = fbdev->vinfo.yres_virtual = config->h;
+
+	switch(config->format)
+	{
+		case D2TK_FBDEV_FORMAT_XRGB8888:
+		{
+			fbdev->vinfo.bits_per_pixel = 32;
+		} break;
+		case D2TK_FBDEV_FORMAT_RGB565:
+		{
+			fbdev->vinfo.bits_per_pixel = 16;
+		} break;
+		case D2TK_FBDEV_FORMAT_Y8:
+		{
+			fbdev->vinfo.bits_per_pixel = 8;
+		} break;
+		case D2TK_FBDEV_FORMAT_Y1:
+		{
+			fbdev->vinfo.bits_per_pixel = 1;
+		} break;
+		case D2TK_FBDEV_FORMAT_AUTO:
+		{
+			// cannot be queried from a file
+		} return -1;
+	}
+
+	fbdev->finfo.line_length = (config->w*fbdev->vinfo.bits_per_pixel + 7) / 8;
+	fbdev->finfo.smem_len = fbdev->finfo.line_length * config->h;
+
+	return 0;
+}
+
+static int
+_d2tk_fbdev_shadow_init(d2tk_fbdev_t *fbdev)
+{
+	switch(fbdev->shadow.format)
+	{
+		case D2TK_FBDEV_FORMAT_XRGB8888:
+		{
+			fbdev->shadow.conv = _d2tk_fbdev_conv_xrgb8888;
+		} break;
+		case D2TK_FBDEV_FORMAT_RGB565:
+		{
+			fbdev->shadow.conv = _d2tk_fbdev_conv_rgb565;
+		} break;
+		case D2TK_FBDEV_FORMAT_Y8:
+		{
+			fbdev->shadow.conv = _d2tk_fbdev_conv_y8;
+		} break;
+		case D2TK_FBDEV_FORMAT_Y1:
+		{
+			fbdev->shadow.conv = _d2tk_fbdev_conv_y1;
+		} break;
+		case D2TK_FBDEV_FORMAT_AUTO:
+		{
+			// not reached
+		} return -1;
+	}
+
+	// pad rows to whole bytes of Y1 and whole cache lines
+	const size_t w = fbdev->vinfo.xres_virtual;
+	const size_t h = fbdev->vinfo.yres_virtual;
+
+	fbdev->shadow.stride = (w + 15) & (~15);
+	fbdev->shadow.data = aligned_alloc(64,
+		fbdev->shadow.stride * h * sizeof(uint32_t));
+	if(!fbdev->shadow.data)
+	{
+		return -1;
+	}
+
+	memset(fbdev->shadow.data, 0x0, fbdev->shadow.stride * h * sizeof(uint32_t));
+
+	return 0;
+}
+
+// convert and copy the rectangles redrawn in last frame to the framebuffer
+static void
+_d2tk_fbdev_flush(d2tk_fbdev_t *fbdev)
+{
+	const d2tk_fbdev_config_t *config = fbdev->config;
+	const d2tk_coord_t W = fbdev->vinfo.xres_virtual;
+	const d2tk_coord_t H = fbdev->vinfo.yres_virtual;
+	const unsigned bpp = fbdev->vinfo.bits_per_pixel;
+
+	unsigned nrects;
+	const d2tk_rect_t *rects = d2tk_base_get_dirty_rects(fbdev->base, &nrects);
+
+	for(unsigned i = 0; i < nrects; i++)
+	{
+		d2tk_coord_t x0 = rects[i].x;
+		d2tk_coord_t y0 = rects[i].y;
+		d2tk_coord_t x1 = x0 + rects[i].w;
+		d2tk_coord_t y1 = y0 + rects[i].h;
+
+		d2tk_clip_int32(0, &x0, W);
+		d2tk_clip_int32(0, &y0, H);
+		d2tk_clip_int32(0, &x1, W);
+		d2tk_clip_int32(0, &y1, H);
+
+		if(bpp == 1) // align to whole bytes
+		{
+			x0 &= ~7;
+			x1 = (x1 + 7) & (~7);
+		}
+
+		if( (x1 <= x0) || (y1 <= y0) )
+		{
+			continue;
+		}
+
+		for(d2tk_coord_t y = y0; y < y1; y++)
+		{
+			const uint32_t *src = &fbdev->shadow.data[y*fbdev->shadow.stride + x0];
+			uint8_t *dst = &fbdev->data[y*fbdev->finfo.line_length + x0*bpp/8];
+
+			fbdev->shadow.conv(dst, src, x1 - x0, fbdev->shadow.invert);
+		}
+
+		if(config->update)
+		{
+			const d2tk_rect_t rect = D2TK_RECT(x0, y0, x1 - x0, y1 - y0);
+
+			config->update(config->data, &rect);
+		}
+	}
+}
+
 static void
 _d2tk_fbdev_destroy(void *data)
 {
@@ -106,15 +369,116 @@ _d2tk_fbdev_destroy(void *data)
 	munmap(fbdev->data, fbdev->screensize);
 	fbdev->data = NULL;
 
+	free(fbdev->shadow.data);
+	fbdev->shadow.data = NULL;
+
+	close(fbdev->fd.wake);
+	close(fbdev->fd.timer);
+	close(fbdev->fd.frame);
+	close(fbdev->fd.epoll);
+
 	close(fbdev->fd.fb);
 	libinput_unref(fbdev->li);
 	udev_unref(fbdev->udev);
 }
 
+static inline uint64_t
+_d2tk_fbdev_now()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec*1000000000ULL + ts.tv_nsec;
+}
+
+static inline void
+_d2tk_fbdev_arm(int fd, uint64_t ns, uint64_t interval, int flags)
+{
+	const struct itimerspec its = {
+		.it_value = {
+			.tv_sec = ns / 1000000000,
+			.tv_nsec = ns % 1000000000
+		},
+		.it_interval = {
+			.tv_sec = interval / 1000000000,
+			.tv_nsec = interval % 1000000000
+		}
+	};
+
+	timerfd_settime(fd, flags, &its, NULL);
+}
+
+// read and reset a timerfd or eventfd counter, never blocks
+static inline uint64_t
+_d2tk_fbdev_drain(int fd)
+{
+	uint64_t cnt = 0;
+
+	if( (fd == -1) || (read(fd, &cnt, sizeof(cnt)) != sizeof(cnt)) )
+	{
+		return 0;
+	}
+
+	return cnt;
+}
+
+static int
+_d2tk_fbdev_watch(d2tk_fbdev_t *fbdev, int fd)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN
+	};
+
+	return epoll_ctl(fbdev->fd.epoll, EPOLL_CTL_ADD, fd, &ev);
+}
+
+static int
+_d2tk_fbdev_loop_init(d2tk_fbdev_t *fbdev, const d2tk_fbdev_config_t *config)
+{
+	fbdev->fd.epoll = epoll_create1(EPOLL_CLOEXEC);
+	fbdev->fd.frame = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	fbdev->fd.wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	fbdev->fd.timer = config->timeout
+		? timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)
+		: -1;
+
+	if( (fbdev->fd.epoll == -1) || (fbdev->fd.frame == -1)
+		|| (fbdev->fd.wake == -1) || (config->timeout && (fbdev->fd.timer == -1)) )
+	{
+		return -1;
+	}
+
+	if(_d2tk_fbdev_watch(fbdev, libinput_get_fd(fbdev->li))
+		|| _d2tk_fbdev_watch(fbdev, fbdev->fd.frame)
+		|| _d2tk_fbdev_watch(fbdev, fbdev->fd.wake) )
+	{
+		return -1;
+	}
+
+	if(config->timeout)
+	{
+		const uint64_t ns = config->timeout * 1000000ULL;
+
+		if(_d2tk_fbdev_watch(fbdev, fbdev->fd.timer))
+		{
+			return -1;
+		}
+
+		_d2tk_fbdev_arm(fbdev->fd.timer, ns, ns, 0);
+	}
+
+	fbdev->dirty = true; // initial expose
+
+	return 0;
+}
+
 static cairo_surface_t *
-_d2tk_fbdev_create(d2tk_fbdev_t *fbdev, const char *fb_device)
+_d2tk_fbdev_create(d2tk_fbdev_t *fbdev, const d2tk_fbdev_config_t *config)
 {
+	const char *fb_device = config->fb_device;
 	cairo_surface_t *surface;
+	struct stat st;
 
 	fbdev->udev = udev_new();
 	if(!fbdev->udev)
@@ -132,26 +496,54 @@ _d2tk_fbdev_create(d2tk_fbdev_t *fbdev, const char *fb_device)
 	libinput_udev_assign_seat(fbdev->li, "seat0");
 
 	// Open the file for reading and writing
-	fbdev->fd.fb = open(fb_device, O_RDWR);
+	fbdev->fd.fb = (config->format == D2TK_FBDEV_FORMAT_AUTO)
+		? open(fb_device, O_RDWR)
+		: open(fb_device, O_RDWR | O_CREAT, 0644);
 	if(fbdev->fd.fb == -1) {
 		fprintf(stderr, "Error: cannot open framebuffer fbdev\n");
 		goto handle_allocate_error;
 	}
 
-	// Get variable screen information
-	if(ioctl(fbdev->fd.fb, FBIOGET_VSCREENINFO, &fbdev->vinfo) == -1) {
-		fprintf(stderr, "Error: reading variable information\n");
-		goto handle_ioctl_error;
+	fbdev->is_file = !fstat(fbdev->fd.fb, &st) && S_ISREG(st.st_mode);
+
+	if(fbdev->is_file)
+	{
+		// file-backed framebuffer with given geometry, e.g. for testing
+		if(_d2tk_fbdev_format_fake(fbdev, config) == -1) {
+			fprintf(stderr, "Error: invalid geometry of file-backed framebuffer\n");
+			goto handle_ioctl_error;
+		}
+
+		if( (st.st_size < (off_t)fbdev->finfo.smem_len)
+			&& (ftruncate(fbdev->fd.fb, fbdev->finfo.smem_len) == -1) ) {
+			fprintf(stderr, "Error: cannot resize file-backed framebuffer\n");
+			goto handle_ioctl_error;
+		}
 	}
+	else
+	{
+		// Get variable screen information
+		if(ioctl(fbdev->fd.fb, FBIOGET_VSCREENINFO, &fbdev->vinfo) == -1) {
+			fprintf(stderr, "Error: reading variable information\n");
+			goto handle_ioctl_error;
+		}
 
-	// Get fixed screen information
-	if(ioctl(fbdev->fd.fb, FBIOGET_FSCREENINFO, &fbdev->finfo) == -1) {
-		fprintf(stderr, "Error reading fixed information\n");
-		goto handle_ioctl_error;
+		// Get fixed screen information
+		if(ioctl(fbdev->fd.fb, FBIOGET_FSCREENINFO, &fbdev->finfo) == -1) {
+			fprintf(stderr, "Error reading fixed information\n");
+			goto handle_ioctl_error;
+		}
+
+		if(_d2tk_fbdev_format_query(fbdev) == -1) {
+			fprintf(stderr, "Error: unsupported pixel format (%"PRIu32" bpp)\n",
+				fbdev->vinfo.bits_per_pixel);
+			goto handle_ioctl_error;
+		}
 	}
 
 	// Map the fbdev to memory
-	fbdev->data = (uint8_t *)mmap(0, fbdev->finfo.smem_len,
+	fbdev->screensize = fbdev->finfo.smem_len;
+	fbdev->data = (uint8_t *)mmap(0, fbdev->screensize,
 			PROT_READ | PROT_WRITE, MAP_SHARED,
 			fbdev->fd.fb, 0);
 	if((intptr_t)fbdev->data == -1) {
@@ -159,13 +551,26 @@ _d2tk_fbdev_create(d2tk_fbdev_t *fbdev, const char *fb_device)
 		goto handle_ioctl_error;
 	}
 
+	if(_d2tk_fbdev_shadow_init(fbdev) == -1) {
+		fprintf(stderr, "Error: failed to allocate shadow surface\n");
+		munmap(fbdev->data, fbdev->screensize);
+		goto handle_ioctl_error;
+	}
+
+	if(_d2tk_fbdev_loop_init(fbdev, config) == -1) {
+		fprintf(stderr, "Error: failed to set up event loop\n");
+		munmap(fbdev->data, fbdev->screensize);
+		goto handle_ioctl_error;
+	}
 
-	/* Create the cairo surface which will be used to draw to */
-	surface = cairo_image_surface_create_for_data(fbdev->data,
+	/* Create the shadow cairo surface which will be used to draw to, damaged
+	 * areas are converted to the framebuffer after each frame */
+	surface = cairo_image_surface_create_for_data(
+			(uint8_t *)fbdev->shadow.data,
 			CAIRO_FORMAT_RGB24,
 			fbdev->vinfo.xres_virtual,
 			fbdev->vinfo.yres_virtual,
-			fbdev->finfo.smem_len / fbdev->vinfo.yres_virtual);
+			fbdev->shadow.stride * sizeof(uint32_t));
 
 	cairo_surface_set_user_data(surface, NULL, fbdev,
 			&_d2tk_fbdev_destroy);
@@ -202,8 +607,15 @@ _d2tk_fbdev_expose(d2tk_fbdev_t *fbdev)
 
 		fbdev->config->expose(fbdev->config->data, w, h);
 
+		if(fbdev->config->stats)
+		{
+			d2tk_base_stats(base, &D2TK_RECT(0, 0, _D2TK_FBDEV_STATS_W,
+				_D2TK_FBDEV_STATS_H));
+		}
+
 		d2tk_base_post(base);
 
+		_d2tk_fbdev_flush(fbdev);
 	} while(d2tk_base_get_again(base));
 
 	_d2tk_fbdev_sync(fbdev);
@@ -212,6 +624,20 @@ _d2tk_fbdev_expose(d2tk_fbdev_t *fbdev)
 D2TK_API int
 d2tk_fbdev_step(d2tk_fbdev_t *fbdev)
 {
+	const uint64_t wakes = _d2tk_fbdev_drain(fbdev->fd.wake);
+	const uint64_t ticks = _d2tk_fbdev_drain(fbdev->fd.timer);
+
+	if(wakes || ticks)
+	{
+		fbdev->dirty = true;
+	}
+
+	if(_d2tk_fbdev_drain(fbdev->fd.frame))
+	{
+		fbdev->frame_armed = false;
+	}
+
+	// drain all pending input, bursts are coalesced into a single expose
 	while(true)
 	{
 		libinput_dispatch(fbdev->li);
@@ -222,7 +648,17 @@ d2tk_fbdev_step(d2tk_fbdev_t *fbdev)
 			break;
 		}
 
-		switch(libinput_event_get_type(ev))
+		const enum libinput_event_type type = libinput_event_get_type(ev);
+
+		// any input may change the GUI, except for device hotplug
+		if( (type != LIBINPUT_EVENT_NONE)
+			&& (type != LIBINPUT_EVENT_DEVICE_ADDED)
+			&& (type != LIBINPUT_EVENT_DEVICE_REMOVED) )
+		{
+			fbdev->dirty = true;
+		}
+
+		switch(type)
 		{
 			case LIBINPUT_EVENT_NONE:
 			{
@@ -630,7 +1066,25 @@ d2tk_fbdev_step(d2tk_fbdev_t *fbdev)
 		libinput_event_destroy(ev);
 	}
 
-	_d2tk_fbdev_expose(fbdev);
+	if(fbdev->dirty)
+	{
+		const uint64_t now = _d2tk_fbdev_now();
+		const uint64_t next = fbdev->last_expose + _D2TK_FBDEV_FRAME_NS;
+
+		if(now >= next)
+		{
+			fbdev->dirty = false;
+			fbdev->last_expose = now;
+
+			_d2tk_fbdev_expose(fbdev);
+		}
+		else if(!fbdev->frame_armed) // defer to end of frame period
+		{
+			fbdev->frame_armed = true;
+
+			_d2tk_fbdev_arm(fbdev->fd.frame, next, 0, TFD_TIMER_ABSTIME);
+		}
+	}
 
 	return fbdev->done;
 }
@@ -638,31 +1092,36 @@ d2tk_fbdev_step(d2tk_fbdev_t *fbdev)
 D2TK_API void
 d2tk_fbdev_run(d2tk_fbdev_t *fbdev, const sig_atomic_t *done)
 {
-	const unsigned step = 1000000000 / 24;
-	struct timespec to;
-	clock_gettime(CLOCK_MONOTONIC, &to);
-
 	while(!*done)
 	{
-		if(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &to, NULL))
+		if(d2tk_fbdev_step(fbdev))
 		{
-			continue;
+			break;
 		}
 
-		to.tv_nsec += step;
-		while(to.tv_nsec >= 1000000000)
-		{
-			to.tv_sec += 1;
-			to.tv_nsec -= 1000000000;
-		}
+		// sleep until input, a deferred expose or a wake-up arrives
+		struct epoll_event evs [4];
 
-		if(d2tk_fbdev_step(fbdev))
+		if( (epoll_wait(fbdev->fd.epoll, evs, 4, -1) == -1) && (errno != EINTR) )
 		{
+			fprintf(stderr, "Error: epoll_wait\n");
 			break;
 		}
 	}
 }
 
+D2TK_API void
+d2tk_fbdev_redisplay(d2tk_fbdev_t *fbdev)
+{
+	const uint64_t cnt = 1;
+
+	// async-signal- and thread-safe
+	if(write(fbdev->fd.wake, &cnt, sizeof(cnt)) != sizeof(cnt))
+	{
+		// counter saturated, a wake-up is pending anyway
+	}
+}
+
 D2TK_API void
 d2tk_fbdev_free(d2tk_fbdev_t *fbdev)
 {
@@ -675,7 +1134,15 @@ d2tk_fbdev_free(d2tk_fbdev_t *fbdev)
 		d2tk_core_driver.free(fbdev->ctx);
 	}
 
-	//FIXME fbdevDestroy(fbdev->view);
+	if(fbdev->shadow.ctx)
+	{
+		cairo_destroy(fbdev->shadow.ctx);
+	}
+
+	if(fbdev->shadow.surf)
+	{
+		cairo_surface_destroy(fbdev->shadow.surf); // unmaps framebuffer
+	}
 
 	free(fbdev);
 }
@@ -691,14 +1158,10 @@ d2tk_fbdev_new(const d2tk_fbdev_config_t *config)
 
 	fbdev->config = config;
 
-	cairo_surface_t *surf = _d2tk_fbdev_create(fbdev, fbdev->config->fb_device);
-	cairo_t *ctx = cairo_create(surf);
-
-	//FIXME
-	//cairo_destroy(ctx);
-	//cairo_surface_destroy(surf);
+	fbdev->shadow.surf = _d2tk_fbdev_create(fbdev, fbdev->config);
+	fbdev->shadow.ctx = cairo_create(fbdev->shadow.surf);
 
-	fbdev->ctx = d2tk_core_driver.new(config->bundle_path, ctx);
+	fbdev->ctx = d2tk_core_driver.new(config->bundle_path, fbdev->shadow.ctx);
 
 	if(!fbdev->ctx)
 	{
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cairo/cairo.h>
+
+#include "core_internal.h"
+#include <d2tk/frontend_offscreen.h>
+#include <d2tk/backend.h>
+
+struct _d2tk_offscreen_t {
+	const d2tk_offscreen_config_t *config;
+	cairo_surface_t *surf;
+	cairo_t *cairo;
+	d2tk_base_t *base;
+	void *ctx;
+};
+
+static inline void
+_d2tk_offscreen_expose(d2tk_offscreen_t *offscreen)
+{
+	d2tk_base_t *base = offscreen->base;
+	d2tk_coord_t w;
+	d2tk_coord_t h;
+
+	d2tk_base_get_dimensions(base, &w, &h);
+
+	do
+	{
+		d2tk_base_pre(base);
+
+		offscreen->config->expose(offscreen->config->data, w, h);
+
+		d2tk_base_post(base);
+	} while(d2tk_base_get_again(base));
+}
+
+D2TK_API int
+d2tk_offscreen_step(d2tk_offscreen_t *offscreen)
+{
+	_d2tk_offscreen_expose(offscreen);
+
+	return 0;
+}
+
+D2TK_API const uint32_t *
+d2tk_offscreen_get_pixels(d2tk_offscreen_t *offscreen, size_t *stride)
+{
+	cairo_surface_flush(offscreen->surf);
+
+	if(stride)
+	{
+		*stride = cairo_image_surface_get_stride(offscreen->surf);
+	}
+
+	return (const uint32_t *)cairo_image_surface_get_data(offscreen->surf);
+}
+
+D2TK_API void
+d2tk_offscreen_free(d2tk_offscreen_t *offscreen)
+{
+	if(offscreen->ctx)
+	{
+		if(offscreen->base)
+		{
+			d2tk_base_free(offscreen->base);
+		}
+		d2tk_core_driver.free(offscreen->ctx);
+	}
+
+	if(offscreen->cairo)
+	{
+		cairo_destroy(offscreen->cairo);
+	}
+
+	if(offscreen->surf)
+	{
+		cairo_surface_destroy(offscreen->surf);
+	}
+
+	free(offscreen);
+}
+
+D2TK_API d2tk_offscreen_t *
+d2tk_offscreen_new(const d2tk_offscreen_config_t *config)
+{
+	d2tk_offscreen_t *offscreen = calloc(1, sizeof(d2tk_offscreen_t));
+	if(!offscreen)
+	{
+		goto fail;
+	}
+
+	offscreen->config = config;
+
+	offscreen->surf = cairo_image_surface_create(CAIRO_FORMAT_RGB24,
+		config->w, config->h);
+	if(cairo_surface_status(offscreen->surf) != CAIRO_STATUS_SUCCESS)
+	{
+		fprintf(stderr, "cairo_image_surface_create failed\n");
+		goto fail;
+	}
+
+	offscreen->cairo = cairo_create(offscreen->surf);
+	if(cairo_status(offscreen->cairo) != CAIRO_STATUS_SUCCESS)
+	{
+		fprintf(stderr, "cairo_create failed\n");
+		goto fail;
+	}
+
+	offscreen->ctx = d2tk_core_driver.new(config->bundle_path, offscreen->cairo);
+	if(!offscreen->ctx)
+	{
+		goto fail;
+	}
+
+	offscreen->base = d2tk_base_new(&d2tk_core_driver, offscreen->ctx);
+	if(!offscreen->base)
+	{
+		goto fail;
+	}
+
+	d2tk_base_set_dimensions(offscreen->base, config->w, config->h);
+
+	return offscreen;
+
+fail:
+	if(offscreen)
+	{
+		d2tk_offscreen_free(offscreen);
+	}
+
+	return NULL;
+}
+
+D2TK_API d2tk_base_t *
+d2tk_offscreen_get_base(d2tk_offscreen_t *offscreen)
+{
+	return offscreen->base;
+}
@@ -30,9 +30,13 @@
 
 #include "core_internal.h"
 #include <d2tk/frontend_pugl.h>
+#include <d2tk/trace.h>
 
 #include <d2tk/backend.h>
 
+#define _D2TK_PUGL_STATS_W 320
+#define _D2TK_PUGL_STATS_H 140
+
 struct _d2tk_pugl_t {
 	const d2tk_pugl_config_t *config;
 	bool done;
@@ -47,10 +51,37 @@ _d2tk_pugl_close(d2tk_pugl_t *dpugl)
 	dpugl->done = true;
 }
 
+static inline void
+_d2tk_pugl_damage(d2tk_pugl_t *dpugl)
+{
+	unsigned nrects;
+	const d2tk_rect_t *rects = d2tk_base_get_dirty_rects(dpugl->base, &nrects);
+
+	if(nrects > PUGL_MAX_DAMAGE)
+	{
+		puglSetDamage(dpugl->view, NULL, -1); // present whole view
+		return;
+	}
+
+	PuglRect damage [PUGL_MAX_DAMAGE];
+
+	for(unsigned i = 0; i < nrects; i++)
+	{
+		damage[i].x = rects[i].x;
+		damage[i].y = rects[i].y;
+		damage[i].width = rects[i].w;
+		damage[i].height = rects[i].h;
+	}
+
+	// only present what has been redrawn
+	puglSetDamage(dpugl->view, damage, nrects);
+}
+
 static inline void
 _d2tk_pugl_expose(d2tk_pugl_t *dpugl)
 {
 	d2tk_base_t *base = dpugl->base;
+	const uint64_t t_expose = d2tk_trace_begin();
 
 	d2tk_coord_t w;
 	d2tk_coord_t h;
@@ -60,8 +91,20 @@ _d2tk_pugl_expose(d2tk_pugl_t *dpugl)
 
 	dpugl->config->expose(dpugl->config->data, w, h);
 
+	if(dpugl->config->stats)
+	{
+		const float scale = d2tk_pugl_get_scale();
+
+		d2tk_base_stats(base, &D2TK_RECT(0, 0, scale*_D2TK_PUGL_STATS_W,
+			scale*_D2TK_PUGL_STATS_H));
+	}
+
 	d2tk_base_post(base);
 
+	_d2tk_pugl_damage(dpugl);
+
+	d2tk_trace_end("pugl", "expose", t_expose);
+
 	if(d2tk_base_get_again(base))
 	{
 		puglPostRedisplay(dpugl->view);
@@ -518,6 +561,8 @@ fail:
 D2TK_API void
 d2tk_pugl_redisplay(d2tk_pugl_t *dpugl)
 {
+	d2tk_trace_instant("pugl", "redisplay");
+
 	puglPostRedisplay(dpugl->view);
 }
 
@@ -17,11 +17,20 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdbool.h>
 
 #include <d2tk/hash.h>
 
 #include "mum.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#	include <immintrin.h>
+#	define _D2TK_HASH_X86
+#elif defined(__ARM_NEON) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#	include <arm_neon.h>
+#	define _D2TK_HASH_NEON
+#endif
+
 #define SEED 12345
 
 __attribute__((always_inline))
@@ -31,10 +40,195 @@ _len(const void *key, ssize_t len)
 	return (len == -1) ? strlen((const char *)key) : (size_t)len;
 }
 
+#define STRIPE (D2TK_HASH_LANES * sizeof(uint64_t))
+
+// accumulates stripes into independent lanes, lane i takes in
+//   word[i ^ 1] + lo32(word[i] ^ prime[i]) * hi32(word[i] ^ prime[i])
+// which maps onto single 32x32->64 bit vector multiplies, all variants yield
+// the same result
+#if defined(_D2TK_HASH_X86)
+__attribute__((target("avx2")))
+static void
+_d2tk_hash_accumulate_avx2(uint64_t *acc, const uint8_t *src, size_t nstripes)
+{
+	const __m256i k0 = _mm256_loadu_si256((const __m256i *)&_mum_primes[0]);
+	const __m256i k1 = _mm256_loadu_si256((const __m256i *)&_mum_primes[4]);
+	__m256i a0 = _mm256_loadu_si256((const __m256i *)&acc[0]);
+	__m256i a1 = _mm256_loadu_si256((const __m256i *)&acc[4]);
+
+	for(size_t s = 0; s < nstripes; s++, src += STRIPE)
+	{
+		const __m256i d0 = _mm256_loadu_si256((const __m256i *)&src[0]);
+		const __m256i d1 = _mm256_loadu_si256((const __m256i *)&src[32]);
+		const __m256i x0 = _mm256_xor_si256(d0, k0);
+		const __m256i x1 = _mm256_xor_si256(d1, k1);
+
+		a0 = _mm256_add_epi64(a0, _mm256_add_epi64(
+			_mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2)),
+			_mm256_mul_epu32(x0, _mm256_srli_epi64(x0, 32))));
+		a1 = _mm256_add_epi64(a1, _mm256_add_epi64(
+			_mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2)),
+			_mm256_mul_epu32(x1, _mm256_srli_epi64(x1, 32))));
+	}
+
+	_mm256_storeu_si256((__m256i *)&acc[0], a0);
+	_mm256_storeu_si256((__m256i *)&acc[4], a1);
+}
+#endif
+
+__attribute__((always_inline))
+static inline void
+_d2tk_hash_accumulate_base(uint64_t *acc, const uint8_t *src, size_t nstripes)
+{
+#if defined(_D2TK_HASH_NEON)
+	uint64x2_t k [4];
+	uint64x2_t a [4];
+
+	for(unsigned j = 0; j < 4; j++)
+	{
+		k[j] = vld1q_u64(&_mum_primes[2*j]);
+		a[j] = vld1q_u64(&acc[2*j]);
+	}
+
+	for(size_t s = 0; s < nstripes; s++, src += STRIPE)
+	{
+		for(unsigned j = 0; j < 4; j++)
+		{
+			const uint64x2_t d = vreinterpretq_u64_u8(vld1q_u8(&src[16*j]));
+			const uint64x2_t x = veorq_u64(d, k[j]);
+
+			a[j] = vaddq_u64(a[j], vaddq_u64(vextq_u64(d, d, 1),
+				vmull_u32(vmovn_u64(x), vshrn_n_u64(x, 32))));
+		}
+	}
+
+	for(unsigned j = 0; j < 4; j++)
+	{
+		vst1q_u64(&acc[2*j], a[j]);
+	}
+#else
+	for(size_t s = 0; s < nstripes; s++, src += STRIPE)
+	{
+		uint64_t val [D2TK_HASH_LANES];
+
+		memcpy(val, src, STRIPE);
+
+		for(unsigned i = 0; i < D2TK_HASH_LANES; i++)
+		{
+			const uint64_t key = _mum_le(val[i]) ^ _mum_primes[i];
+
+			acc[i] += _mum_le(val[i ^ 1]) + (key & 0xffffffff) * (key >> 32);
+		}
+	}
+#endif
+}
+
+#if defined(__AVX2__)
+#	define _d2tk_hash_accumulate _d2tk_hash_accumulate_avx2
+#elif defined(_D2TK_HASH_X86)
+// builds do not target avx2, thus pick it at runtime, it is what makes the
+// wide path faster than plain mum, sse2 is not and thus not implemented
+static bool _d2tk_hash_avx2 = false;
+
+__attribute__((constructor))
+static void
+_d2tk_hash_dispatch(void)
+{
+	__builtin_cpu_init();
+	_d2tk_hash_avx2 = __builtin_cpu_supports("avx2");
+}
+
+__attribute__((always_inline))
+static inline void
+_d2tk_hash_accumulate(uint64_t *acc, const uint8_t *src, size_t nstripes)
+{
+	if(_d2tk_hash_avx2)
+	{
+		_d2tk_hash_accumulate_avx2(acc, src, nstripes);
+	}
+	else
+	{
+		_d2tk_hash_accumulate_base(acc, src, nstripes);
+	}
+}
+#else
+#	define _d2tk_hash_accumulate _d2tk_hash_accumulate_base
+#endif
+
+__attribute__((always_inline))
+static inline void
+_d2tk_hash_block(uint64_t *acc, const uint8_t *src)
+{
+	_d2tk_hash_accumulate(acc, src, D2TK_HASH_BLOCK / STRIPE);
+
+	// scramble lanes so high bits feed back into the products
+	for(unsigned i = 0; i < D2TK_HASH_LANES; i++)
+	{
+		uint64_t a = acc[i];
+
+		a ^= a >> 47;
+		a ^= _mum_primes[D2TK_HASH_LANES + i];
+		a *= 0x9e3779b1;
+
+		acc[i] = a;
+	}
+}
+
+__attribute__((always_inline))
+static inline void
+_d2tk_hash_wide_init(uint64_t *acc)
+{
+	for(unsigned i = 0; i < D2TK_HASH_LANES; i++)
+	{
+		acc[i] = SEED ^ _mum_primes[D2TK_HASH_LANES - 1 - i];
+	}
+}
+
+// tail is 1 to D2TK_HASH_BLOCK bytes
+static uint64_t
+_d2tk_hash_wide_final(const uint64_t *acc, const uint8_t *tail, size_t ntail,
+	uint64_t len)
+{
+	uint64_t tmp [D2TK_HASH_LANES];
+	const size_t s = ntail / STRIPE * STRIPE;
+
+	memcpy(tmp, acc, sizeof(tmp));
+	_d2tk_hash_accumulate(tmp, tail, ntail / STRIPE);
+
+	uint64_t hash = _mum_hash_aligned(SEED + len, tmp, sizeof(tmp));
+	hash = _mum_hash_aligned(hash, &tail[s], ntail - s);
+
+	return mum_hash_finish(hash);
+}
+
+static uint64_t
+_d2tk_hash_wide(const void *key, size_t len)
+{
+	const uint8_t *src = key;
+	uint64_t acc [D2TK_HASH_LANES];
+	size_t off = 0;
+
+	_d2tk_hash_wide_init(acc);
+
+	for( ; len - off > D2TK_HASH_BLOCK; off += D2TK_HASH_BLOCK)
+	{
+		_d2tk_hash_block(acc, &src[off]);
+	}
+
+	return _d2tk_hash_wide_final(acc, &src[off], len - off, len);
+}
+
 __attribute__((always_inline))
 static inline uint64_t
 _d2tk_hash(uint64_t hash, const void *key, size_t len)
 {
+	if(len > D2TK_HASH_BLOCK)
+	{
+		const uint64_t wide = _d2tk_hash_wide(key, len);
+
+		return _mum_hash_aligned(hash + len, &wide, sizeof(wide));
+	}
+
 	return _mum_hash_aligned(hash + len, key, len);
 }
 
@@ -43,6 +237,11 @@ d2tk_hash(const void *key, ssize_t len)
 {
 	len = _len(key, len);
 
+	if(len > D2TK_HASH_BLOCK)
+	{
+		return _d2tk_hash_wide(key, len);
+	}
+
 	return mum_hash(key, len, SEED);
 }
 
@@ -80,3 +279,98 @@ d2tk_hash_dict(const d2tk_hash_dict_t *dict)
 
 	return mum_hash_finish(hash);
 }
+
+D2TK_API void
+d2tk_hasher_init(d2tk_hasher_t *hasher)
+{
+	hasher->state = mum_hash_init(SEED);
+}
+
+D2TK_API void
+d2tk_hasher_update(d2tk_hasher_t *hasher, const void *key, size_t len)
+{
+	hasher->state = _d2tk_hash(hasher->state, key, len);
+}
+
+D2TK_API void
+d2tk_hasher_update_str(d2tk_hasher_t *hasher, const char *str)
+{
+	hasher->state = _d2tk_hash(hasher->state, str, strlen(str));
+}
+
+D2TK_API void
+d2tk_hasher_update_u32(d2tk_hasher_t *hasher, uint32_t val)
+{
+	hasher->state = _d2tk_hash(hasher->state, &val, sizeof(uint32_t));
+}
+
+D2TK_API void
+d2tk_hasher_update_u64(d2tk_hasher_t *hasher, uint64_t val)
+{
+	hasher->state = _d2tk_hash(hasher->state, &val, sizeof(uint64_t));
+}
+
+D2TK_API uint64_t
+d2tk_hasher_final(const d2tk_hasher_t *hasher)
+{
+	return mum_hash_finish(hasher->state);
+}
+
+D2TK_API void
+d2tk_hash_stream_init(d2tk_hash_stream_t *stream)
+{
+	_d2tk_hash_wide_init(stream->acc);
+	stream->len = 0;
+	stream->fill = 0;
+}
+
+D2TK_API void
+d2tk_hash_stream_update(d2tk_hash_stream_t *stream, const void *data,
+	size_t len)
+{
+	const uint8_t *src = data;
+
+	while(len)
+	{
+		// only consume a full block once more data follows, the last one is the tail
+		if(stream->fill == D2TK_HASH_BLOCK)
+		{
+			_d2tk_hash_block(stream->acc, stream->buf);
+			stream->fill = 0;
+		}
+
+		if(stream->fill == 0)
+		{
+			for( ; len > D2TK_HASH_BLOCK; len -= D2TK_HASH_BLOCK)
+			{
+				_d2tk_hash_block(stream->acc, src);
+				src += D2TK_HASH_BLOCK;
+				stream->len += D2TK_HASH_BLOCK;
+			}
+		}
+
+		size_t n = D2TK_HASH_BLOCK - stream->fill;
+		if(n > len)
+		{
+			n = len;
+		}
+
+		memcpy(&stream->buf[stream->fill], src, n);
+		stream->fill += n;
+		stream->len += n;
+		src += n;
+		len -= n;
+	}
+}
+
+D2TK_API uint64_t
+d2tk_hash_stream_final(const d2tk_hash_stream_t *stream)
+{
+	if(stream->len > D2TK_HASH_BLOCK)
+	{
+		return _d2tk_hash_wide_final(stream->acc, stream->buf, stream->fill,
+			stream->len);
+	}
+
+	return mum_hash(stream->buf, stream->len, SEED);
+}
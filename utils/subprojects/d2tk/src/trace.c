@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+#include <time.h>
+#include <inttypes.h>
+
+#include <d2tk/trace.h>
+
+#define _D2TK_TRACE_MASK (D2TK_TRACE_MAX - 1)
+
+typedef struct _d2tk_trace_t d2tk_trace_t;
+
+struct _d2tk_trace_t {
+	bool enabled;
+	uint64_t epoch;
+	size_t head; // total number of recorded events
+	d2tk_trace_event_t events [D2TK_TRACE_MAX];
+};
+
+static d2tk_trace_t trace;
+
+static inline d2tk_trace_event_t *
+_d2tk_trace_push()
+{
+	d2tk_trace_event_t *evt = &trace.events[trace.head & _D2TK_TRACE_MASK];
+
+	trace.head++;
+
+	return evt;
+}
+
+D2TK_API void
+d2tk_trace_enable(bool enabled)
+{
+	if(enabled && !trace.enabled)
+	{
+		trace.epoch = d2tk_trace_now();
+	}
+
+	trace.enabled = enabled;
+}
+
+D2TK_API bool
+d2tk_trace_is_enabled()
+{
+	return trace.enabled;
+}
+
+D2TK_API void
+d2tk_trace_clear()
+{
+	trace.head = 0;
+	trace.epoch = d2tk_trace_now();
+}
+
+D2TK_API uint64_t
+d2tk_trace_now()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec*UINT64_C(1000000000) + ts.tv_nsec;
+}
+
+D2TK_API uint64_t
+d2tk_trace_begin()
+{
+	if(!trace.enabled)
+	{
+		return 0;
+	}
+
+	return d2tk_trace_now();
+}
+
+D2TK_API void
+d2tk_trace_end(const char *cat, const char *name, uint64_t begin)
+{
+	if(!trace.enabled || !begin)
+	{
+		return;
+	}
+
+	d2tk_trace_event_t *evt = _d2tk_trace_push();
+
+	evt->name = name;
+	evt->cat = cat;
+	evt->ts = begin;
+	evt->dur = d2tk_trace_now() - begin;
+	evt->instant = false;
+}
+
+D2TK_API void
+d2tk_trace_instant(const char *cat, const char *name)
+{
+	if(!trace.enabled)
+	{
+		return;
+	}
+
+	d2tk_trace_event_t *evt = _d2tk_trace_push();
+
+	evt->name = name;
+	evt->cat = cat;
+	evt->ts = d2tk_trace_now();
+	evt->dur = 0;
+	evt->instant = true;
+}
+
+D2TK_API size_t
+d2tk_trace_get_events(const d2tk_trace_event_t **events, size_t *offset)
+{
+	const size_t num = trace.head > D2TK_TRACE_MAX
+		? D2TK_TRACE_MAX
+		: trace.head;
+
+	if(events)
+	{
+		*events = trace.events;
+	}
+
+	if(offset)
+	{
+		*offset = (trace.head - num) & _D2TK_TRACE_MASK;
+	}
+
+	return num;
+}
+
+D2TK_API int
+d2tk_trace_dump(FILE *fout)
+{
+	const d2tk_trace_event_t *events;
+	size_t offset;
+	const size_t num = d2tk_trace_get_events(&events, &offset);
+
+	fprintf(fout, "{\"traceEvents\":[\n");
+
+	for(size_t i = 0; i < num; i++)
+	{
+		const d2tk_trace_event_t *evt = &events[(offset + i) & _D2TK_TRACE_MASK];
+		const uint64_t ts = evt->ts - trace.epoch;
+
+		// chrome trace timestamps are in microseconds
+		if(evt->instant)
+		{
+			fprintf(fout, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\","
+				"\"s\":\"g\",\"ts\":%"PRIu64".%03"PRIu64",\"pid\":1,\"tid\":1}",
+				i ? ",\n" : "", evt->name, evt->cat,
+				ts / 1000, ts % 1000);
+		}
+		else
+		{
+			fprintf(fout, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+				"\"ts\":%"PRIu64".%03"PRIu64",\"dur\":%"PRIu64".%03"PRIu64","
+				"\"pid\":1,\"tid\":1}",
+				i ? ",\n" : "", evt->name, evt->cat,
+				ts / 1000, ts % 1000, evt->dur / 1000, evt->dur % 1000);
+		}
+	}
+
+	fprintf(fout, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+	return ferror(fout) ? -1 : 0;
+}
@@ -1254,6 +1254,50 @@ _test_pane_y()
 	d2tk_base_free(base);
 }
 
+#define ATOMS_NUM 0x2000 // more than fit into the former fixed table
+#define ATOMS_FRAMES 0x800 // longer than atoms live unused
+
+static void
+_test_atoms()
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = NULL
+	};
+
+	d2tk_base_t *base = d2tk_base_new(&d2tk_mock_driver_lazy, &ctx);
+	const d2tk_rect_t rect = D2TK_RECT(0, 0, DIM_W, DIM_H);
+	assert(base);
+
+	d2tk_base_set_dimensions(base, DIM_W, DIM_H);
+
+#define fmin 0.25f
+#define fmax 0.75f
+#define fstep 0.25f
+	// browse through ever new widgets, atoms of old ones get dropped
+	for(unsigned f = 0; f < ATOMS_FRAMES; f++)
+	{
+		d2tk_base_pre(base);
+
+		for(unsigned i = 0; i < (f == 0 ? ATOMS_NUM : 4); i++)
+		{
+			D2TK_BASE_PANE(base, &rect, D2TK_ID_IDX(f*ATOMS_NUM + i),
+				D2TK_FLAG_PANE_X, fmin, fmax, fstep, pane)
+			{
+				const float fraction = d2tk_pane_get_fraction(pane);
+
+				assert(fraction == fmin);
+			}
+		}
+
+		d2tk_base_post(base);
+	}
+#undef fmin
+#undef fmax
+#undef fstep
+
+	d2tk_base_free(base);
+}
+
 static void
 _test_cursor()
 {
@@ -1448,7 +1492,8 @@ _test_custom()
 	const d2tk_rect_t rect = D2TK_RECT(0, 0, DIM_W, DIM_H);
 	assert(base);
 
-	d2tk_base_custom(base, sizeof(custom_data), &custom_data, &rect, _custom);
+	d2tk_base_custom(base, sizeof(custom_data), &custom_data, 0, &rect, _custom);
+	d2tk_base_custom(base, sizeof(custom_data), &custom_data, 1, &rect, _custom);
 
 	d2tk_base_free(base);
 }
@@ -1852,6 +1897,7 @@ main(int argc __attribute__((unused)), char **argv __attribute__((unused)))
 	_test_scrollbar_y();
 	_test_pane_x();
 	_test_pane_y();
+	_test_atoms();
 	_test_cursor();
 	_test_button_label_image();
 	_test_button_label();
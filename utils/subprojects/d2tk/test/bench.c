@@ -0,0 +1,631 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+// renders synthetic widget trees for a number of frames with a controlled
+// rate of mutation and reports the time spent per frame in base (building the
+// widget tree), core (diffing and bookkeeping) and the backend (both passes)
+//
+// the backend is chosen at compile time:
+//   D2TK_BENCH_CAIRO  cairo image surface via the offscreen frontend
+//   D2TK_BENCH_MONO   1-bpp surface of the mono backend
+//   otherwise         null mock driver, which walks but does not draw
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <d2tk/base.h>
+#include <d2tk/trace.h>
+
+#if defined(D2TK_BENCH_CAIRO)
+#	include <d2tk/frontend_offscreen.h>
+#	define BACKEND "cairo"
+#elif defined(D2TK_BENCH_MONO)
+#	include <d2tk/backend.h>
+#	include <d2tk/backend_mono.h>
+#	include "src/core_internal.h"
+#	define BACKEND "mono"
+#else
+#	include "mock.h"
+#	define BACKEND "mock"
+#endif
+
+#define NCOLS 8 // of text table
+#define NBITMAPS 4
+
+typedef struct _bench_t bench_t;
+typedef struct _scenario_t scenario_t;
+typedef struct _result_t result_t;
+
+typedef void (*bench_run_t)(bench_t *bench, d2tk_base_t *base,
+	const d2tk_rect_t *rect);
+
+struct _bench_t {
+	unsigned n; // number of widgets, side length of bitmaps
+	unsigned rate; // of mutation in percent
+	uint32_t rng;
+	unsigned nvals;
+	uint32_t *vals; // per-widget state that mutates
+	uint32_t *argb;
+	uint64_t revs [NBITMAPS];
+	d2tk_coord_t sink; // keeps geometry from being optimized away
+	const char *bundle_path;
+	d2tk_coord_t w;
+	d2tk_coord_t h;
+#if defined(D2TK_BENCH_CAIRO)
+	d2tk_offscreen_config_t config;
+	d2tk_offscreen_t *offscreen;
+#elif defined(D2TK_BENCH_MONO)
+	d2tk_mono_surf_t surf;
+	void *ctx;
+#else
+	d2tk_mock_ctx_t ctx;
+#endif
+	d2tk_base_t *base;
+};
+
+struct _scenario_t {
+	const char *name;
+	bench_run_t run;
+};
+
+struct _result_t {
+	uint64_t frames;
+	uint64_t total_ns;
+	uint64_t base_ns;
+	uint64_t diff_ns;
+	uint64_t backend_ns;
+	d2tk_stats_t stats;
+};
+
+// xorshift32, deterministic across runs
+static uint32_t
+_bench_rand(bench_t *bench)
+{
+	uint32_t x = bench->rng;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	return bench->rng = x;
+}
+
+static bool
+_bench_mutate(bench_t *bench)
+{
+	return (_bench_rand(bench) % 100) < bench->rate;
+}
+
+static unsigned
+_bench_sqrt(unsigned n)
+{
+	unsigned r = 1;
+
+	while(r*r < n)
+	{
+		r++;
+	}
+
+	return r;
+}
+
+static void
+_bench_run_buttons(bench_t *bench, d2tk_base_t *base, const d2tk_rect_t *rect)
+{
+	const unsigned N = _bench_sqrt(bench->n);
+	const unsigned M = (bench->n + N - 1) / N;
+
+	D2TK_BASE_TABLE(rect, N, M, tab)
+	{
+		const unsigned k = d2tk_table_get_index(tab);
+		const d2tk_rect_t *bnd = d2tk_table_get_rect(tab);
+
+		if(k >= bench->n)
+		{
+			break;
+		}
+
+		if(_bench_mutate(bench))
+		{
+			bench->vals[k]++;
+		}
+
+		char lbl [16];
+		const ssize_t lbl_len = snprintf(lbl, sizeof(lbl), "%"PRIu32,
+			bench->vals[k]);
+
+		d2tk_base_button_label(base, D2TK_ID_IDX(k), lbl_len, lbl,
+			D2TK_ALIGN_CENTERED, bnd);
+	}
+}
+
+static void
+_bench_run_nested_rec(bench_t *bench, d2tk_base_t *base,
+	const d2tk_rect_t *rect, unsigned depth, unsigned *leaf)
+{
+	static const d2tk_coord_t frac [2] = { 1, 1 };
+
+	if(depth == 0)
+	{
+		const unsigned k = (*leaf)++;
+
+		if(_bench_mutate(bench))
+		{
+			bench->vals[k]++;
+		}
+
+		char lbl [16];
+		const ssize_t lbl_len = snprintf(lbl, sizeof(lbl), "%"PRIu32,
+			bench->vals[k]);
+
+		d2tk_base_label(base, lbl_len, lbl, 0.5f, rect, D2TK_ALIGN_CENTERED);
+		return;
+	}
+
+	D2TK_BASE_LAYOUT(rect, 2, frac,
+		(depth & 1) ? D2TK_FLAG_LAYOUT_X_REL : D2TK_FLAG_LAYOUT_Y_REL, lay)
+	{
+		const d2tk_rect_t *lrect = d2tk_layout_get_rect(lay);
+
+		_bench_run_nested_rec(bench, base, lrect, depth - 1, leaf);
+	}
+}
+
+static void
+_bench_run_nested(bench_t *bench, d2tk_base_t *base, const d2tk_rect_t *rect)
+{
+	unsigned depth = 0;
+	unsigned leaf = 0;
+
+	while( (1U << depth) < bench->n)
+	{
+		depth++;
+	}
+
+	_bench_run_nested_rec(bench, base, rect, depth, &leaf);
+}
+
+static void
+_bench_run_list(bench_t *bench, d2tk_base_t *base, const d2tk_rect_t *rect)
+{
+	const unsigned vnum = rect->h / 24;
+
+	// scroll by one line in a random direction
+	d2tk_base_set_mouse_pos(base, rect->x + rect->w/2, rect->y + rect->h/2);
+	if(_bench_mutate(bench))
+	{
+		d2tk_base_add_mouse_scroll(base, 0, (_bench_rand(bench) & 1) ? 1 : -1);
+	}
+
+	D2TK_BASE_SCROLLBAR(base, rect, D2TK_ID, D2TK_FLAG_SCROLL_Y, 0, bench->n,
+		0, vnum, vscroll)
+	{
+		const float voffset = d2tk_scrollbar_get_offset_y(vscroll);
+		const d2tk_rect_t *sub = d2tk_scrollbar_get_rect(vscroll);
+
+		D2TK_BASE_TABLE(sub, 1, vnum, tab)
+		{
+			const unsigned k = d2tk_table_get_index_y(tab) + voffset;
+			const d2tk_rect_t *bnd = d2tk_table_get_rect(tab);
+
+			if(k >= bench->n)
+			{
+				break;
+			}
+
+			char lbl [32];
+			const ssize_t lbl_len = snprintf(lbl, sizeof(lbl), "item %u: %"PRIu32,
+				k, bench->vals[k]);
+
+			d2tk_base_button_label(base, D2TK_ID_IDX(k), lbl_len, lbl,
+				D2TK_ALIGN_LEFT | D2TK_ALIGN_MIDDLE, bnd);
+		}
+	}
+}
+
+static void
+_bench_run_bitmap(bench_t *bench, d2tk_base_t *base, const d2tk_rect_t *rect)
+{
+	const uint32_t side = bench->n;
+
+	D2TK_BASE_TABLE(rect, 2, NBITMAPS/2, tab)
+	{
+		const unsigned k = d2tk_table_get_index(tab);
+		const d2tk_rect_t *bnd = d2tk_table_get_rect(tab);
+		uint32_t *argb = &bench->argb[k*side*side];
+
+		// repaint a random row
+		if(_bench_mutate(bench))
+		{
+			const uint32_t y = _bench_rand(bench) % side;
+			const uint32_t col = _bench_rand(bench) | 0xff000000;
+
+			for(uint32_t x = 0; x < side; x++)
+			{
+				argb[y*side + x] = col;
+			}
+
+			bench->revs[k]++;
+		}
+
+		d2tk_base_bitmap(base, side, side, side*sizeof(uint32_t), argb,
+			bench->revs[k], bnd, D2TK_ALIGN_CENTERED);
+	}
+}
+
+static void
+_bench_run_table(bench_t *bench, d2tk_base_t *base, const d2tk_rect_t *rect)
+{
+	const unsigned M = (bench->n + NCOLS - 1) / NCOLS;
+
+	D2TK_BASE_TABLE(rect, NCOLS, M, tab)
+	{
+		const unsigned k = d2tk_table_get_index(tab);
+		const d2tk_rect_t *bnd = d2tk_table_get_rect(tab);
+
+		if(k >= bench->n)
+		{
+			break;
+		}
+
+		if(_bench_mutate(bench))
+		{
+			bench->vals[k] = _bench_rand(bench);
+		}
+
+		char lbl [32];
+		const ssize_t lbl_len = snprintf(lbl, sizeof(lbl), "%04u: %08"PRIx32,
+			k, bench->vals[k]);
+
+		d2tk_base_label(base, lbl_len, lbl, 0.8f, bnd,
+			D2TK_ALIGN_LEFT | D2TK_ALIGN_MIDDLE);
+	}
+}
+
+// geometry only, nested layouts with a table at each leaf and no widgets
+static void
+_bench_run_layout_rec(bench_t *bench, const d2tk_rect_t *rect, unsigned depth)
+{
+	static const d2tk_coord_t frac [3] = { 1, 2, 0 };
+
+	if(depth == 0)
+	{
+		D2TK_BASE_TABLE(rect, 3, 2, tab)
+		{
+			bench->sink += d2tk_table_get_rect(tab)->w;
+		}
+
+		return;
+	}
+
+	D2TK_BASE_LAYOUT(rect, 3, frac,
+		(depth & 1) ? D2TK_FLAG_LAYOUT_X_REL : D2TK_FLAG_LAYOUT_Y_REL, lay)
+	{
+		const d2tk_rect_t *lrect = d2tk_layout_get_rect(lay);
+
+		_bench_run_layout_rec(bench, lrect, depth - 1);
+	}
+}
+
+static void
+_bench_run_layout(bench_t *bench, d2tk_base_t *base __attribute__((unused)),
+	const d2tk_rect_t *rect)
+{
+	unsigned depth = 0;
+
+	for(unsigned n = 1; n < bench->n; n *= 3)
+	{
+		depth++;
+	}
+
+	_bench_run_layout_rec(bench, rect, depth);
+}
+
+static const scenario_t scenarios [] = {
+	{ .name = "buttons", .run = _bench_run_buttons },
+	{ .name = "nested", .run = _bench_run_nested },
+	{ .name = "list", .run = _bench_run_list },
+	{ .name = "bitmap", .run = _bench_run_bitmap },
+	{ .name = "table", .run = _bench_run_table },
+	{ .name = "layout", .run = _bench_run_layout },
+	{ .name = NULL, .run = NULL } // sentinel
+};
+
+static void
+_bench_deinit(bench_t *bench)
+{
+#if defined(D2TK_BENCH_CAIRO)
+	if(bench->offscreen)
+	{
+		d2tk_offscreen_free(bench->offscreen);
+	}
+#elif defined(D2TK_BENCH_MONO)
+	if(bench->base)
+	{
+		d2tk_base_free(bench->base);
+	}
+
+	if(bench->ctx)
+	{
+		d2tk_core_driver.free(bench->ctx);
+	}
+
+	free(bench->surf.buf);
+#else
+	if(bench->base)
+	{
+		d2tk_base_free(bench->base);
+	}
+#endif
+
+	bench->base = NULL;
+}
+
+static int
+_bench_init(bench_t *bench)
+{
+#if defined(D2TK_BENCH_CAIRO)
+	bench->config.bundle_path = bench->bundle_path;
+	bench->config.w = bench->w;
+	bench->config.h = bench->h;
+
+	bench->offscreen = d2tk_offscreen_new(&bench->config);
+	if(!bench->offscreen)
+	{
+		return -1;
+	}
+
+	bench->base = d2tk_offscreen_get_base(bench->offscreen);
+#elif defined(D2TK_BENCH_MONO)
+	bench->surf.w = bench->w;
+	bench->surf.h = bench->h;
+	bench->surf.bpp = 1;
+	bench->surf.stride = ( (bench->w + 31) / 32) * sizeof(uint32_t);
+	bench->surf.buf = calloc(bench->surf.h, bench->surf.stride);
+	if(!bench->surf.buf)
+	{
+		return -1;
+	}
+
+	bench->ctx = d2tk_core_driver.new(bench->bundle_path, &bench->surf);
+	if(!bench->ctx)
+	{
+		_bench_deinit(bench);
+		return -1;
+	}
+
+	bench->base = d2tk_base_new(&d2tk_core_driver, bench->ctx);
+#else
+	bench->base = d2tk_base_new(&d2tk_mock_driver_null, &bench->ctx);
+#endif
+
+	if(!bench->base)
+	{
+		_bench_deinit(bench);
+		return -1;
+	}
+
+	d2tk_base_set_dimensions(bench->base, bench->w, bench->h);
+
+	return 0;
+}
+
+static int
+_bench_scenario(bench_t *bench, const scenario_t *scenario, unsigned frames,
+	result_t *res)
+{
+	if(_bench_init(bench) != 0)
+	{
+		return -1;
+	}
+
+	d2tk_base_t *base = bench->base;
+	const d2tk_rect_t rect = D2TK_RECT(0, 0, bench->w, bench->h);
+	d2tk_stats_t stats;
+	d2tk_stats_t start;
+
+	memset(res, 0x0, sizeof(result_t));
+	bench->rng = 0x2545f491;
+	memset(bench->vals, 0x0, bench->nvals * sizeof(uint32_t));
+
+	// 1st frame renders everything from scratch and is not accounted for
+	for(unsigned frame = 0; frame <= frames; frame++)
+	{
+		const uint64_t t0 = d2tk_trace_now();
+		uint64_t dt_base = 0;
+
+		do
+		{
+			const uint64_t t1 = d2tk_trace_now();
+
+			d2tk_base_pre(base);
+			scenario->run(bench, base, &rect);
+
+			dt_base += d2tk_trace_now() - t1;
+
+			d2tk_base_post(base);
+		} while(d2tk_base_get_again(base));
+
+		const uint64_t dt = d2tk_trace_now() - t0;
+
+		if(frame == 0)
+		{
+			d2tk_base_get_stats(base, NULL, &start);
+			continue;
+		}
+
+		res->frames++;
+		res->total_ns += dt;
+		res->base_ns += dt_base;
+	}
+
+	d2tk_base_get_stats(base, NULL, &stats);
+
+	res->diff_ns = stats.diff_ns - start.diff_ns;
+	res->backend_ns = (stats.pass_ns[0] - start.pass_ns[0])
+		+ (stats.pass_ns[1] - start.pass_ns[1]);
+	res->stats.bytes = stats.bytes - start.bytes;
+	res->stats.bboxes = stats.bboxes - start.bboxes;
+	res->stats.area = stats.area - start.area;
+
+	_bench_deinit(bench);
+
+	return 0;
+}
+
+static void
+_bench_report(const char *name, const result_t *res)
+{
+	const double n = res->frames ? res->frames : 1;
+	const uint64_t core_ns = res->total_ns - res->base_ns - res->backend_ns;
+
+	// core includes the diff
+	fprintf(stdout, "%-6s %-8s %7"PRIu64" %10.0f %10.0f %10.0f %10.0f %10.0f"
+		" %10.0f %8.0f %10.0f\n",
+		BACKEND, name, res->frames,
+		res->total_ns / n, res->base_ns / n, core_ns / n, res->diff_ns / n,
+		res->backend_ns / n,
+		res->stats.bytes / n, res->stats.bboxes / n, res->stats.area / n);
+}
+
+int
+main(int argc, char **argv)
+{
+	bench_t bench = {
+		.n = 256,
+		.rate = 10,
+		.bundle_path = "./",
+		.w = 800,
+		.h = 600
+	};
+	unsigned frames = 256;
+	const char *only = NULL;
+
+	int c;
+	while( (c = getopt(argc, argv, "b:g:n:k:m:s:")) != -1)
+	{
+		switch(c)
+		{
+			case 'b':
+			{
+				bench.bundle_path = optarg;
+			} break;
+			case 'g':
+			{
+				if(sscanf(optarg, "%"SCNi32"x%"SCNi32, &bench.w, &bench.h) != 2)
+				{
+					bench.w = 800;
+					bench.h = 600;
+				}
+			} break;
+			case 'n':
+			{
+				bench.n = atoi(optarg);
+			} break;
+			case 'k':
+			{
+				frames = atoi(optarg);
+			} break;
+			case 'm':
+			{
+				bench.rate = atoi(optarg);
+			} break;
+			case 's':
+			{
+				only = optarg;
+			} break;
+
+			default:
+			{
+				fprintf(stderr, "Usage: %s [options]\n"
+					"  -b  bundle_path  of fonts and images (./)\n"
+					"  -g  WxH          geometry of surface (800x600)\n"
+					"  -n  num          widgets per tree, pixels per bitmap side (256)\n"
+					"  -k  frames       number of frames to render (256)\n"
+					"  -m  rate         of mutation per widget and frame in %% (10)\n"
+					"  -s  scenario     buttons|nested|list|bitmap|table|layout (all)\n\n",
+					argv[0]);
+			} return EXIT_FAILURE;
+		}
+	}
+
+	if( (bench.n < 1) || (bench.n > 4096) || (bench.w < 1) || (bench.h < 1) )
+	{
+		fprintf(stderr, "%s: invalid number of widgets or geometry\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	// nested trees round up to the next power of two
+	bench.nvals = 2*bench.n;
+	bench.vals = calloc(bench.nvals, sizeof(uint32_t));
+	bench.argb = calloc(NBITMAPS*bench.n*bench.n, sizeof(uint32_t));
+	if(!bench.vals || !bench.argb)
+	{
+		free(bench.vals);
+		free(bench.argb);
+		return EXIT_FAILURE;
+	}
+
+	for(unsigned i = 0; i < NBITMAPS*bench.n*bench.n; i++)
+	{
+		bench.argb[i] = 0xff000000 | (i * 0x010203);
+	}
+
+	int ret = EXIT_SUCCESS;
+	unsigned num = 0;
+
+	// all timings in ns per frame
+	fprintf(stdout, "%-6s %-8s %7s %10s %10s %10s %10s %10s %10s %8s %10s\n",
+		"driver", "scenario", "frames", "total", "base", "core", "diff",
+		"backend", "bytes", "bboxes", "area");
+
+	for(const scenario_t *scenario = scenarios; scenario->name; scenario++)
+	{
+		if(only && strcmp(only, scenario->name))
+		{
+			continue;
+		}
+
+		result_t res;
+
+		if(_bench_scenario(&bench, scenario, frames, &res) != 0)
+		{
+			fprintf(stderr, "%s: cannot initialize '%s' backend\n", argv[0],
+				BACKEND);
+			ret = EXIT_FAILURE;
+			break;
+		}
+
+		_bench_report(scenario->name, &res);
+		num++;
+	}
+
+	if( (ret == EXIT_SUCCESS) && !num)
+	{
+		fprintf(stderr, "%s: unknown scenario '%s'\n", argv[0], only);
+		ret = EXIT_FAILURE;
+	}
+
+	free(bench.vals);
+	free(bench.argb);
+
+	return ret;
+}
@@ -22,6 +22,7 @@
 
 #include <d2tk/core.h>
 #include <d2tk/hash.h>
+#include <d2tk/trace.h>
 #include "mock.h"
 
 static void
@@ -51,6 +52,134 @@ _test_hash_foreach()
 	assert(hash1 == hash2);
 }
 
+static void
+_test_hasher()
+{
+	const char *foo = "barbarbarbar";
+	const uint32_t bar = 0x12345678;
+	const uint64_t baz = 0x123456789abcdef0;
+
+	const uint64_t hash1 = d2tk_hash_foreach(foo, -1,
+		&bar, sizeof(uint32_t),
+		&baz, sizeof(uint64_t),
+		NULL);
+
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update_str(&hasher, foo);
+	d2tk_hasher_update_u32(&hasher, bar);
+	d2tk_hasher_update_u64(&hasher, baz);
+	const uint64_t hash2 = d2tk_hasher_final(&hasher);
+
+	assert(hash1 == hash2);
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, foo, strlen(foo));
+	d2tk_hasher_update(&hasher, &bar, sizeof(uint32_t));
+	d2tk_hasher_update(&hasher, &baz, sizeof(uint64_t));
+	const uint64_t hash3 = d2tk_hasher_final(&hasher);
+
+	assert(hash1 == hash3);
+}
+
+#define HASH_STREAM_LEN (3*D2TK_HASH_BLOCK + 77)
+
+static void
+_test_hash_stream()
+{
+	static const size_t lens [] = {
+		0, 1, 63, 64, D2TK_HASH_BLOCK - 1, D2TK_HASH_BLOCK, D2TK_HASH_BLOCK + 1,
+		2*D2TK_HASH_BLOCK, HASH_STREAM_LEN
+	};
+	static const size_t chunks [] = {
+		1, 7, 64, D2TK_HASH_BLOCK, D2TK_HASH_BLOCK + 3, HASH_STREAM_LEN
+	};
+	uint8_t buf [HASH_STREAM_LEN];
+
+	for(size_t i = 0; i < sizeof(buf); i++)
+	{
+		buf[i] = i*13 + (i >> 8);
+	}
+
+	for(unsigned l = 0; l < sizeof(lens)/sizeof(lens[0]); l++)
+	{
+		const size_t len = lens[l];
+		const uint64_t hash1 = d2tk_hash(buf, len);
+
+		// chunking must not matter
+		for(unsigned c = 0; c < sizeof(chunks)/sizeof(chunks[0]); c++)
+		{
+			d2tk_hash_stream_t stream;
+
+			d2tk_hash_stream_init(&stream);
+			for(size_t off = 0; off < len; off += chunks[c])
+			{
+				const size_t n = (len - off < chunks[c]) ? len - off : chunks[c];
+
+				d2tk_hash_stream_update(&stream, &buf[off], n);
+			}
+
+			assert(hash1 == d2tk_hash_stream_final(&stream));
+		}
+
+		if(len == 0)
+		{
+			continue;
+		}
+
+		// every byte matters, also on the wide path
+		buf[len - 1] ^= 0x1;
+		assert(hash1 != d2tk_hash(buf, len));
+		buf[len - 1] ^= 0x1;
+
+		buf[0] ^= 0x80;
+		assert(hash1 != d2tk_hash(buf, len));
+		buf[0] ^= 0x80;
+	}
+
+	// large keys take the wide path for hasher and foreach alike
+	d2tk_hasher_t hasher;
+
+	d2tk_hasher_init(&hasher);
+	d2tk_hasher_update(&hasher, buf, sizeof(buf));
+	d2tk_hasher_update(&hasher, buf, 3);
+
+	assert(d2tk_hasher_final(&hasher) == d2tk_hash_foreach(buf, sizeof(buf),
+		buf, 3, NULL));
+}
+
+#undef HASH_STREAM_LEN
+
+static void
+_check_lit(ssize_t len, const char *str)
+{
+	assert(len == (ssize_t)strlen(str));
+}
+
+#define HASH_LIT_LONG \
+	"0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+
+static void
+_test_hash_lit()
+{
+	// must be a constant expression
+	static const uint64_t hash1 = D2TK_HASH_LIT("barbarbarbar");
+	const char foo [] = "barbarbarbar";
+
+	assert(hash1 == D2TK_HASH_LIT(foo));
+	assert(hash1 != D2TK_HASH_LIT("barbarbarbaz"));
+	assert(hash1 != D2TK_HASH_LIT("barbarbarba"));
+	assert(D2TK_HASH_LIT("") != D2TK_HASH_LIT("a"));
+
+	// only the last 64 characters and the length matter
+	assert(D2TK_HASH_LIT(HASH_LIT_LONG) != D2TK_HASH_LIT("x"HASH_LIT_LONG));
+	assert(D2TK_HASH_LIT("x"HASH_LIT_LONG) == D2TK_HASH_LIT("y"HASH_LIT_LONG));
+	assert(D2TK_HASH_LIT(HASH_LIT_LONG"x") != D2TK_HASH_LIT(HASH_LIT_LONG"y"));
+
+	_check_lit(D2TK_LIT("barbarbarbar"));
+}
+
 static void
 _test_rect_shrink()
 {
@@ -1265,6 +1394,7 @@ _check_custom(const d2tk_com_t *com, const d2tk_clip_t *clip)
 	assert(com->body->custom.h == CUSTOM_H);
 	assert(com->body->custom.size == CUSTOM_SIZE);
 	assert(com->body->custom.data == CUSTOM_DATA);
+	assert(com->body->custom.hash == d2tk_hash(CUSTOM_DATA, CUSTOM_SIZE));
 	assert(com->body->custom.custom == _custom);
 }
 
@@ -1286,7 +1416,7 @@ _test_custom()
 	assert(ref >= 0);
 
 	d2tk_core_custom(core, &D2TK_RECT(CUSTOM_X, CUSTOM_Y, CUSTOM_W, CUSTOM_H),
-		CUSTOM_SIZE, CUSTOM_DATA, _custom);
+		CUSTOM_SIZE, CUSTOM_DATA, 0, _custom);
 
 	d2tk_core_bbox_pop(core, ref);
 	d2tk_core_post(core);
@@ -1300,6 +1430,63 @@ _test_custom()
 #undef CUSTOM_SIZE
 #undef CUSTOM_DATA
 
+static uint64_t custom_hash;
+
+static void
+_check_custom_hash(const d2tk_com_t *com,
+	const d2tk_clip_t *clip __attribute__((unused)))
+{
+	assert(com->instr == D2TK_INSTR_CUSTOM);
+
+	custom_hash = com->body->custom.hash;
+}
+
+static uint64_t
+_custom_hash(uint32_t size, const void *data, uint64_t rev)
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = _check_custom_hash
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	d2tk_core_pre(core);
+	const ssize_t ref = d2tk_core_bbox_push(core, true,
+		&D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H));
+	assert(ref >= 0);
+
+	d2tk_core_custom(core, &D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H),
+		size, data, rev, _custom);
+
+	d2tk_core_bbox_pop(core, ref);
+	d2tk_core_post(core);
+	d2tk_core_free(core);
+
+	return custom_hash;
+}
+
+static void
+_test_custom_rev()
+{
+	static uint8_t data [2*D2TK_HASH_BLOCK];
+
+	const uint64_t hash0 = _custom_hash(sizeof(data), data, 0);
+	const uint64_t hash1 = _custom_hash(sizeof(data), data, 1);
+
+	assert(hash0 == d2tk_hash(data, sizeof(data)));
+	assert(hash1 != hash0);
+
+	data[7] = 1;
+
+	// content is hashed without a revision, but not with one
+	assert(_custom_hash(sizeof(data), data, 0) != hash0);
+	assert(_custom_hash(sizeof(data), data, 1) == hash1);
+	assert(_custom_hash(sizeof(data), data, 2) != hash1);
+}
+
 #define STROKE_WIDTH 2
 
 static void
@@ -1411,11 +1598,931 @@ _test_triple()
 	d2tk_core_free(core);
 }
 
+static void
+_test_dirty_rect()
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = _check_triple
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver_triple, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	for(unsigned i = 0; i < 3; i++)
+	{
+		d2tk_core_pre(core);
+
+		const ssize_t ref = d2tk_core_bbox_push(core, true,
+			&D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H));
+		assert(ref >= 0);
+
+		d2tk_core_rect(core, &D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, i < 2 ? CLIP_H : CLIP_H/2));
+
+		d2tk_core_bbox_pop(core, ref);
+		d2tk_core_post(core);
+
+		d2tk_rect_t rect;
+		const bool dirty = d2tk_core_get_dirty_rect(core, &rect);
+
+		switch(i)
+		{
+			case 0: // full refresh
+			{
+				assert(dirty);
+				assert(rect.x == 0);
+				assert(rect.y == 0);
+				assert(rect.w == DIM_W);
+				assert(rect.h == DIM_H);
+			} break;
+			case 1: // unchanged
+			{
+				assert(!dirty);
+			} break;
+			case 2: // changed
+			{
+				assert(dirty);
+				assert(rect.x == CLIP_X);
+				assert(rect.y == CLIP_Y);
+				assert(rect.w == CLIP_W);
+				assert(rect.h == CLIP_H);
+
+				unsigned nrects;
+				const d2tk_rect_t *rects = d2tk_core_get_dirty_rects(core, &nrects);
+				assert(nrects == 1);
+				assert(rects[0].x == CLIP_X);
+				assert(rects[0].y == CLIP_Y);
+				assert(rects[0].w == CLIP_W);
+				assert(rects[0].h == CLIP_H);
+			} break;
+		}
+	}
+
+	d2tk_core_free(core);
+}
+
+#define DIFF_COLS 64
+#define DIFF_ROWS 32
+#define DIFF_NUM (DIFF_COLS*DIFF_ROWS)
+#define DIFF_W (DIM_W / DIFF_COLS)
+#define DIFF_H (DIM_H / DIFF_ROWS)
+
+static void
+_test_diff()
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = NULL
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver_lazy, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	for(unsigned f = 0; f < 5; f++)
+	{
+		d2tk_core_pre(core);
+
+		for(unsigned i = 0; i < DIFF_NUM; i++)
+		{
+			const d2tk_coord_t x = (i % DIFF_COLS) * DIFF_W;
+			const d2tk_coord_t y = (i / DIFF_COLS) * DIFF_H;
+
+			if( (f == 2) && (i == DIFF_COLS + 1) ) // disappears
+			{
+				continue;
+			}
+
+			const ssize_t ref = d2tk_core_bbox_push(core, true,
+				&D2TK_RECT(x, y, DIFF_W, DIFF_H));
+			assert(ref >= 0);
+
+			// scroll content by one item in last frame
+			const unsigned j = f == 4 ? i + 1 : i;
+			d2tk_core_rect(core, &D2TK_RECT(x, y, 1 + j % (DIFF_W - 1), DIFF_H));
+
+			d2tk_core_bbox_pop(core, ref);
+		}
+
+		d2tk_core_post(core);
+
+		d2tk_rect_t rect;
+		const bool dirty = d2tk_core_get_dirty_rect(core, &rect);
+
+		switch(f)
+		{
+			case 1: // unchanged
+			{
+				assert(!dirty);
+			} break;
+			case 2: // disappeared
+			case 3: // appeared
+			{
+				assert(dirty);
+				assert(rect.x == DIFF_W);
+				assert(rect.y == DIFF_H);
+				assert(rect.w == DIFF_W);
+				assert(rect.h == DIFF_H);
+			} break;
+			case 0: // full refresh
+			case 4: // every item changed
+			{
+				assert(dirty);
+				assert(rect.w == DIM_W);
+				assert(rect.h == DIM_H);
+			} break;
+		}
+	}
+
+	d2tk_core_free(core);
+}
+
+#define SPRITES_NUM 1024
+#define SPRITES_SZ 1024
+
+static void
+_test_sprites()
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = NULL
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	// consume initial full refresh
+	d2tk_core_pre(core);
+	d2tk_core_post(core);
+
+	uintptr_t *sprites [SPRITES_NUM];
+
+	for(unsigned i = 0; i < SPRITES_NUM; i++)
+	{
+		uintptr_t *sprite = d2tk_core_get_sprite(core, i + 1, 1);
+		assert(sprite);
+		assert(*sprite == 0);
+
+		uint32_t *dummy = malloc(sizeof(uint32_t));
+		assert(dummy);
+		*dummy = 1234;
+
+		*sprite = (uintptr_t)dummy;
+		d2tk_core_set_sprite_size(core, sprite, SPRITES_SZ);
+		sprites[i] = sprite;
+	}
+
+	// sprites must stay put while the table grows
+	for(unsigned i = 0; i < SPRITES_NUM; i++)
+	{
+		assert(d2tk_core_get_sprite(core, i + 1, 1) == sprites[i]);
+	}
+
+	// sprites used in this frame must survive the budget
+	d2tk_core_set_budgets(core, SPRITES_NUM/2 * SPRITES_SZ, 0);
+	d2tk_core_pre(core);
+	d2tk_core_post(core);
+
+	for(unsigned i = SPRITES_NUM/2; i < SPRITES_NUM; i++)
+	{
+		assert(d2tk_core_get_sprite(core, i + 1, 1) == sprites[i]);
+	}
+
+	// least recently used sprites get evicted above budget
+	d2tk_core_pre(core);
+	d2tk_core_post(core);
+
+	{
+		uintptr_t *sprite = d2tk_core_get_sprite(core, 1, 1);
+		assert(sprite);
+		assert(*sprite == 0);
+
+		sprite = d2tk_core_get_sprite(core, SPRITES_NUM, 1);
+		assert(sprite);
+		assert(*sprite != 0);
+	}
+
+	// unused sprites expire after their time to live
+	d2tk_core_set_ttls(core, 2, 2);
+	assert(*d2tk_core_get_sprite(core, SPRITES_NUM - 1, 1) != 0);
+
+	d2tk_core_pre(core);
+	d2tk_core_post(core);
+
+	assert(*d2tk_core_get_sprite(core, SPRITES_NUM - 1, 1) != 0);
+
+	d2tk_core_pre(core);
+	d2tk_core_post(core);
+
+	assert(*d2tk_core_get_sprite(core, SPRITES_NUM, 1) == 0);
+	assert(*d2tk_core_get_sprite(core, SPRITES_NUM - 1, 1) != 0);
+
+	d2tk_core_free(core);
+}
+
+#define LAYOUTS_NUM 64
+
+static void
+_test_layouts()
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = NULL
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	// consume initial full refresh
+	d2tk_core_pre(core);
+	d2tk_core_post(core);
+
+	for(unsigned i = 0; i < LAYOUTS_NUM; i++)
+	{
+		uintptr_t *layout = d2tk_core_get_layout(core, i + 1, 1);
+		assert(layout);
+		assert(*layout == 0);
+
+		uint32_t *dummy = malloc(sizeof(uint32_t));
+		assert(dummy);
+		*dummy = 1234;
+
+		*layout = (uintptr_t)dummy;
+		d2tk_core_set_layout_size(core, layout, sizeof(uint32_t));
+
+		// layouts and sprites do not share their keys
+		assert(*d2tk_core_get_sprite(core, i + 1, 1) == 0);
+	}
+
+	d2tk_core_pre(core);
+	d2tk_core_post(core);
+
+	{
+		d2tk_stats_t frame;
+		d2tk_core_get_stats(core, &frame, NULL);
+
+		assert(frame.layout_hits == 0);
+		assert(frame.layout_misses == LAYOUTS_NUM);
+		assert(frame.layout_evictions == 0);
+	}
+
+	// layouts survive a full refresh, as they do not depend on the surface
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+	d2tk_core_pre(core);
+
+	for(unsigned i = 0; i < LAYOUTS_NUM; i++)
+	{
+		assert(*d2tk_core_get_layout(core, i + 1, 1) != 0);
+	}
+
+	d2tk_core_post(core);
+
+	{
+		d2tk_stats_t frame;
+		d2tk_core_get_stats(core, &frame, NULL);
+
+		assert(frame.layout_hits == LAYOUTS_NUM);
+		assert(frame.layout_misses == 0);
+	}
+
+	// unused layouts expire after their time to live
+	d2tk_core_set_ttls(core, 2, 2);
+
+	d2tk_core_pre(core);
+	d2tk_core_post(core);
+
+	{
+		d2tk_stats_t frame;
+		d2tk_core_get_stats(core, &frame, NULL);
+
+		assert(frame.layout_evictions == LAYOUTS_NUM);
+	}
+
+	d2tk_core_free(core);
+}
+
+#define TRACE_X 10
+#define TRACE_Y 20
+#define TRACE_W 30
+#define TRACE_H 40
+
+static void
+_check_trace(const d2tk_com_t *com, const d2tk_clip_t *clip)
+{
+	assert(clip->x0 == CLIP_X);
+	assert(clip->y0 == CLIP_Y);
+
+	assert(com->instr == D2TK_INSTR_RECT);
+	assert(com->body->rect.x == TRACE_X - CLIP_X);
+	assert(com->body->rect.y == TRACE_Y - CLIP_Y);
+}
+
+static void
+_test_trace()
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = _check_trace
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	d2tk_trace_enable(true);
+	d2tk_trace_clear();
+
+	d2tk_core_pre(core);
+	const ssize_t ref = d2tk_core_bbox_push(core, true,
+		&D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H));
+	assert(ref >= 0);
+	d2tk_core_rect(core, &D2TK_RECT(TRACE_X, TRACE_Y, TRACE_W, TRACE_H));
+	d2tk_core_bbox_pop(core, ref);
+	d2tk_core_post(core);
+
+	d2tk_trace_instant("test", "instant");
+
+	d2tk_trace_enable(false);
+	d2tk_trace_instant("test", "ignored");
+
+	const d2tk_trace_event_t *events;
+	size_t offset;
+	const size_t num = d2tk_trace_get_events(&events, &offset);
+	assert(num == 5); // driver post, pass 0, gc, d2tk_core_post, instant
+	assert(offset == 0);
+
+	bool has_post = false;
+	bool has_pass = false;
+	for(size_t i = 0; i < num; i++)
+	{
+		const d2tk_trace_event_t *evt = &events[i];
+
+		if(!strcmp(evt->name, "d2tk_core_post"))
+		{
+			has_post = true;
+			assert(!evt->instant);
+		}
+		else if(!strcmp(evt->name, "pass 0"))
+		{
+			has_pass = true;
+		}
+	}
+	assert(has_post);
+	assert(has_pass);
+	assert(!strcmp(events[num - 1].name, "instant"));
+	assert(events[num - 1].instant);
+
+	FILE *fout = tmpfile();
+	assert(fout);
+	assert(d2tk_trace_dump(fout) == 0);
+	assert(ftell(fout) > 0);
+	fclose(fout);
+
+	d2tk_core_free(core);
+}
+
+#undef TRACE_X
+#undef TRACE_Y
+#undef TRACE_W
+#undef TRACE_H
+
+#define RECORD_WIDTH 16
+#define RECORD_HEIGHT 8
+#define RECORD_STRIDE RECORD_WIDTH*sizeof(uint32_t)
+#define RECORD_SIZE 6
+
+static unsigned record_bitmaps = 0;
+static unsigned record_customs = 0;
+static const char *record_data = NULL;
+
+static void
+_custom_record(void *ctx __attribute__((unused)),
+	uint32_t size __attribute__((unused)),
+	const void *data __attribute__((unused)))
+{
+	assert(false); // must not be called back on replay
+}
+
+static void
+_check_record(const d2tk_com_t *com,
+	const d2tk_clip_t *clip __attribute__((unused)))
+{
+	switch(com->instr)
+	{
+		case D2TK_INSTR_BITMAP:
+		{
+			const d2tk_body_bitmap_surf_t *surf = &com->body->bitmap.surf;
+
+			assert(surf->w == RECORD_WIDTH);
+			assert(surf->h == RECORD_HEIGHT);
+			assert(surf->stride == RECORD_STRIDE);
+			for(unsigned i = 0; i < RECORD_WIDTH*RECORD_HEIGHT; i++)
+			{
+				assert(surf->argb[i] == 0xff000000 + i);
+			}
+
+			record_bitmaps++;
+		} break;
+		case D2TK_INSTR_CUSTOM:
+		{
+			const d2tk_body_custom_t *body = &com->body->custom;
+
+			assert(body->size == RECORD_SIZE);
+			assert(body->data != record_data);
+			assert(!memcmp(body->data, record_data, RECORD_SIZE));
+			assert(body->custom != _custom_record);
+
+			body->custom(NULL, body->size, body->data);
+
+			record_customs++;
+		} break;
+	}
+}
+
+static void
+_test_record()
+{
+	static const char *datas [2] = { "first", "other" };
+	d2tk_mock_ctx_t ctx = {
+		.check = NULL
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver_lazy, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	FILE *f = tmpfile();
+	assert(f);
+	d2tk_core_set_record(core, f);
+
+	uint32_t surf [RECORD_WIDTH*RECORD_HEIGHT];
+	for(unsigned i = 0; i < RECORD_WIDTH*RECORD_HEIGHT; i++)
+	{
+		surf[i] = 0xff000000 + i;
+	}
+
+	long pos [3] = { 0 };
+
+	for(unsigned fr = 0; fr < 2; fr++)
+	{
+		d2tk_core_pre(core);
+
+		const ssize_t ref = d2tk_core_bbox_push(core, true,
+			&D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H));
+		assert(ref >= 0);
+		d2tk_core_bitmap(core, &D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H),
+			RECORD_WIDTH, RECORD_HEIGHT, RECORD_STRIDE, surf, 0,
+			D2TK_ALIGN_LEFT);
+		d2tk_core_custom(core, &D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H),
+			RECORD_SIZE, datas[fr], 0, _custom_record);
+		d2tk_core_bbox_pop(core, ref);
+
+		d2tk_core_post(core);
+
+		pos[fr + 1] = ftell(f);
+		assert(pos[fr + 1] > pos[fr]);
+	}
+
+	// pixels are written only once
+	assert(pos[2] - pos[1] < pos[1] - pos[0]);
+	assert( (size_t)(pos[1] - pos[0] - (pos[2] - pos[1]))
+		== RECORD_STRIDE*RECORD_HEIGHT);
+
+	d2tk_core_set_record(core, NULL);
+	d2tk_core_free(core);
+
+	rewind(f);
+
+	ctx.check = _check_record;
+	core = d2tk_core_new(&d2tk_mock_driver_lazy, &ctx);
+	assert(core);
+
+	for(unsigned fr = 0; fr < 2; fr++)
+	{
+		record_data = datas[fr];
+		assert(d2tk_core_replay(core, f) == 0);
+		assert(record_bitmaps == fr + 1);
+		assert(record_customs == fr + 1);
+
+		d2tk_coord_t w;
+		d2tk_coord_t h;
+		d2tk_core_get_dimensions(core, &w, &h);
+		assert(w == DIM_W);
+		assert(h == DIM_H);
+	}
+
+	assert(d2tk_core_replay(core, f) == 1); // end of recording
+
+	d2tk_core_free(core);
+	fclose(f);
+}
+
+static void
+_test_record_expire()
+{
+	static const char *datas [2] = { "first", "other" };
+	const unsigned nframes = 0x100 + 2; // beyond ttl of recorded pixels
+	d2tk_mock_ctx_t ctx = {
+		.check = NULL
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver_lazy, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	FILE *f = tmpfile();
+	assert(f);
+	d2tk_core_set_record(core, f);
+
+	uint32_t surf [RECORD_WIDTH*RECORD_HEIGHT];
+	for(unsigned i = 0; i < RECORD_WIDTH*RECORD_HEIGHT; i++)
+	{
+		surf[i] = 0xff000000 + i;
+	}
+
+	long pos [3] = { 0 }; // end of previous frames
+
+	for(unsigned fr = 0; fr < nframes; fr++)
+	{
+		const bool first = (fr == 0);
+		const bool last = (fr == nframes - 1);
+
+		d2tk_core_pre(core);
+
+		const ssize_t ref = d2tk_core_bbox_push(core, true,
+			&D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H));
+		assert(ref >= 0);
+		if(first || last) // bitmap is unseen long enough to expire in between
+		{
+			d2tk_core_bitmap(core, &D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H),
+				RECORD_WIDTH, RECORD_HEIGHT, RECORD_STRIDE, surf, 0,
+				D2TK_ALIGN_LEFT);
+		}
+		d2tk_core_custom(core, &D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H),
+			RECORD_SIZE, datas[fr % 2], 0, _custom_record);
+		d2tk_core_bbox_pop(core, ref);
+
+		d2tk_core_post(core);
+
+		pos[0] = pos[1];
+		pos[1] = pos[2];
+		pos[2] = ftell(f);
+	}
+
+	// pixels are written again after they have expired
+	assert( (size_t)(pos[2] - pos[1] - (pos[1] - pos[0]))
+		>= RECORD_STRIDE*RECORD_HEIGHT);
+
+	d2tk_core_set_record(core, NULL);
+	d2tk_core_free(core);
+
+	rewind(f);
+
+	record_bitmaps = 0;
+	record_customs = 0;
+	ctx.check = _check_record;
+	core = d2tk_core_new(&d2tk_mock_driver_lazy, &ctx);
+	assert(core);
+
+	for(unsigned fr = 0; fr < nframes; fr++)
+	{
+		record_data = datas[fr % 2];
+		assert(d2tk_core_replay(core, f) == 0);
+	}
+	assert(record_bitmaps == 2);
+	assert(record_customs == nframes);
+
+	assert(d2tk_core_replay(core, f) == 1); // end of recording
+
+	d2tk_core_free(core);
+	fclose(f);
+}
+
+static void
+_check_corrupt(const d2tk_com_t *com,
+	const d2tk_clip_t *clip __attribute__((unused)))
+{
+	volatile uint8_t sum = 0;
+
+	switch(com->instr)
+	{
+		case D2TK_INSTR_BITMAP:
+		{
+			const d2tk_body_bitmap_surf_t *surf = &com->body->bitmap.surf;
+			const uint8_t *argb = (const uint8_t *)surf->argb;
+
+			for(size_t i = 0; i < (size_t)surf->stride * surf->h; i++)
+			{
+				sum += argb[i];
+			}
+		} break;
+		case D2TK_INSTR_CUSTOM:
+		{
+			const d2tk_body_custom_t *body = &com->body->custom;
+			const uint8_t *data = body->data;
+
+			for(size_t i = 0; i < body->size; i++)
+			{
+				sum += data[i];
+			}
+		} break;
+		case D2TK_INSTR_TEXT:
+		{
+			sum += strlen(com->body->text.text);
+		} break;
+	}
+
+	(void)sum;
+}
+
+static void
+_test_replay_corrupt()
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = NULL
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver_null, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	char *buf = NULL;
+	size_t len = 0;
+	FILE *f = open_memstream(&buf, &len);
+	assert(f);
+	d2tk_core_set_record(core, f);
+
+	static const char *datas [2] = { "first", "other" };
+	uint32_t surf [RECORD_WIDTH*RECORD_HEIGHT] = { 0 };
+	size_t first = 0; // length of full refresh frame, followed by a partial one
+
+	for(unsigned fr = 0; fr < 2; fr++)
+	{
+		d2tk_core_pre(core);
+
+		const ssize_t ref = d2tk_core_bbox_push(core, true,
+			&D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H));
+		assert(ref >= 0);
+		d2tk_core_bitmap(core, &D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H),
+			RECORD_WIDTH, RECORD_HEIGHT, RECORD_STRIDE, surf, 0,
+			D2TK_ALIGN_LEFT);
+		d2tk_core_custom(core, &D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H),
+			RECORD_SIZE, datas[fr], 0, _custom_record);
+		d2tk_core_text(core, &D2TK_RECT(CLIP_X, CLIP_Y, CLIP_W, CLIP_H),
+			5, "hello", D2TK_ALIGN_LEFT);
+		d2tk_core_bbox_pop(core, ref);
+
+		d2tk_core_post(core);
+
+		if(fr == 0)
+		{
+			fflush(f);
+			first = len;
+		}
+	}
+
+	d2tk_core_set_record(core, NULL);
+	d2tk_core_free(core);
+	fclose(f);
+	assert(buf && len);
+
+	// flip every byte, recording must either replay or be refused
+	uint8_t *mut = malloc(len);
+	assert(mut);
+
+	unsigned refused = 0;
+	ctx.check = _check_corrupt;
+
+	for(size_t i = 0; i <= len; i++)
+	{
+		memcpy(mut, buf, len);
+		if(i < len)
+		{
+			mut[i] ^= 0xff;
+		}
+
+		core = d2tk_core_new(&d2tk_mock_driver_null, &ctx);
+		assert(core);
+
+		FILE *fin = fmemopen(mut, len - (i == len), "rb"); // last is truncated
+		assert(fin);
+
+		int res;
+		while( (res = d2tk_core_replay(core, fin)) == 0)
+		{
+			// replay all frames
+		}
+		assert( (res == 1) || (res == -1) );
+		if(res == -1)
+		{
+			refused++;
+		}
+
+		fclose(fin);
+		d2tk_core_free(core);
+	}
+
+	assert(refused > 0);
+
+	// area of interest of partial frame out of bounds or inverted
+	static const struct {
+		size_t offset; // in frame header, after magic, version, w, h, bg, full
+		d2tk_coord_t val;
+	} aois [] = {
+		{ 24 + 0*sizeof(d2tk_coord_t), -1 }, // x0
+		{ 24 + 1*sizeof(d2tk_coord_t), -1 }, // y0
+		{ 24 + 0*sizeof(d2tk_coord_t), DIM_W }, // x0 > x1
+		{ 24 + 2*sizeof(d2tk_coord_t), DIM_W + 1 }, // x1
+		{ 24 + 3*sizeof(d2tk_coord_t), DIM_H*16 } // y1
+	};
+
+	for(unsigned i = 0; i < sizeof(aois) / sizeof(aois[0]); i++)
+	{
+		memcpy(mut, buf, len);
+		memcpy(&mut[first + aois[i].offset], &aois[i].val, sizeof(d2tk_coord_t));
+
+		core = d2tk_core_new(&d2tk_mock_driver_null, &ctx);
+		assert(core);
+
+		FILE *fin = fmemopen(mut, len, "rb");
+		assert(fin);
+
+		assert(d2tk_core_replay(core, fin) == 0);
+		assert(d2tk_core_replay(core, fin) == -1);
+
+		fclose(fin);
+		d2tk_core_free(core);
+	}
+
+	free(mut);
+	free(buf);
+}
+
+#undef RECORD_WIDTH
+#undef RECORD_HEIGHT
+#undef RECORD_STRIDE
+#undef RECORD_SIZE
+
+#define STATS_NUM 4
+#define STATS_W 64
+#define STATS_H 32
+
+static void
+_test_stats()
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = NULL
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver_lazy, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	for(unsigned f = 0; f < 3; f++)
+	{
+		d2tk_core_pre(core);
+
+		for(unsigned i = 0; i < STATS_NUM; i++)
+		{
+			const d2tk_coord_t x = i*STATS_W;
+			const ssize_t ref = d2tk_core_bbox_push(core, true,
+				&D2TK_RECT(x, 0, STATS_W, STATS_H));
+			assert(ref >= 0);
+
+			// change one item in last frame
+			const d2tk_coord_t w = (f == 2) && (i == 1) ? STATS_W/2 : STATS_W;
+			d2tk_core_rect(core, &D2TK_RECT(x, 0, w, STATS_H));
+
+			d2tk_core_bbox_pop(core, ref);
+		}
+
+		d2tk_core_post(core);
+
+		d2tk_stats_t frame;
+		d2tk_stats_t total;
+		d2tk_core_get_stats(core, &frame, &total);
+
+		assert(frame.frames == 1);
+		assert(total.frames == f + 1);
+		assert(frame.bytes > 0);
+
+		switch(f)
+		{
+			case 0: // full refresh
+			{
+				assert(frame.passes == 1);
+				assert(frame.area == DIM_W*DIM_H);
+				assert(frame.appeared == 0);
+				assert(frame.disappeared == 0);
+				assert(frame.sprite_misses > 0);
+			} break;
+			case 1: // unchanged
+			{
+				assert(frame.bboxes == STATS_NUM + 1); // plus root container
+				assert(frame.passes == 0);
+				assert(frame.fills == 0);
+				assert(frame.area == 0);
+				assert(frame.appeared == 0);
+				assert(frame.disappeared == 0);
+				assert(frame.diff_ns == 0);
+			} break;
+			case 2: // one item changed
+			{
+				assert(frame.bboxes == STATS_NUM + 1);
+				assert(frame.passes == 1);
+				assert(frame.fills == 2);
+				assert(frame.area == STATS_W*STATS_H);
+				assert(frame.appeared == 1);
+				assert(frame.disappeared == 1);
+				assert(frame.sprite_misses > 0);
+			} break;
+		}
+	}
+
+	d2tk_stats_t total;
+	d2tk_core_get_stats(core, NULL, &total);
+	assert(total.passes == 2);
+	assert(total.appeared == 1);
+	assert(total.disappeared == 1);
+
+	d2tk_core_free(core);
+}
+
+static void
+_test_stats_widget()
+{
+	d2tk_mock_ctx_t ctx = {
+		.check = NULL
+	};
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_mock_driver_lazy, &ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+
+	uint64_t bytes = 0;
+
+	for(unsigned f = 0; f < 3; f++)
+	{
+		d2tk_core_pre(core);
+
+		D2TK_CORE_WIDGET(core, 0x1234, widget)
+		{
+			for(unsigned i = 0; i < STATS_NUM; i++)
+			{
+				const d2tk_coord_t x = i*STATS_W;
+				const ssize_t ref = d2tk_core_bbox_push(core, true,
+					&D2TK_RECT(x, 0, STATS_W, STATS_H));
+				assert(ref >= 0);
+
+				d2tk_core_rect(core, &D2TK_RECT(x, 0, STATS_W, STATS_H));
+
+				d2tk_core_bbox_pop(core, ref);
+			}
+		}
+
+		d2tk_core_post(core);
+
+		d2tk_stats_t frame;
+		d2tk_core_get_stats(core, &frame, NULL);
+
+		if(f == 1) // full refresh has flushed memcache
+		{
+			assert(frame.memcache_hits == 0);
+			assert(frame.bboxes == STATS_NUM + 1); // plus root container
+		}
+		else if(f == 2) // copied from memcache
+		{
+			assert(frame.memcache_hits == 1);
+			assert(frame.bboxes == STATS_NUM + 1);
+			assert(frame.bytes == bytes);
+		}
+
+		bytes = frame.bytes;
+	}
+
+	d2tk_core_free(core);
+}
+
+#undef STATS_NUM
+#undef STATS_W
+#undef STATS_H
+
 int
 main(int argc __attribute__((unused)), char **argv __attribute__((unused)))
 {
 	_test_hash();
 	_test_hash_foreach();
+	_test_hasher();
+	_test_hash_stream();
+	_test_hash_lit();
 	_test_rect_shrink();
 	_test_point();
 	_test_dimensions();
@@ -1444,9 +2551,21 @@ main(int argc __attribute__((unused)), char **argv __attribute__((unused)))
 	_test_image();
 	_test_bitmap();
 	_test_custom();
+	_test_custom_rev();
 	_test_stroke_width();
 
 	_test_triple();
+	_test_dirty_rect();
+	_test_sprites();
+	_test_layouts();
+	_test_diff();
+
+	_test_trace();
+	_test_record();
+	_test_record_expire();
+	_test_replay_corrupt();
+	_test_stats();
+	_test_stats_widget();
 
 	return EXIT_SUCCESS;
 }
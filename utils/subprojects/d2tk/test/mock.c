@@ -45,9 +45,14 @@ _d2tk_mock_post(void *data, d2tk_core_t *core, d2tk_coord_t w, d2tk_coord_t h,
 	assert(h == DIM_H);
 	assert(pass == 0);
 
-	d2tk_rect_t rect;
-	assert(d2tk_core_get_pixels(core, &rect));
-	assert( (rect.w != 0) && (rect.h != 0) );
+	unsigned nrects;
+	const d2tk_rect_t *rects = d2tk_core_get_dirty_rects(core, &nrects);
+	assert(rects);
+	assert(nrects > 0);
+	for(unsigned i = 0; i < nrects; i++)
+	{
+		assert( (rects[i].w != 0) && (rects[i].h != 0) );
+	}
 
 	return false; // do NOT enter 3rd pass
 }
@@ -210,6 +215,73 @@ _d2tk_mock_process_lazy(void *data, d2tk_core_t *core, const d2tk_com_t *com,
 	assert(num > 0);
 }
 
+static inline void
+_d2tk_mock_pre_null(void *data, d2tk_core_t *core,
+	d2tk_coord_t w __attribute__((unused)),
+	d2tk_coord_t h __attribute__((unused)),
+	unsigned pass __attribute__((unused)))
+{
+	d2tk_mock_ctx_t *ctx = data;
+	assert(ctx);
+
+	assert(core);
+}
+
+static inline bool
+_d2tk_mock_post_null(void *data, d2tk_core_t *core,
+	d2tk_coord_t w __attribute__((unused)),
+	d2tk_coord_t h __attribute__((unused)),
+	unsigned pass)
+{
+	d2tk_mock_ctx_t *ctx = data;
+	assert(ctx);
+
+	assert(core);
+
+	return pass == 0; // do enter 2nd pass, like the real backends
+}
+
+static inline void
+_d2tk_mock_process_null(void *data, d2tk_core_t *core, const d2tk_com_t *com,
+	d2tk_coord_t xo __attribute__((unused)), d2tk_coord_t yo __attribute__((unused)),
+	const d2tk_clip_t *clip __attribute__((unused)), unsigned pass)
+{
+	d2tk_mock_ctx_t *ctx = data;
+	assert(ctx);
+
+	assert(core);
+	assert(com);
+	assert(com->instr == D2TK_INSTR_BBOX);
+
+	const d2tk_body_bbox_t *body = &com->body->bbox;
+
+	if(body->cached && (pass == 0) )
+	{
+		uintptr_t *sprite = d2tk_core_get_sprite(core, body->hash, 1);
+		assert(sprite);
+
+		if(*sprite == 0)
+		{
+			uint32_t *dummy = calloc(1, sizeof(uint32_t));
+			assert(dummy);
+			*dummy = 1234;
+
+			*sprite = (uintptr_t)dummy;
+			d2tk_core_set_sprite_size(core, sprite,
+				(size_t)body->clip.w * body->clip.h * sizeof(uint32_t));
+		}
+	}
+
+	// walk the stream like a renderer would, but do not draw anything
+	D2TK_COM_FOREACH_CONST(com, bbox)
+	{
+		if(ctx->check)
+		{
+			ctx->check(bbox, &body->clip);
+		}
+	}
+}
+
 const d2tk_core_driver_t d2tk_mock_driver = {
 	.new = NULL,
 	.free = NULL,
@@ -236,3 +308,13 @@ const d2tk_core_driver_t d2tk_mock_driver_lazy = {
 	.post = _d2tk_mock_post,
 	.sprite_free = _d2tk_mock_sprite_free
 };
+
+// walks any command stream in two passes without drawing, e.g. to benchmark
+const d2tk_core_driver_t d2tk_mock_driver_null = {
+	.new = NULL,
+	.free = NULL,
+	.pre = _d2tk_mock_pre_null,
+	.process = _d2tk_mock_process_null,
+	.post = _d2tk_mock_post_null,
+	.sprite_free = _d2tk_mock_sprite_free
+};
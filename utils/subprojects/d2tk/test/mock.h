@@ -41,5 +41,6 @@ struct _d2tk_mock_ctx_t {
 extern const d2tk_core_driver_t d2tk_mock_driver;
 extern const d2tk_core_driver_t d2tk_mock_driver_triple;
 extern const d2tk_core_driver_t d2tk_mock_driver_lazy;
+extern const d2tk_core_driver_t d2tk_mock_driver_null;
 
 #endif // _D2TK_MOCK_H
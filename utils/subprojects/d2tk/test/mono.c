@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2018-2019 Hanspeter Portner (dev@open-music-kontrollers.ch)
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the Artistic License 2.0 as published by
+ * The Perl Foundation.
+ *
+ * This source is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * Artistic License 2.0 for more details.
+ *
+ * You should have received a copy of the Artistic License 2.0
+ * along the source as a COPYING file. If not, obtain it from
+ * http://www.perlfoundation.org/artistic_license_2_0.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include <d2tk/core.h>
+#include <d2tk/backend.h>
+#include <d2tk/backend_mono.h>
+#include "src/core_internal.h"
+
+#define DIM_W 100 // not a multiple of 32 on purpose
+#define DIM_H 40
+
+#define BLACK 0x000000ff
+#define WHITE 0xffffffff
+
+typedef void (*_draw_t)(d2tk_core_t *core);
+
+static uint32_t buf [DIM_H * 8];
+
+static d2tk_mono_surf_t
+_surf(uint8_t bpp)
+{
+	const d2tk_mono_surf_t surf = {
+		.buf = (uint8_t *)buf,
+		.w = DIM_W,
+		.h = DIM_H,
+		.stride = ( (DIM_W*bpp + 31) >> 5) << 2,
+		.bpp = bpp
+	};
+
+	memset(buf, 0x0, sizeof(buf));
+
+	return surf;
+}
+
+// one full refresh on white background
+static void
+_render(d2tk_mono_surf_t *surf, _draw_t draw)
+{
+	void *ctx = d2tk_core_driver.new("./", surf);
+	assert(ctx);
+
+	d2tk_core_t *core = d2tk_core_new(&d2tk_core_driver, ctx);
+	assert(core);
+
+	d2tk_core_set_dimensions(core, DIM_W, DIM_H);
+	d2tk_core_set_bg_color(core, WHITE);
+
+	d2tk_core_pre(core);
+	draw(core);
+	d2tk_core_post(core);
+
+	d2tk_core_free(core);
+	d2tk_core_driver.free(ctx);
+}
+
+static unsigned
+_count(const d2tk_mono_surf_t *surf, uint8_t level, d2tk_coord_t x0,
+	d2tk_coord_t y0, d2tk_coord_t x1, d2tk_coord_t y1)
+{
+	unsigned n = 0;
+
+	for(d2tk_coord_t y = y0; y < y1; y++)
+	{
+		for(d2tk_coord_t x = x0; x < x1; x++)
+		{
+			n += d2tk_mono_surf_get(surf, x, y) == level;
+		}
+	}
+
+	return n;
+}
+
+static void
+_draw_rect(d2tk_core_t *core)
+{
+	const ssize_t ref = d2tk_core_bbox_push(core, false,
+		&D2TK_RECT(0, 0, DIM_W, DIM_H));
+
+	d2tk_core_begin_path(core);
+	d2tk_core_rect(core, &D2TK_RECT(20, 10, 50, 20));
+	d2tk_core_color(core, BLACK);
+	d2tk_core_fill(core);
+
+	d2tk_core_bbox_pop(core, ref);
+}
+
+static void
+_test_rect()
+{
+	d2tk_mono_surf_t surf = _surf(1);
+
+	_render(&surf, _draw_rect);
+
+	// spans crossing word boundaries
+	assert(_count(&surf, 0, 20, 10, 70, 30) == 50*20);
+	assert(_count(&surf, 0, 0, 0, DIM_W, DIM_H) == 50*20);
+	assert(d2tk_mono_surf_get(&surf, 19, 10) == 1);
+	assert(d2tk_mono_surf_get(&surf, 70, 10) == 1);
+	assert(d2tk_mono_surf_get(&surf, 20, 9) == 1);
+	assert(d2tk_mono_surf_get(&surf, 20, 30) == 1);
+}
+
+static void
+_draw_rounded_rect(d2tk_core_t *core)
+{
+	const ssize_t ref = d2tk_core_bbox_push(core, false,
+		&D2TK_RECT(0, 0, DIM_W, DIM_H));
+
+	d2tk_core_begin_path(core);
+	d2tk_core_rounded_rect(core, &D2TK_RECT(10, 5, 40, 30), 10);
+	d2tk_core_color(core, BLACK);
+	d2tk_core_fill(core);
+
+	d2tk_core_bbox_pop(core, ref);
+}
+
+static void
+_test_rounded_rect()
+{
+	d2tk_mono_surf_t surf = _surf(1);
+
+	_render(&surf, _draw_rounded_rect);
+
+	// corners are cut, edges are not
+	assert(d2tk_mono_surf_get(&surf, 10, 5) == 1);
+	assert(d2tk_mono_surf_get(&surf, 49, 34) == 1);
+	assert(d2tk_mono_surf_get(&surf, 30, 5) == 0);
+	assert(d2tk_mono_surf_get(&surf, 10, 20) == 0);
+	assert(d2tk_mono_surf_get(&surf, 30, 20) == 0);
+
+	const unsigned n = _count(&surf, 0, 0, 0, DIM_W, DIM_H);
+	assert(n < 40*30);
+	assert(n > 40*30 - 4*10*10);
+}
+
+static void
+_draw_stroke(d2tk_core_t *core)
+{
+	const ssize_t ref = d2tk_core_bbox_push(core, false,
+		&D2TK_RECT(0, 0, DIM_W, DIM_H));
+
+	d2tk_core_begin_path(core);
+	d2tk_core_move_to(core, 10, 10);
+	d2tk_core_line_to(core, 90, 10);
+	d2tk_core_color(core, BLACK);
+	d2tk_core_stroke_width(core, 4);
+	d2tk_core_stroke(core);
+
+	d2tk_core_begin_path(core);
+	d2tk_core_arc(core, 50, 25, 10, 0, 360, true);
+	d2tk_core_stroke_width(core, 1);
+	d2tk_core_stroke(core);
+
+	d2tk_core_bbox_pop(core, ref);
+}
+
+static void
+_test_stroke()
+{
+	d2tk_mono_surf_t surf = _surf(1);
+
+	_render(&surf, _draw_stroke);
+
+	// thick line
+	assert(_count(&surf, 0, 10, 8, 90, 12) == 80*4);
+	assert(_count(&surf, 0, 0, 0, DIM_W, 7) == 0);
+	assert(_count(&surf, 0, 0, 12, DIM_W, 14) == 0);
+
+	// circle outline without holes
+	for(d2tk_coord_t y = 17; y < 33; y++)
+	{
+		assert(_count(&surf, 0, 0, y, DIM_W, y + 1) >= 2);
+	}
+	assert(d2tk_mono_surf_get(&surf, 50, 25) == 1);
+	assert(d2tk_mono_surf_get(&surf, 50, 35) == 1);
+}
+
+static void
+_draw_scissor(d2tk_core_t *core)
+{
+	const ssize_t ref = d2tk_core_bbox_push(core, false,
+		&D2TK_RECT(0, 0, DIM_W, DIM_H));
+
+	d2tk_core_save(core);
+	d2tk_core_scissor(core, &D2TK_RECT(10, 10, 10, 10));
+	d2tk_core_begin_path(core);
+	d2tk_core_rect(core, &D2TK_RECT(0, 0, DIM_W, DIM_H));
+	d2tk_core_color(core, BLACK);
+	d2tk_core_fill(core);
+	d2tk_core_restore(core);
+
+	// scissor has been restored, color defaults to black
+	d2tk_core_begin_path(core);
+	d2tk_core_rect(core, &D2TK_RECT(50, 10, 10, 10));
+	d2tk_core_fill(core);
+
+	d2tk_core_bbox_pop(core, ref);
+}
+
+static void
+_test_scissor()
+{
+	d2tk_mono_surf_t surf = _surf(1);
+
+	_render(&surf, _draw_scissor);
+
+	assert(_count(&surf, 0, 10, 10, 20, 20) == 10*10);
+	assert(_count(&surf, 0, 50, 10, 60, 20) == 10*10);
+	assert(_count(&surf, 0, 0, 0, DIM_W, DIM_H) == 2*10*10);
+}
+
+static void
+_draw_text(d2tk_core_t *core)
+{
+	const ssize_t ref = d2tk_core_bbox_push(core, true,
+		&D2TK_RECT(10, 10, 80, 20));
+
+	d2tk_core_font_face(core, strlen("FiraSans:bold"), "FiraSans:bold");
+	d2tk_core_font_size(core, 16);
+	d2tk_core_color(core, BLACK);
+	d2tk_core_text(core, &D2TK_RECT(10, 10, 80, 20), strlen("Hi\xc3\xa4"), "Hi\xc3\xa4",
+		D2TK_ALIGN_CENTERED);
+
+	d2tk_core_bbox_pop(core, ref);
+}
+
+static void
+_test_text()
+{
+	d2tk_mono_surf_t surf = _surf(1);
+
+	_render(&surf, _draw_text);
+
+	// all ink is inside its box, around its center
+	const unsigned n = _count(&surf, 0, 0, 0, DIM_W, DIM_H);
+	assert(n > 20);
+	assert(_count(&surf, 0, 30, 10, 70, 30) == n);
+	assert(_count(&surf, 0, 10, 10, 50, 30) > 0);
+	assert(_count(&surf, 0, 50, 10, 90, 30) > 0);
+}
+
+// through sprite, to also cover blitting of 2 bpp
+static void
+_draw_levels(d2tk_core_t *core)
+{
+	const ssize_t ref = d2tk_core_bbox_push(core, true,
+		&D2TK_RECT(0, 0, DIM_W, DIM_H));
+
+	d2tk_core_begin_path(core);
+	d2tk_core_rect(core, &D2TK_RECT(0, 0, 32, 8));
+	d2tk_core_color(core, 0x555555ff);
+	d2tk_core_fill(core);
+
+	d2tk_core_begin_path(core);
+	d2tk_core_rect(core, &D2TK_RECT(32, 0, 32, 8));
+	d2tk_core_color(core, 0x808080ff);
+	d2tk_core_fill(core);
+
+	d2tk_core_begin_path(core);
+	d2tk_core_rect(core, &D2TK_RECT(0, 8, 32, 8));
+	d2tk_core_color(core, 0x0000007f); // half transparent
+	d2tk_core_fill(core);
+
+	d2tk_core_bbox_pop(core, ref);
+}
+
+static void
+_test_levels()
+{
+	{
+		d2tk_mono_surf_t surf = _surf(2);
+
+		_render(&surf, _draw_levels);
+
+		assert(_count(&surf, 1, 0, 0, 32, 8) == 32*8);
+		assert(_count(&surf, 1, 32, 0, 64, 8) + _count(&surf, 2, 32, 0, 64, 8)
+			== 32*8);
+		assert(_count(&surf, 3, 64, 0, DIM_W, 8) == (DIM_W - 64)*8);
+	}
+
+	{
+		d2tk_mono_surf_t surf = _surf(1);
+
+		_render(&surf, _draw_levels);
+
+		// ordered dither of grey, screen door for transparency
+		assert(_count(&surf, 0, 0, 0, 32, 8) == 32*8*11/16);
+		assert(_count(&surf, 0, 32, 0, 64, 8) == 32*8/2);
+		assert(_count(&surf, 0, 0, 8, 32, 16) == 32*8/2);
+	}
+}
+
+#define BMP_W 4
+#define BMP_H 4
+
+static const uint32_t bmp [BMP_W * BMP_H] = {
+	0xff000000, 0xff000000, 0x00000000, 0x00000000,
+	0xff000000, 0xff000000, 0x00000000, 0x00000000,
+	0xffffffff, 0xffffffff, 0x00000000, 0x00000000,
+	0xffffffff, 0xffffffff, 0x00000000, 0x00000000
+};
+
+static void
+_custom(void *ctx, uint32_t size, const void *data)
+{
+	d2tk_mono_surf_t *surf = ctx;
+	const uint8_t *level = data;
+
+	assert(size == sizeof(uint8_t));
+	assert(surf->bpp == 1);
+
+	for(uint32_t y = 0; y < surf->h; y++)
+	{
+		memset(&surf->buf[y*surf->stride], *level ? 0xff : 0x0, surf->stride);
+	}
+}
+
+static void
+_draw_sprites(d2tk_core_t *core)
+{
+	static const uint8_t level = 0;
+
+	{
+		const ssize_t ref = d2tk_core_bbox_push(core, false,
+			&D2TK_RECT(0, 0, DIM_W, DIM_H));
+
+		d2tk_core_begin_path(core);
+		d2tk_core_rect(core, &D2TK_RECT(0, 0, DIM_W, 20));
+		d2tk_core_color(core, BLACK);
+		d2tk_core_fill(core);
+
+		d2tk_core_bbox_pop(core, ref);
+	}
+
+	// cached, only covered pixels are painted over the black bar
+	{
+		const ssize_t ref = d2tk_core_bbox_push(core, true,
+			&D2TK_RECT(3, 2, 40, 30));
+
+		d2tk_core_begin_path(core);
+		d2tk_core_rect(core, &D2TK_RECT(3, 2, 10, 10));
+		d2tk_core_color(core, WHITE);
+		d2tk_core_fill(core);
+
+		d2tk_core_bitmap(core, &D2TK_RECT(23, 22, BMP_W, BMP_H), BMP_W, BMP_H,
+			BMP_W*sizeof(uint32_t), bmp, 1, D2TK_ALIGN_LEFT | D2TK_ALIGN_TOP);
+
+		d2tk_core_bbox_pop(core, ref);
+	}
+
+	{
+		const ssize_t ref = d2tk_core_bbox_push(core, false,
+			&D2TK_RECT(60, 24, 8, 8));
+
+		d2tk_core_custom(core, &D2TK_RECT(60, 24, 8, 8), sizeof(level), &level,
+			0, _custom);
+
+		d2tk_core_bbox_pop(core, ref);
+	}
+}
+
+static void
+_test_sprites()
+{
+	d2tk_mono_surf_t surf = _surf(1);
+
+	_render(&surf, _draw_sprites);
+
+	assert(_count(&surf, 1, 3, 2, 13, 12) == 10*10);
+	assert(_count(&surf, 0, 13, 2, 43, 12) == 30*10);
+	assert(_count(&surf, 0, 3, 12, 43, 20) == 40*8);
+
+	// opaque parts of bitmap
+	assert(_count(&surf, 0, 23, 22, 25, 24) == 2*2);
+	assert(_count(&surf, 1, 23, 24, 25, 26) == 2*2);
+	assert(_count(&surf, 1, 25, 22, 27, 26) == 2*4);
+	assert(_count(&surf, 0, 0, 20, DIM_W, DIM_H) == 2*2 + 8*8);
+
+	// custom draw
+	assert(_count(&surf, 0, 60, 24, 68, 32) == 8*8);
+}
+
+#undef BMP_W
+#undef BMP_H
+
+int
+main(int argc __attribute__((unused)), char **argv __attribute__((unused)))
+{
+	_test_rect();
+	_test_rounded_rect();
+	_test_stroke();
+	_test_scissor();
+	_test_text();
+	_test_levels();
+	_test_sprites();
+
+	return EXIT_SUCCESS;
+}